@@ -0,0 +1,241 @@
+/**
+ * Nav Mesh 512 Benchmark.
+ *
+ * Plans corner to corner across a 512x512 yard with 40 random rectangular
+ * obstacles, once on the navigation mesh and once on the 8-connected grid
+ * (a SparsePlanner walled in around the yard), both on the same engine.
+ * Then walls off a row of 100 cells through the middle of the mesh path and
+ * replans both.  Prints the mesh size, the expansions, path costs and
+ * timings.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "nav_mesh_planner.h"
+#include "sparse_graph.h"
+#include "sparse_planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const int  side of the yard
+ */
+static const int SIZE = 512;
+
+/**
+ * @var  static const int  number of obstacles
+ */
+static const int OBSTACLES = 40;
+
+/**
+ * @var  static const int  longest side of an obstacle
+ */
+static const int OBSTACLE = 60;
+
+/**
+ * @var  static const int  length of the wall across the path
+ */
+static const int WALL = 100;
+
+/**
+ * Gets the seconds since a clock reading.
+ *
+ * @param   clock_t   start
+ * @return  double
+ */
+double seconds(clock_t start)
+{
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Gets the cost of the last mesh path.
+ *
+ * @param   NavMeshPlanner*   planner
+ * @return  double
+ */
+double cost(NavMeshPlanner* planner)
+{
+	const list<NavMesh::Vertex>& path = planner->path();
+
+	double sum = 0.0;
+	list<NavMesh::Vertex>::const_iterator it = path.begin();
+
+	for (NavMesh::Vertex u = *it++; it != path.end(); u = *it++)
+	{
+		NavMesh::Edges edges;
+		planner->mesh()->succ(u, edges);
+
+		double best = Math::INF;
+
+		for (unsigned int i = 0; i < edges.size(); i++)
+		{
+			if (edges[i].first == *it && edges[i].second < best)
+			{
+				best = edges[i].second;
+			}
+		}
+
+		sum += best;
+	}
+
+	return sum;
+}
+
+/**
+ * Gets the cost of the last grid path.
+ *
+ * @param   SparsePlanner*   planner
+ * @return  double
+ */
+double cost(SparsePlanner* planner)
+{
+	SparseGraph graph(planner->map());
+	list<SparseMap::Coord> path = planner->path();
+
+	double sum = 0.0;
+	list<SparseMap::Coord>::iterator it = path.begin();
+
+	for (SparseMap::Coord u = *it++; it != path.end(); u = *it++)
+	{
+		SparseGraph::Edges edges;
+		graph.succ(u, edges);
+
+		double best = Math::INF;
+
+		for (unsigned int i = 0; i < edges.size(); i++)
+		{
+			if (edges[i].first == *it && edges[i].second < best)
+			{
+				best = edges[i].second;
+			}
+		}
+
+		sum += best;
+	}
+
+	return sum;
+}
+
+int main(int argc, char* argv[])
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+	srand(1);
+
+	Map map(SIZE, SIZE);
+
+	// Obstacles keep clear of the corners
+	for (int o = 0; o < OBSTACLES; o++)
+	{
+		int w = 4 + rand() % (OBSTACLE - 4);
+		int h = 4 + rand() % (OBSTACLE - 4);
+		int x = 8 + rand() % (SIZE - 16 - w);
+		int y = 8 + rand() % (SIZE - 16 - h);
+
+		for (int i = y; i < y + h; i++)
+		{
+			for (int j = x; j < x + w; j++)
+			{
+				map(i, j)->cost = Map::Cell::COST_UNWALKABLE;
+			}
+		}
+	}
+
+	clock_t t = clock();
+
+	NavMeshPlanner mesh(&map, map(0, 0), map(SIZE - 1, SIZE - 1));
+
+	printf("mesh  %.3fs  %u rectangles  %u portals\n", seconds(t), mesh.mesh()->rects(), mesh.mesh()->portals());
+
+	SparsePlanner grid(SparseMap::coord(0, 0), SparseMap::coord(SIZE - 1, SIZE - 1));
+
+	for (int i = -1; i <= SIZE; i++)
+	{
+		grid.update(SparseMap::coord(i, -1), Map::Cell::COST_UNWALKABLE);
+		grid.update(SparseMap::coord(i, SIZE), Map::Cell::COST_UNWALKABLE);
+		grid.update(SparseMap::coord(-1, i), Map::Cell::COST_UNWALKABLE);
+		grid.update(SparseMap::coord(SIZE, i), Map::Cell::COST_UNWALKABLE);
+	}
+
+	for (int i = 0; i < SIZE; i++)
+	{
+		for (int j = 0; j < SIZE; j++)
+		{
+			if (map(i, j)->cost != 1.0)
+			{
+				grid.update(SparseMap::coord(j, i), map(i, j)->cost);
+			}
+		}
+	}
+
+	t = clock();
+	bool ok = mesh.replan();
+
+	printf("mesh  initial  %.3fs  %6u expanded  cost %.1f\n", seconds(t), mesh.expanded(), ok ? cost(&mesh) : Math::INF);
+
+	t = clock();
+	bool found = grid.replan();
+
+	printf("grid  initial  %.3fs  %6u expanded  cost %.1f\n", seconds(t), grid.expanded(), found ? cost(&grid) : Math::INF);
+
+	ok = found && ok;
+
+	if ( ! ok)
+		return 1;
+
+	// Wall off the path with a row through its middle vertex
+	list<NavMesh::Vertex>::const_iterator it = mesh.path().begin();
+
+	for (unsigned int i = 0; i < mesh.path().size() / 2; i++)
+	{
+		it++;
+	}
+
+	pair<double,double> middle = NavMesh::point(*it);
+
+	vector<Map::Cell*> cells;
+	vector<double> costs;
+
+	for (int i = 0; i < WALL; i++)
+	{
+		int x = (int) middle.first - WALL / 2 + i;
+		int y = (int) middle.second;
+
+		if (map.has(y, x))
+		{
+			cells.push_back(map(y, x));
+			costs.push_back(Map::Cell::COST_UNWALKABLE);
+		}
+	}
+
+	unsigned int before = mesh.expanded();
+	t = clock();
+
+	mesh.update(cells, costs);
+	ok = mesh.replan();
+
+	printf("mesh  replan   %.3fs  %6u expanded  cost %.1f\n", seconds(t), mesh.expanded() - before, ok ? cost(&mesh) : Math::INF);
+
+	before = grid.expanded();
+	t = clock();
+
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		grid.update(SparseMap::coord(cells[i]->x(), cells[i]->y()), costs[i]);
+	}
+
+	found = grid.replan();
+
+	printf("grid  replan   %.3fs  %6u expanded  cost %.1f\n", seconds(t), grid.expanded() - before, found ? cost(&grid) : Math::INF);
+
+	ok = found && ok;
+
+	return ok ? 0 : 1;
+}
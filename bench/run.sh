@@ -0,0 +1,21 @@
+#!/bin/sh
+# Builds and runs the benchmarks (they don't need FLTK).
+# Set CXX to use another compiler.
+
+cd "$(dirname "$0")/../src" || exit 1
+
+CXX=${CXX:-g++}
+FLAGS="-std=gnu++98 -O2 -I."
+OUT=${TMPDIR:-/tmp}
+
+run()
+{
+	name=$1
+	shift
+
+	$CXX $FLAGS ../bench/$name.cpp "$@" -o $OUT/$name || exit 1
+	$OUT/$name || exit 1
+}
+
+run voxel_512 voxel_map.cpp voxel_graph.cpp voxel_planner.cpp key.cpp map.cpp math.cpp
+run nav_mesh_512 nav_mesh.cpp nav_mesh_planner.cpp sparse_map.cpp sparse_graph.cpp sparse_planner.cpp key.cpp map.cpp math.cpp
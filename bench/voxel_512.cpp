@@ -0,0 +1,197 @@
+/**
+ * Voxel 512 Benchmark.
+ *
+ * Plans through a 512^3 volume with 3000 random 12^3 blocks (about 4% of
+ * the voxels), then moves along the path and drops a 5x5 wall across it a
+ * few times, replanning after each.  Prints the expansions and timings.
+ *
+ * The run across the volume (511 voxels along x, 32 along y and z) is
+ * planned 6-, 18- and 26-connected.  The corner to corner diagonal is
+ * planned 26-connected only: with 6 or 18 neighbors every voxel of the
+ * box between the corners lies on a path of the same cost, and D* Lite
+ * breaks key ties toward the goal, so it would expand most of the volume.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "voxel_planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const int  side of the volume
+ */
+static const int SIZE = 512;
+
+/**
+ * @var  static const int  number of blocks
+ */
+static const int BLOCKS = 3000;
+
+/**
+ * @var  static const int  side of a block
+ */
+static const int BLOCK = 12;
+
+/**
+ * @var  static const int  number of incremental rounds
+ */
+static const int ROUNDS = 5;
+
+/**
+ * Gets the seconds since a clock reading.
+ *
+ * @param   clock_t   start
+ * @return  double
+ */
+double seconds(clock_t start)
+{
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Runs the benchmark for one connectivity.
+ *
+ * @param   VoxelMap*         map
+ * @param   const char*       name of the run
+ * @param   VoxelMap::Voxel   start
+ * @param   VoxelMap::Voxel   goal
+ * @param   unsigned int      connectivity
+ * @return  bool              all plans found
+ */
+bool run(VoxelMap* map, const char* name, const VoxelMap::Voxel& start, const VoxelMap::Voxel& goal, unsigned int connectivity)
+{
+	VoxelPlanner planner(map, start, goal, connectivity);
+
+	clock_t t = clock();
+	bool ok = planner.replan();
+
+	printf("%-8s %2u-connected  initial  %.3fs  %8u expanded  %4u voxels\n", name, connectivity, seconds(t), planner.expanded(), (unsigned int) planner.path().size());
+
+	if ( ! ok)
+		return false;
+
+	double total = 0.0;
+	unsigned int expanded = 0;
+	unsigned int rounds = 0;
+
+	for (int r = 0; r < ROUNDS; r++)
+	{
+		list<VoxelMap::Voxel> path = planner.path();
+
+		if (path.size() < 80)
+			break;
+
+		// Move 50 voxels along, then wall off the path 20 voxels ahead
+		list<VoxelMap::Voxel>::iterator it = path.begin();
+
+		for (int i = 0; i < 50; i++)
+		{
+			it++;
+		}
+
+		planner.start(*it);
+
+		for (int i = 0; i < 20; i++)
+		{
+			it++;
+		}
+
+		vector<VoxelMap::Voxel> voxels;
+		vector<double> costs;
+
+		for (int dz = -2; dz <= 2; dz++)
+		{
+			for (int dy = -2; dy <= 2; dy++)
+			{
+				VoxelMap::Voxel v = VoxelMap::voxel(it->x, it->y + dy, it->z + dz);
+
+				if (map->has(v))
+				{
+					voxels.push_back(v);
+					costs.push_back(Map::Cell::COST_UNWALKABLE);
+				}
+			}
+		}
+
+		unsigned int before = planner.expanded();
+		t = clock();
+
+		planner.update(voxels, costs);
+		ok = planner.replan();
+
+		total += seconds(t);
+		expanded += planner.expanded() - before;
+		rounds++;
+
+		if ( ! ok)
+			return false;
+	}
+
+	if (rounds > 0)
+	{
+		printf("%-8s %2u-connected  replan   %.3fs  %8u expanded  (mean of %u)\n", name, connectivity, total / rounds, expanded / rounds, rounds);
+	}
+
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+	srand(1);
+
+	clock_t t = clock();
+
+	VoxelMap map(SIZE, SIZE, SIZE);
+
+	for (int b = 0; b < BLOCKS; b++)
+	{
+		int x = rand() % (SIZE - BLOCK);
+		int y = rand() % (SIZE - BLOCK);
+		int z = rand() % (SIZE - BLOCK);
+
+		for (int i = 0; i < BLOCK; i++)
+		{
+			for (int j = 0; j < BLOCK; j++)
+			{
+				for (int k = 0; k < BLOCK; k++)
+				{
+					map.set(VoxelMap::voxel(x + i, y + j, z + k), Map::Cell::COST_UNWALKABLE);
+				}
+			}
+		}
+	}
+
+	VoxelMap::Voxel across[2] = {VoxelMap::voxel(0, SIZE / 2, SIZE / 2), VoxelMap::voxel(SIZE - 1, SIZE / 2 + 32, SIZE / 2 + 32)};
+	VoxelMap::Voxel diagonal[2] = {VoxelMap::voxel(0, 0, 0), VoxelMap::voxel(SIZE - 1, SIZE - 1, SIZE - 1)};
+
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		map.set(across[i], 1.0);
+		map.set(diagonal[i], 1.0);
+	}
+
+	unsigned int chunks = (SIZE / 16) * (SIZE / 16) * (SIZE / 16);
+
+	printf("map  %.2fs  %u of %u chunks allocated\n", seconds(t), map.chunks(), chunks);
+
+	unsigned int connectivities[3] = {6, 18, 26};
+	bool ok = true;
+
+	for (unsigned int c = 0; c < 3; c++)
+	{
+		ok = run(&map, "across", across[0], across[1], connectivities[c]) && ok;
+	}
+
+	ok = run(&map, "diagonal", diagonal[0], diagonal[1], 26) && ok;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,514 @@
+/**
+ * Any Angle Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "any_angle_planner.h"
+
+/**
+ * @var  static const unsigned int  max steps before assuming no solution possible
+ */
+const unsigned int AnyAnglePlanner::MAX_STEPS = 1000000;
+
+/**
+ * @var  static const unsigned int  size of a tile (in cells)
+ */
+const unsigned int AnyAnglePlanner::TILE = 16;
+
+/**
+ * Constructor.
+ *
+ * @param  Map*         map
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+AnyAnglePlanner::AnyAnglePlanner(Map* map, Map::Cell* start, Map::Cell* goal)
+	: _sight(map)
+{
+	_map = map;
+	_start = start;
+	_goal = goal;
+	_last = start;
+
+	_km = 0;
+	_expanded = 0;
+
+	_buckets.resize(((map->rows() + TILE - 1) / TILE) * ((map->cols() + TILE - 1) / TILE));
+
+	_state(_goal)->rhs = 0.0;
+	_update(_goal);
+}
+
+/**
+ * Gets the cost of a cell as known by the planner.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double AnyAnglePlanner::cost(Map::Cell* u)
+{
+	return _sight.cell(u->x(), u->y());
+}
+
+/**
+ * Gets the number of cells expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int AnyAnglePlanner::expanded()
+{
+	return _expanded;
+}
+
+/**
+ * Gets the goal.
+ *
+ * @return  Map::Cell*
+ */
+Map::Cell* AnyAnglePlanner::goal()
+{
+	return _goal;
+}
+
+/**
+ * Gets the cost of a straight line between two cell centers.
+ *
+ * @param   Map::Cell*   a
+ * @param   Map::Cell*   b
+ * @return  double       cost (Math::INF if blocked)
+ */
+double AnyAnglePlanner::line(Map::Cell* a, Map::Cell* b)
+{
+	return _sight.line(2 * a->x() + 1, 2 * a->y() + 1, 2 * b->x() + 1, 2 * b->y() + 1);
+}
+
+/**
+ * Gets the path from the last replan, the corners of the legs.
+ *
+ * @return  list<Map::Cell*>&
+ */
+const list<Map::Cell*>& AnyAnglePlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool AnyAnglePlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _compute())
+		return false;
+
+	Map::Cell* current = _start;
+	_path.push_back(current);
+
+	// Follow the parents, each leg a clear line
+	while (current != _goal)
+	{
+		SH::iterator it = _states.find(current);
+
+		if (it == _states.end() || it->second.parent == NULL || it->second.g == Math::INF || _path.size() > _states.size())
+		{
+			_path.clear();
+			return false;
+		}
+
+		current = it->second.parent;
+		_path.push_back(current);
+	}
+
+	return true;
+}
+
+/**
+ * Gets/Sets start.
+ *
+ * @param   Map::Cell* [optional]   new start
+ * @return  Map::Cell*              start
+ */
+Map::Cell* AnyAnglePlanner::start(Map::Cell* u)
+{
+	if (u == NULL)
+		return _start;
+
+	_start = u;
+
+	return _start;
+}
+
+/**
+ * Update map.
+ *
+ * @param   Map::Cell*   cell to update
+ * @param   double       new cost of the cell
+ * @return  void
+ */
+void AnyAnglePlanner::update(Map::Cell* u, double cost)
+{
+	int x = u->x();
+	int y = u->y();
+
+	if (u == _goal || _sight.cell(x, y) == cost)
+		return;
+
+	// Update km
+	_km += _h(_last, _start);
+	_last = _start;
+
+	_sight.cell(x, y, cost);
+
+	// The cell and every move that touches it (diagonals pass its corners)
+	for (int i = y - 1; i <= y + 1; i++)
+	{
+		for (int j = x - 1; j <= x + 1; j++)
+		{
+			if (_map->has(i, j))
+			{
+				_update((*_map)(i, j));
+			}
+		}
+	}
+
+	// Cells whose line to a far parent touches it
+	vector<pair<Map::Cell*, unsigned int> >& bucket = _buckets[(y / TILE) * ((_map->cols() + TILE - 1) / TILE) + x / TILE];
+
+	for (unsigned int i = 0; i < bucket.size(); )
+	{
+		Map::Cell* v = bucket[i].first;
+		State* state = _state(v);
+
+		// New parent since, forget the entry
+		if (state->stamp != bucket[i].second)
+		{
+			bucket[i] = bucket.back();
+			bucket.pop_back();
+			continue;
+		}
+
+		Map::Cell* p = state->parent;
+
+		if (LineOfSight::touches(2 * v->x() + 1, 2 * v->y() + 1, 2 * p->x() + 1, 2 * p->y() + 1, x, y))
+		{
+			_update(v);
+		}
+
+		i++;
+	}
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  void
+ */
+void AnyAnglePlanner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		update(cells[i], costs[i]);
+	}
+}
+
+/**
+ * Computes the shortest path.
+ *
+ * @return  bool   solution found
+ */
+bool AnyAnglePlanner::_compute()
+{
+	KeyCompare key_compare;
+
+	unsigned int steps = 0;
+
+	while (( ! _open_list.empty() && key_compare(_open_list.begin()->first, _k(_start)))
+		|| ! Math::equals(_state(_start)->rhs, _state(_start)->g))
+	{
+		// Reached max steps or open list exhausted, quit
+		if (++steps > MAX_STEPS || _open_list.empty())
+			return false;
+
+		Map::Cell* u = _open_list.begin()->second;
+		pair<double,double> k_old = _open_list.begin()->first;
+		pair<double,double> k_new = _k(u);
+
+		State* state = _state(u);
+
+		if (key_compare(k_old, k_new))
+		{
+			_update(u);
+			continue;
+		}
+
+		_expanded++;
+
+		if (Math::greater(state->g, state->rhs))
+		{
+			state->g = state->rhs;
+			state->via = state->parent;
+			_update(u);
+		}
+		else
+		{
+			state->g = Math::INF;
+			state->via = NULL;
+			_update(u);
+		}
+
+		_propagate(u);
+	}
+
+	return _state(_start)->g != Math::INF;
+}
+
+/**
+ * Gets the g value of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double AnyAnglePlanner::_g(Map::Cell* u)
+{
+	SH::iterator it = _states.find(u);
+
+	return (it == _states.end()) ? Math::INF : it->second.g;
+}
+
+/**
+ * Estimates the cost between two cells (straight line distance).
+ *
+ * No cell costs less than one, so the estimate is admissible.
+ *
+ * @param   Map::Cell*   a
+ * @param   Map::Cell*   b
+ * @return  double
+ */
+double AnyAnglePlanner::_h(Map::Cell* a, Map::Cell* b)
+{
+	double dx = (double) a->x() - b->x();
+	double dy = (double) a->y() - b->y();
+
+	return sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Calculates the key of a cell.
+ *
+ * @param   Map::Cell*           cell
+ * @return  pair<double,double>
+ */
+pair<double,double> AnyAnglePlanner::_k(Map::Cell* u)
+{
+	State* state = _state(u);
+
+	double g_rhs = min(state->g, state->rhs);
+
+	return pair<double,double>(g_rhs + _h(_start, u) + _km, g_rhs);
+}
+
+/**
+ * Updates the cells that depend on a cell whose g value changed.
+ *
+ * Its neighbors, and the cells that took it as a far parent.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void AnyAnglePlanner::_propagate(Map::Cell* u)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if (nbrs[k] != NULL)
+		{
+			_update(nbrs[k]);
+		}
+	}
+
+	// Swapped out first, updates may add children again
+	vector<Map::Cell*> children;
+	children.swap(_state(u)->children);
+
+	for (vector<Map::Cell*>::iterator it = children.begin(); it != children.end(); it++)
+	{
+		if (_state(*it)->parent == u)
+		{
+			_update(*it);
+		}
+	}
+
+	// Keep the ones still attached
+	State* state = _state(u);
+
+	for (vector<Map::Cell*>::iterator it = children.begin(); it != children.end(); it++)
+	{
+		if (_state(*it)->parent == u && find(state->children.begin(), state->children.end(), *it) == state->children.end())
+		{
+			state->children.push_back(*it);
+		}
+	}
+}
+
+/**
+ * Gets the state of a cell, creating it if needed.
+ *
+ * @param   Map::Cell*   cell
+ * @return  State*
+ */
+AnyAnglePlanner::State* AnyAnglePlanner::_state(Map::Cell* u)
+{
+	return &_states[u];
+}
+
+/**
+ * Recomputes the rhs value and parent of a cell and its place on the open list.
+ *
+ * Through each neighbor the cell may go to the neighbor, or straight to
+ * the neighbor's parent if the line is clear (Theta*); the cheapest wins.
+ * The current parent stays in the running, else two cells can keep taking
+ * a far parent from each other and never settle.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void AnyAnglePlanner::_update(Map::Cell* u)
+{
+	State* state = _state(u);
+
+	if (u != _goal)
+	{
+		double best = Math::INF;
+		Map::Cell* parent = NULL;
+		bool far = false;
+
+		// Keep the current parent while it holds, whoever offered it
+		if (state->parent != NULL)
+		{
+			double g = _g(state->parent);
+
+			if (g != Math::INF)
+			{
+				double cost = line(u, state->parent);
+
+				if (cost != Math::INF)
+				{
+					best = g + cost;
+					parent = state->parent;
+				}
+			}
+		}
+
+		Map::Cell** nbrs = u->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			Map::Cell* s = nbrs[k];
+
+			if (s == NULL)
+				continue;
+
+			SH::iterator it = _states.find(s);
+
+			if (it == _states.end() || it->second.g == Math::INF)
+				continue;
+
+			double cost = line(u, s);
+
+			if (cost == Math::INF)
+				continue;
+
+			if (Math::less(it->second.g + cost, best))
+			{
+				best = it->second.g + cost;
+				parent = s;
+				far = false;
+			}
+
+			// Straight to the neighbor's parent
+			Map::Cell* p = it->second.via;
+
+			if (p == NULL || p == u)
+				continue;
+
+			double g = _g(p);
+
+			if (g == Math::INF || ! Math::less(g + _h(u, p), best))
+				continue;
+
+			cost = line(u, p);
+
+			if (cost != Math::INF && Math::less(g + cost, best))
+			{
+				best = g + cost;
+				parent = p;
+				far = true;
+			}
+		}
+
+		state->rhs = best;
+
+		if (parent != state->parent)
+		{
+			state->parent = parent;
+			state->stamp++;
+
+			// A far parent: file the line and tell the parent
+			if (far)
+			{
+				unsigned int tiles = (_map->cols() + TILE - 1) / TILE;
+
+				_cells.clear();
+				_sight.line(2 * u->x() + 1, 2 * u->y() + 1, 2 * parent->x() + 1, 2 * parent->y() + 1, &_cells);
+
+				for (unsigned int i = 0; i < _cells.size(); i++)
+				{
+					_cells[i] = (_cells[i] / _map->cols() / TILE) * tiles + (_cells[i] % _map->cols()) / TILE;
+				}
+
+				sort(_cells.begin(), _cells.end());
+				_cells.erase(unique(_cells.begin(), _cells.end()), _cells.end());
+
+				for (unsigned int i = 0; i < _cells.size(); i++)
+				{
+					_buckets[_cells[i]].push_back(pair<Map::Cell*, unsigned int>(u, state->stamp));
+				}
+
+				_state(parent)->children.push_back(u);
+			}
+		}
+	}
+
+	// Open list
+	if ( ! Math::equals(state->g, state->rhs))
+	{
+		pair<double,double> key = _k(u);
+
+		if (state->open)
+		{
+			if (state->it->first == key)
+				return;
+
+			_open_list.erase(state->it);
+		}
+
+		state->it = _open_list.insert(pair<pair<double,double>, Map::Cell*>(key, u));
+		state->open = true;
+	}
+	else if (state->open)
+	{
+		_open_list.erase(state->it);
+		state->open = false;
+	}
+}
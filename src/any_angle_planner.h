@@ -0,0 +1,304 @@
+/**
+ * Any Angle Planner.
+ *
+ * D* Lite whose paths are not bound to the grid directions, after Theta*.
+ * Each cell keeps a parent, the cell its rhs value comes from, and a cell
+ * may take its neighbor's parent instead of the neighbor when the straight
+ * line to it is clear and cheaper, so parents skip over cells and the path
+ * (start, parent of the start, ...) is a few long straight legs.  Neighbors
+ * offer the parent they had when their g value was set, not the current
+ * one, so an rhs value only moves when some g value does.
+ *
+ * Repairs stay incremental.  A cost change updates the cell and the cells
+ * around it like the grid planner, plus every cell whose line to its
+ * parent touches the changed cell; those lines are filed under the tiles
+ * (TILE cells square) they cross.  When the g value of a cell changes, the
+ * cells that took it as a far parent are updated along with its neighbors.
+ *
+ * Lines are walked by LineOfSight over its row-major copy of the costs;
+ * the map itself is never written.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_ANY_ANGLE_PLANNER_H
+#define DSTARLITE_ANY_ANGLE_PLANNER_H
+
+#include <list>
+#include <map>
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "key.h"
+#include "line_of_sight.h"
+#include "map.h"
+#include "math.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class AnyAnglePlanner
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  max steps before assuming no solution possible
+			 */
+			static const unsigned int MAX_STEPS;
+
+			/**
+			 * @var  static const unsigned int  size of a tile (in cells)
+			 */
+			static const unsigned int TILE;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*         map
+			 * @param  Map::Cell*   start cell
+			 * @param  Map::Cell*   goal cell
+			 */
+			AnyAnglePlanner(Map* map, Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Gets the cost of a cell as known by the planner.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the number of cells expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the goal.
+			 *
+			 * @return  Map::Cell*
+			 */
+			Map::Cell* goal();
+
+			/**
+			 * Gets the cost of a straight line between two cell centers.
+			 *
+			 * @param   Map::Cell*   a
+			 * @param   Map::Cell*   b
+			 * @return  double       cost (Math::INF if blocked)
+			 */
+			double line(Map::Cell* a, Map::Cell* b);
+
+			/**
+			 * Gets the path from the last replan, the corners of the legs.
+			 *
+			 * @return  list<Map::Cell*>&
+			 */
+			const list<Map::Cell*>& path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets/Sets start.
+			 *
+			 * @param   Map::Cell* [optional]   new start
+			 * @return  Map::Cell*              start
+			 */
+			Map::Cell* start(Map::Cell* u = NULL);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @param   double       new cost of the cell
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			typedef multimap<pair<double,double>, Map::Cell*, KeyCompare> OL;
+
+			/**
+			 * Search state of a cell.
+			 */
+			struct State
+			{
+				double g;
+				double rhs;
+
+				/**
+				 * @var  Map::Cell*  cell the rhs value comes from (NULL if none)
+				 */
+				Map::Cell* parent;
+
+				/**
+				 * @var  Map::Cell*  parent when the g value was last set (NULL if none)
+				 */
+				Map::Cell* via;
+
+				/**
+				 * @var  unsigned int  bumped on every new parent, stale tile entries don't match
+				 */
+				unsigned int stamp;
+
+				/**
+				 * @var  vector<Map::Cell*>  cells that took this one as a far parent (some may have moved on)
+				 */
+				vector<Map::Cell*> children;
+
+				bool open;
+				OL::iterator it;
+
+				State() : g(Math::INF), rhs(Math::INF), parent(NULL), via(NULL), stamp(0), open(false) {}
+			};
+
+#ifdef WIN32
+			typedef unordered_map<Map::Cell*, State, Map::Cell::Hash> SH;
+#else
+			typedef tr1::unordered_map<Map::Cell*, State, Map::Cell::Hash> SH;
+#endif
+
+			/**
+			 * @var  vector<vector<pair<Map::Cell*, unsigned int>>>  cells (and stamps) whose parent line crosses each tile
+			 */
+			vector<vector<pair<Map::Cell*, unsigned int> > > _buckets;
+
+			/**
+			 * @var  vector<unsigned int>  scratch list of cells crossed
+			 */
+			vector<unsigned int> _cells;
+
+			/**
+			 * @var  unsigned int  cells expanded
+			 */
+			unsigned int _expanded;
+
+			/**
+			 * @var  Map::Cell*  goal
+			 */
+			Map::Cell* _goal;
+
+			/**
+			 * @var  double  accumulated heuristic value
+			 */
+			double _km;
+
+			/**
+			 * @var  Map::Cell*  start at the last cost change
+			 */
+			Map::Cell* _last;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  OL  open list
+			 */
+			OL _open_list;
+
+			/**
+			 * @var  list<Map::Cell*>  path
+			 */
+			list<Map::Cell*> _path;
+
+			/**
+			 * @var  LineOfSight  costs and lines
+			 */
+			LineOfSight _sight;
+
+			/**
+			 * @var  Map::Cell*  start
+			 */
+			Map::Cell* _start;
+
+			/**
+			 * @var  SH  cells seen so far
+			 */
+			SH _states;
+
+			/**
+			 * Computes the shortest path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool _compute();
+
+			/**
+			 * Gets the g value of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double _g(Map::Cell* u);
+
+			/**
+			 * Estimates the cost between two cells (straight line distance).
+			 *
+			 * @param   Map::Cell*   a
+			 * @param   Map::Cell*   b
+			 * @return  double
+			 */
+			double _h(Map::Cell* a, Map::Cell* b);
+
+			/**
+			 * Calculates the key of a cell.
+			 *
+			 * @param   Map::Cell*           cell
+			 * @return  pair<double,double>
+			 */
+			pair<double,double> _k(Map::Cell* u);
+
+			/**
+			 * Updates the cells that depend on a cell whose g value changed.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _propagate(Map::Cell* u);
+
+			/**
+			 * Gets the state of a cell, creating it if needed.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  State*
+			 */
+			State* _state(Map::Cell* u);
+
+			/**
+			 * Recomputes the rhs value and parent of a cell and its place on the open list.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _update(Map::Cell* u);
+	};
+};
+
+#endif // DSTARLITE_ANY_ANGLE_PLANNER_H
@@ -0,0 +1,1042 @@
+/**
+ * Bounded Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "bounded_planner.h"
+
+/**
+ * @var  static const unsigned int  no slot / not in the heap
+ */
+const unsigned int BoundedPlanner::NONE = (unsigned int) -1;
+
+/**
+ * @var  static const unsigned int  most bulges of the corridor
+ */
+const unsigned int BoundedPlanner::BULGES;
+
+/**
+ * Constructor.
+ *
+ * @param  Map*                      map
+ * @param  Map::Cell*                start cell
+ * @param  Map::Cell*                goal cell
+ * @param  unsigned int              most cells to keep state for
+ * @param  unsigned int [optional]   most changed cells (0 for the same as the capacity)
+ */
+BoundedPlanner::BoundedPlanner(Map* map, Map::Cell* start, Map::Cell* goal, unsigned int capacity, unsigned int changes)
+{
+	_map = map;
+	_start = start;
+	_goal = goal;
+
+	capacity = max(capacity, 1u);
+
+	// Table at most half full, probes stay short
+	unsigned int size = 1;
+
+	while (size < 2 * capacity)
+	{
+		size <<= 1;
+	}
+
+	_table.resize(size);
+	_slots.resize(capacity);
+	_heap.resize(capacity);
+	_path.reserve(capacity + 1);
+
+	// Changed costs outlive resets, the table is sized once too
+	_changes_max = (changes > 0) ? changes : capacity;
+
+	for (size = 1; size < 2 * _changes_max; )
+	{
+		size <<= 1;
+	}
+
+	Change free = {NULL, 0.0};
+	_changes.assign(size, free);
+	_changed = 0;
+
+	_bulges = 0;
+
+	reset();
+}
+
+/**
+ * Gets the most cells the planner keeps state for.
+ *
+ * @return  unsigned int
+ */
+unsigned int BoundedPlanner::capacity()
+{
+	return _slots.size();
+}
+
+/**
+ * Checks if the search is restricted to a corridor.
+ *
+ * @return  bool
+ */
+bool BoundedPlanner::corridor()
+{
+	return _corridor;
+}
+
+/**
+ * Gets the cost of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double BoundedPlanner::cost(Map::Cell* u)
+{
+	if (_changed == 0)
+		return u->cost;
+
+	Change& change = _changes[_change(u)];
+
+	return (change.cell == u) ? change.cost : u->cost;
+}
+
+/**
+ * Gets the goal.
+ *
+ * @return  Map::Cell*
+ */
+Map::Cell* BoundedPlanner::goal()
+{
+	return _goal;
+}
+
+/**
+ * Gets the memory held by the planner's state (in bytes, fixed).
+ *
+ * @return  unsigned int
+ */
+unsigned int BoundedPlanner::memory()
+{
+	return _slots.capacity() * sizeof(Slot) + _changes.capacity() * sizeof(Change) + (_table.capacity() + _heap.capacity()) * sizeof(unsigned int) + _path.capacity() * sizeof(Map::Cell*);
+}
+
+/**
+ * Returns the generated path.
+ *
+ * @return  vector<Map::Cell*>&
+ */
+const vector<Map::Cell*>& BoundedPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * If the slots run out, the search starts over in a corridor, widened
+ * while it is blocked.  A failure in the corridor does not mean there is
+ * no path, only none that was found within the slots; the corridor is
+ * dropped and the next replan starts over.
+ *
+ * @return  bool   solution found
+ */
+bool BoundedPlanner::replan()
+{
+	_path.clear();
+
+	bool result = ! _exhausted && _compute();
+
+	// Some state could not be kept, it is incomplete
+	if ( ! result && _exhausted)
+	{
+		if ( ! _narrow())
+			return false;
+
+		result = _compute();
+	}
+
+	// Blocked inside the corridor, a wider one may go around
+	while ( ! result && _corridor && ! _exhausted && _widen())
+	{
+		result = _compute();
+	}
+
+	if ( ! result)
+	{
+		if (_corridor)
+		{
+			reset();
+		}
+
+		return false;
+	}
+
+	Map::Cell* current = _start;
+	_path.push_back(current);
+
+	// Follow the path with the least cost until goal is reached
+	while (current != _goal)
+	{
+		if (current == NULL || _g(current) == Math::INF || _path.size() > _used)
+		{
+			_path.clear();
+			return false;
+		}
+
+		current = _min_succ(current).first;
+
+		_path.push_back(current);
+	}
+
+	return true;
+}
+
+/**
+ * Drops all state (and the corridor), the next replan starts over.
+ *
+ * @return  void
+ */
+void BoundedPlanner::reset()
+{
+	_clear();
+
+	_corridor = false;
+	_exhausted = false;
+	_km = 0;
+	_last = _start;
+
+	_list_set(_cell(_goal), true);
+}
+
+/**
+ * Gets the number of cells with state.
+ *
+ * @return  unsigned int
+ */
+unsigned int BoundedPlanner::size()
+{
+	return _used;
+}
+
+/**
+ * Gets/Sets start.
+ *
+ * @param   Map::Cell* [optional]   new start
+ * @return  Map::Cell*              start
+ */
+Map::Cell* BoundedPlanner::start(Map::Cell* u)
+{
+	if (u == NULL)
+		return _start;
+
+	_start = u;
+
+	// Left the corridor, search the whole map again
+	if (_corridor && ! _inside(u))
+	{
+		reset();
+	}
+
+	return _start;
+}
+
+/**
+ * Update map.
+ *
+ * @param   Map::Cell*   cell to update
+ * @param   double       new cost of the cell
+ * @return  bool         applied (false if the change table is full)
+ */
+bool BoundedPlanner::update(Map::Cell* u, double cost)
+{
+	double cost_old = this->cost(u);
+
+	if (u == _goal || cost_old == cost)
+		return true;
+
+	unsigned int c = _change(u);
+
+	// Back to the map's cost, or a new change
+	if (cost == u->cost)
+	{
+		_erase(c);
+	}
+	else if (_changes[c].cell == u)
+	{
+		_changes[c].cost = cost;
+	}
+	else if (_changed == _changes_max)
+	{
+		return false;
+	}
+	else
+	{
+		_changes[c].cell = u;
+		_changes[c].cost = cost;
+		_changed++;
+	}
+
+	// Update km
+	_km += _h(_last, _start);
+	_last = _start;
+
+	if ( ! _inside(u))
+		return true;
+
+	// The cell's moves and its neighbors' moves into it changed
+	_rhs(u, _min_succ(u).second);
+	_update(u);
+
+	Map::Cell** nbrs = u->nbrs();
+
+	for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+	{
+		if (nbrs[i] != NULL && nbrs[i] != _goal && _inside(nbrs[i]))
+		{
+			_rhs(nbrs[i], _min_succ(nbrs[i]).second);
+			_update(nbrs[i]);
+		}
+	}
+
+	if (Neighborhood::VIAS && (cost_old == Map::Cell::COST_UNWALKABLE) != (cost == Map::Cell::COST_UNWALKABLE))
+	{
+		_bridge(u);
+	}
+
+	return true;
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  bool                  all applied (false if the change table filled up)
+ */
+bool BoundedPlanner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	bool applied = true;
+
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		applied = update(cells[i], costs[i]) && applied;
+	}
+
+	return applied;
+}
+
+/**
+ * Bounds the number of cells in a corridor band around the line from the start to the goal.
+ *
+ * The band holds the cells within some distance of the line, their count is
+ * bounded by the area of that shape plus half its perimeter.
+ *
+ * @param   double   half width
+ * @return  double
+ */
+double BoundedPlanner::_area(double width)
+{
+	double dx = (double) _goal->x() - _start->x();
+	double dy = (double) _goal->y() - _start->y();
+	double length = sqrt(dx * dx + dy * dy);
+
+	return 2 * width * length + Math::PI * width * width + length + Math::PI * width + 1;
+}
+
+/**
+ * Recomputes the rhs of the ends of the moves that pass over a cell.
+ *
+ * @param   Map::Cell*   via cell
+ * @return  void
+ */
+void BoundedPlanner::_bridge(Map::Cell* u)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if (Neighborhood::VIA[k][0] < 0)
+			continue;
+
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			// Start of the move, opposite the via offset
+			Map::Cell* a = nbrs[(Neighborhood::VIA[k][s] + 4) % 8];
+
+			if (a == NULL || a->nbrs()[k] == NULL)
+				continue;
+
+			Map::Cell* ends[2] = {a, a->nbrs()[k]};
+
+			for (unsigned int e = 0; e < 2; e++)
+			{
+				if (ends[e] == _goal || ! _inside(ends[e]))
+					continue;
+
+				_rhs(ends[e], _min_succ(ends[e]).second);
+				_update(ends[e]);
+			}
+		}
+	}
+}
+
+/**
+ * Gets the slot of a cell, generating it.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int   slot (NONE if none is left)
+ */
+unsigned int BoundedPlanner::_cell(Map::Cell* u)
+{
+	unsigned int mask = _table.size() - 1;
+	unsigned int i = _hash(u);
+
+	for (i &= mask; _table[i] != NONE; i = (i + 1) & mask)
+	{
+		if (_slots[_table[i]].cell == u)
+			return _table[i];
+	}
+
+	if (_used == _slots.size())
+	{
+		_exhausted = true;
+		return NONE;
+	}
+
+	Slot& slot = _slots[_used];
+	slot.cell = u;
+	slot.g = Math::INF;
+	slot.rhs = Math::INF;
+	slot.heap = NONE;
+
+	_table[i] = _used;
+
+	return _used++;
+}
+
+/**
+ * Finds the change table entry of a cell, or the free entry where it goes.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int
+ */
+unsigned int BoundedPlanner::_change(Map::Cell* u)
+{
+	unsigned int mask = _changes.size() - 1;
+	unsigned int i = _hash(u) & mask;
+
+	while (_changes[i].cell != NULL && _changes[i].cell != u)
+	{
+		i = (i + 1) & mask;
+	}
+
+	return i;
+}
+
+/**
+ * Clears the slots, table and open list.
+ *
+ * @return  void
+ */
+void BoundedPlanner::_clear()
+{
+	fill(_table.begin(), _table.end(), NONE);
+
+	_used = 0;
+	_heap_size = 0;
+}
+
+/**
+ * Computes shortest path.
+ *
+ * @return  bool   successful
+ */
+bool BoundedPlanner::_compute()
+{
+	if (_heap_size == 0)
+		return false;
+
+	KeyCompare key_compare;
+
+	int attempts = 0;
+
+	Map::Cell* u;
+	unsigned int s;
+	pair<double,double> k_old;
+	pair<double,double> k_new;
+	Map::Cell** nbrs;
+	double g_old;
+	double tmp_g, tmp_rhs;
+
+	while ((_heap_size > 0 && key_compare(_slots[_heap[0]].key, _k(_start))) || ! Math::equals(_rhs(_start), _g(_start)))
+	{
+		// Out of slots, or reached max steps, quit
+		if (_exhausted || ++attempts > Planner::MAX_STEPS)
+			return false;
+
+		// Open list exhausted
+		if (_heap_size == 0)
+			return false;
+
+		s = _heap[0];
+		u = _slots[s].cell;
+		k_old = _slots[s].key;
+		k_new = _k(u);
+
+		tmp_rhs = _slots[s].rhs;
+		tmp_g = _slots[s].g;
+
+		if (u == _goal)
+		{
+			tmp_rhs = 0;
+		}
+
+		nbrs = u->nbrs();
+
+		if (key_compare(k_old, k_new))
+		{
+			_list_set(s, true);
+		}
+		else if (Math::greater(tmp_g, tmp_rhs))
+		{
+			_slots[s].g = tmp_rhs;
+			tmp_g = tmp_rhs;
+
+			_list_set(s, false);
+
+			for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+			{
+				if (nbrs[i] == NULL || ! _inside(nbrs[i]))
+					continue;
+
+				if (nbrs[i] != _goal)
+				{
+					_rhs(nbrs[i], min(_rhs(nbrs[i]), _cost(u, i) + tmp_g));
+				}
+
+				_update(nbrs[i]);
+			}
+		}
+		else
+		{
+			g_old = tmp_g;
+			_slots[s].g = Math::INF;
+
+			// Perform action for u
+			if (u != _goal)
+			{
+				_rhs(u, _min_succ(u).second);
+			}
+
+			_update(u);
+
+			// Perform action for neighbors
+			for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+			{
+				if (nbrs[i] == NULL || ! _inside(nbrs[i]))
+					continue;
+
+				if (nbrs[i] != _goal && Math::equals(_rhs(nbrs[i]), (_cost(u, i) + g_old)))
+				{
+					_rhs(nbrs[i], _min_succ(nbrs[i]).second);
+				}
+
+				_update(nbrs[i]);
+			}
+		}
+	}
+
+	// Consistent but cut off from the goal
+	return ! _exhausted && _g(_start) != Math::INF;
+}
+
+/**
+ * Calculates the cost from a cell to one of its neighbors.
+ *
+ * Moves are symmetric, the cost from the neighbor back to a is the same.
+ *
+ * @param   Map::Cell*     cell a
+ * @param   unsigned int   neighbor index
+ * @return  double         cost between a and the neighbor
+ */
+double BoundedPlanner::_cost(Map::Cell* a, unsigned int k)
+{
+	Map::Cell** nbrs = a->nbrs();
+	Map::Cell* b = nbrs[k];
+
+	double cost_a = cost(a);
+	double cost_b = cost(b);
+
+	if (cost_a == Map::Cell::COST_UNWALKABLE || cost_b == Map::Cell::COST_UNWALKABLE || ! _inside(a) || ! _inside(b))
+		return Map::Cell::COST_UNWALKABLE;
+
+	// Moves that skip a cell may not cut through walls
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			Map::Cell* via = nbrs[Neighborhood::VIA[k][s]];
+
+			if (cost(via) == Map::Cell::COST_UNWALKABLE || ! _inside(via))
+				return Map::Cell::COST_UNWALKABLE;
+		}
+	}
+
+	return Neighborhood::COST[k] * ((cost_a + cost_b) / 2);
+}
+
+/**
+ * Removes an entry of the change table, moving later entries of its probe run back.
+ *
+ * No tombstones, so lookups never slow down however many changes are undone.
+ *
+ * @param   unsigned int   entry
+ * @return  void
+ */
+void BoundedPlanner::_erase(unsigned int i)
+{
+	if (_changes[i].cell == NULL)
+		return;
+
+	unsigned int mask = _changes.size() - 1;
+
+	for (unsigned int j = (i + 1) & mask; _changes[j].cell != NULL; j = (j + 1) & mask)
+	{
+		unsigned int home = _hash(_changes[j].cell) & mask;
+
+		// Entry j may move to i if its home is not between them
+		if (((j - home) & mask) >= ((j - i) & mask))
+		{
+			_changes[i] = _changes[j];
+			i = j;
+		}
+	}
+
+	_changes[i].cell = NULL;
+	_changed--;
+}
+
+/**
+ * Finds the slot of a cell without generating it.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int   slot (NONE if never generated)
+ */
+unsigned int BoundedPlanner::_find(Map::Cell* u)
+{
+	unsigned int mask = _table.size() - 1;
+	unsigned int i = _hash(u);
+
+	for (i &= mask; _table[i] != NONE; i = (i + 1) & mask)
+	{
+		if (_slots[_table[i]].cell == u)
+			return _table[i];
+	}
+
+	return NONE;
+}
+
+/**
+ * Gets/Sets g value for a cell.
+ *
+ * @param   Map::Cell*          cell to retrieve/update
+ * @param   double [optional]   new g value
+ * @return  double              g value
+ */
+double BoundedPlanner::_g(Map::Cell* u, double value)
+{
+	unsigned int s = _find(u);
+
+	if (value == DBL_MIN)
+		return (s == NONE) ? Math::INF : _slots[s].g;
+
+	// Never generated cells are already at infinity
+	if (s == NONE && value != Math::INF)
+	{
+		s = _cell(u);
+	}
+
+	if (s != NONE)
+	{
+		_slots[s].g = value;
+	}
+
+	return value;
+}
+
+/**
+ * Hashes a cell for the slot and change tables.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int
+ */
+unsigned int BoundedPlanner::_hash(Map::Cell* u)
+{
+	return ((unsigned int) u->y() * 73856093u) ^ ((unsigned int) u->x() * 19349663u);
+}
+
+/**
+ * Calculates heuristic between two cells.
+ *
+ * @param   Map::Cell*   cell a
+ * @param   Map::Cell*   cell b
+ * @return  double       heuristic value
+ */
+double BoundedPlanner::_h(Map::Cell* a, Map::Cell* b)
+{
+	unsigned int dx = abs((int) a->x() - (int) b->x());
+	unsigned int dy = abs((int) a->y() - (int) b->y());
+
+	return Neighborhood::h(dx, dy);
+}
+
+/**
+ * Checks if a cell is inside the corridor (always when there is none).
+ *
+ * @param   Map::Cell*   cell
+ * @return  bool
+ */
+bool BoundedPlanner::_inside(Map::Cell* u)
+{
+	if ( ! _corridor)
+		return true;
+
+	double px = (double) u->x() - _corridor_x[0];
+	double py = (double) u->y() - _corridor_y[0];
+	double dx = _corridor_x[1] - _corridor_x[0];
+	double dy = _corridor_y[1] - _corridor_y[0];
+
+	// Closest point of the line
+	double length = dx * dx + dy * dy;
+	double t = (length > 0) ? (px * dx + py * dy) / length : 0.0;
+
+	t = max(0.0, min(1.0, t));
+
+	double ex = px - t * dx;
+	double ey = py - t * dy;
+
+	if (ex * ex + ey * ey <= _corridor_width * _corridor_width)
+		return true;
+
+	for (unsigned int b = 0; b < _bulges; b++)
+	{
+		double bx = (double) u->x() - _bulge_x[b];
+		double by = (double) u->y() - _bulge_y[b];
+
+		if (bx * bx + by * by <= _bulge_radius * _bulge_radius)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * Calculates key value for cell.
+ *
+ * @param   Map::Cell*            cell to calculate for
+ * @return  pair<double,double>   key value
+ */
+pair<double,double> BoundedPlanner::_k(Map::Cell* u)
+{
+	double g = _g(u);
+	double rhs = _rhs(u);
+	double min = (g < rhs) ? g : rhs;
+	return pair<double,double>((min + _h(_start, u) + _km), min);
+}
+
+/**
+ * Moves a heap entry down to its place.
+ *
+ * @param   unsigned int   heap position
+ * @return  void
+ */
+void BoundedPlanner::_list_down(unsigned int i)
+{
+	KeyCompare key_compare;
+
+	while (true)
+	{
+		unsigned int least = i;
+		unsigned int left = 2 * i + 1;
+		unsigned int right = left + 1;
+
+		if (left < _heap_size && key_compare(_slots[_heap[left]].key, _slots[_heap[least]].key))
+		{
+			least = left;
+		}
+
+		if (right < _heap_size && key_compare(_slots[_heap[right]].key, _slots[_heap[least]].key))
+		{
+			least = right;
+		}
+
+		if (least == i)
+			return;
+
+		swap(_heap[i], _heap[least]);
+		_slots[_heap[i]].heap = i;
+		_slots[_heap[least]].heap = least;
+
+		i = least;
+	}
+}
+
+/**
+ * Inserts, moves or removes a cell in the open list.
+ *
+ * @param   unsigned int   slot
+ * @param   bool           keep it in the open list
+ * @return  void
+ */
+void BoundedPlanner::_list_set(unsigned int s, bool open)
+{
+	Slot& slot = _slots[s];
+
+	if (open)
+	{
+		slot.key = _k(slot.cell);
+
+		if (slot.heap == NONE)
+		{
+			slot.heap = _heap_size;
+			_heap[_heap_size++] = s;
+		}
+
+		_list_up(slot.heap);
+		_list_down(slot.heap);
+	}
+	else if (slot.heap != NONE)
+	{
+		unsigned int i = slot.heap;
+		slot.heap = NONE;
+
+		// Last entry takes its place
+		if (i < --_heap_size)
+		{
+			unsigned int last = _heap[_heap_size];
+
+			_heap[i] = last;
+			_slots[last].heap = i;
+
+			_list_up(i);
+			_list_down(_slots[last].heap);
+		}
+	}
+}
+
+/**
+ * Moves a heap entry up to its place.
+ *
+ * @param   unsigned int   heap position
+ * @return  void
+ */
+void BoundedPlanner::_list_up(unsigned int i)
+{
+	KeyCompare key_compare;
+
+	while (i > 0)
+	{
+		unsigned int parent = (i - 1) / 2;
+
+		if ( ! key_compare(_slots[_heap[i]].key, _slots[_heap[parent]].key))
+			return;
+
+		swap(_heap[i], _heap[parent]);
+		_slots[_heap[i]].heap = i;
+		_slots[_heap[parent]].heap = parent;
+
+		i = parent;
+	}
+}
+
+/**
+ * Finds the minimum successor cell.
+ *
+ * @param   Map::Cell*            root
+ * @return  <Map::Cell*,double>   successor
+ */
+pair<Map::Cell*,double> BoundedPlanner::_min_succ(Map::Cell* u)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	double tmp_cost, tmp_g;
+
+	Map::Cell* min_cell = NULL;
+	double min_cost = Math::INF;
+
+	for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+	{
+		if (nbrs[i] != NULL)
+		{
+			tmp_cost = _cost(u, i);
+			tmp_g = _g(nbrs[i]);
+
+			if (tmp_cost == Math::INF || tmp_g == Math::INF)
+				continue;
+
+			tmp_cost += tmp_g;
+
+			if (tmp_cost < min_cost)
+			{
+				min_cell = nbrs[i];
+				min_cost = tmp_cost;
+			}
+		}
+	}
+
+	return pair<Map::Cell*,double>(min_cell, min_cost);
+}
+
+/**
+ * Drops all state and restricts the search to a corridor that fits.
+ *
+ * The corridor is a band around the line from the start to the goal, made
+ * as wide as the slots allow.
+ *
+ * @return  bool   a corridor fits
+ */
+bool BoundedPlanner::_narrow()
+{
+	reset();
+
+	double capacity = _slots.size();
+	double width = 0.0;
+
+	while (_area(width + 0.5) <= capacity)
+	{
+		width += 0.5;
+	}
+
+	// Too thin to hold a diagonal line
+	if (width < 1.0)
+		return false;
+
+	_bulges = 0;
+	_restrict(width);
+
+	return true;
+}
+
+/**
+ * Restricts the search to a corridor around the line from the start to the goal.
+ *
+ * Keys do not depend on the corridor, the goal entry stays valid.
+ *
+ * @param   double   half width
+ * @return  void
+ */
+void BoundedPlanner::_restrict(double width)
+{
+	_corridor = true;
+	_corridor_width = width;
+	_corridor_x[0] = _start->x();
+	_corridor_y[0] = _start->y();
+	_corridor_x[1] = _goal->x();
+	_corridor_y[1] = _goal->y();
+}
+
+/**
+ * Gets/Sets rhs value for a cell.
+ *
+ * @param   Map::Cell*          cell to retrieve/update
+ * @param   double [optional]   new rhs value
+ * @return  double              rhs value
+ */
+double BoundedPlanner::_rhs(Map::Cell* u, double value)
+{
+	if (u == _goal)
+		return 0;
+
+	unsigned int s = _find(u);
+
+	if (value == DBL_MIN)
+		return (s == NONE) ? Math::INF : _slots[s].rhs;
+
+	// Never generated cells are already at infinity
+	if (s == NONE && value != Math::INF)
+	{
+		s = _cell(u);
+	}
+
+	if (s != NONE)
+	{
+		_slots[s].rhs = value;
+	}
+
+	return value;
+}
+
+/**
+ * Updates cell.
+ *
+ * @param   Map::Cell*   cell to update
+ * @return  void
+ */
+void BoundedPlanner::_update(Map::Cell* u)
+{
+	unsigned int s = _find(u);
+
+	// No state, g = rhs = INF
+	if (s == NONE)
+		return;
+
+	_list_set(s, _g(u) != _rhs(u));
+}
+
+/**
+ * Drops all state and bulges the corridor where the search was cut off.
+ *
+ * The search got as close to the start as the cell reached from the goal
+ * that is nearest to it, the obstacle in the way is there.  The band is
+ * thinned to hold just the line, and the slots left over are shared by the
+ * bulges: a disk of radius r holds at most PI (r + 1)^2 cells, so the
+ * search still fits.
+ *
+ * @return  bool   widened (false if no bulge is left or would help)
+ */
+bool BoundedPlanner::_widen()
+{
+	double left = _slots.size() - _area(1.0);
+
+	if (_bulges == BULGES || left <= 0)
+		return false;
+
+	double radius = sqrt(left / (Math::PI * (_bulges + 1))) - 1.0;
+
+	if (radius <= 1.0)
+		return false;
+
+	Map::Cell* cut = _goal;
+
+	for (unsigned int s = 0; s < _used; s++)
+	{
+		if (_slots[s].g != Math::INF && _h(_start, _slots[s].cell) < _h(_start, cut))
+		{
+			cut = _slots[s].cell;
+		}
+	}
+
+	// Cut off inside a bulge already, a smaller one will not go around
+	for (unsigned int b = 0; b < _bulges; b++)
+	{
+		double bx = (double) cut->x() - _bulge_x[b];
+		double by = (double) cut->y() - _bulge_y[b];
+
+		if (bx * bx + by * by <= _bulge_radius * _bulge_radius)
+			return false;
+	}
+
+	reset();
+
+	_bulge_x[_bulges] = cut->x();
+	_bulge_y[_bulges] = cut->y();
+	_bulges++;
+	_bulge_radius = radius;
+
+	_restrict(1.0);
+
+	return true;
+}
@@ -0,0 +1,446 @@
+/**
+ * Bounded Planner.
+ *
+ * D* Lite with a hard memory cap, for controllers that cannot allocate
+ * while running.  Cell state lives in a fixed pool of slots found through an
+ * open addressing table, the open list is a binary heap over the slots and
+ * the path goes into a vector reserved up front; nothing is allocated after
+ * the constructor.
+ *
+ * When the slots run out the search cannot go on as is.  The planner then
+ * drops its state and searches again inside a corridor around the line from
+ * the start to the goal, as wide as the slots allow (cells outside it are
+ * treated as blocked), so the search always fits.  If an obstacle blocks
+ * it, the corridor is widened step by step: each step thins the band to a
+ * line and bulges it around the cell where the search was cut off, the
+ * bulges sharing what is left of the slots.  The corridor stays until the
+ * start leaves it or the planner is reset.
+ *
+ * Like Planner, the map is never written: changed costs are kept in a table
+ * sized by the constructor (an overlay would allocate pages).  Once the
+ * table is full, further changes are refused.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_BOUNDED_PLANNER_H
+#define DSTARLITE_BOUNDED_PLANNER_H
+
+#include <vector>
+
+#include "map.h"
+#include "math.h"
+#include "planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class BoundedPlanner
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  most bulges of the corridor
+			 */
+			static const unsigned int BULGES = 4;
+
+			/**
+			 * @var  static const unsigned int  no slot / not in the heap
+			 */
+			static const unsigned int NONE;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*                      map
+			 * @param  Map::Cell*                start cell
+			 * @param  Map::Cell*                goal cell
+			 * @param  unsigned int              most cells to keep state for
+			 * @param  unsigned int [optional]   most changed cells (0 for the same as the capacity)
+			 */
+			BoundedPlanner(Map* map, Map::Cell* start, Map::Cell* goal, unsigned int capacity, unsigned int changes = 0);
+
+			/**
+			 * Gets the most cells the planner keeps state for.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int capacity();
+
+			/**
+			 * Checks if the search is restricted to a corridor.
+			 *
+			 * @return  bool
+			 */
+			bool corridor();
+
+			/**
+			 * Gets the cost of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the goal.
+			 *
+			 * @return  Map::Cell*
+			 */
+			Map::Cell* goal();
+
+			/**
+			 * Gets the memory held by the planner's state (in bytes, fixed).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int memory();
+
+			/**
+			 * Returns the generated path.
+			 *
+			 * @return  vector<Map::Cell*>&
+			 */
+			const vector<Map::Cell*>& path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Drops all state (and the corridor), the next replan starts over.
+			 *
+			 * @return  void
+			 */
+			void reset();
+
+			/**
+			 * Gets the number of cells with state.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+			/**
+			 * Gets/Sets start.
+			 *
+			 * @param   Map::Cell* [optional]   new start
+			 * @return  Map::Cell*              start
+			 */
+			Map::Cell* start(Map::Cell* u = NULL);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @param   double       new cost of the cell
+			 * @return  bool         applied (false if the change table is full)
+			 */
+			bool update(Map::Cell* u, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  bool                  all applied (false if the change table filled up)
+			 */
+			bool update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * Changed cost of a cell.
+			 */
+			struct Change
+			{
+				Map::Cell* cell;
+				double cost;
+			};
+
+			/**
+			 * State of a cell.
+			 */
+			struct Slot
+			{
+				Map::Cell* cell;
+				double g;
+				double rhs;
+				pair<double,double> key;
+				unsigned int heap;
+			};
+
+			/**
+			 * @var  int  bulge centers (x, y), the cells where the corridor was cut off
+			 */
+			int _bulge_x[BULGES];
+			int _bulge_y[BULGES];
+			unsigned int _bulges;
+
+			/**
+			 * @var  double  bulge radius
+			 */
+			double _bulge_radius;
+
+			/**
+			 * @var  vector<Change>  open addressing table of changed costs (power of two, NULL cell if free)
+			 */
+			vector<Change> _changes;
+			unsigned int _changed;
+			unsigned int _changes_max;
+
+			/**
+			 * @var  bool  search restricted to the corridor
+			 */
+			bool _corridor;
+
+			/**
+			 * @var  int  corridor line ends (x, y)
+			 */
+			int _corridor_x[2];
+			int _corridor_y[2];
+
+			/**
+			 * @var  double  corridor half width
+			 */
+			double _corridor_width;
+
+			/**
+			 * @var  bool  a cell needed a slot and none was left
+			 */
+			bool _exhausted;
+
+			/**
+			 * @var  vector<unsigned int>  open list, binary heap of slots
+			 */
+			vector<unsigned int> _heap;
+			unsigned int _heap_size;
+
+			/**
+			 * @var  double  key modifier
+			 */
+			double _km;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  vector<Map::Cell*>  path
+			 */
+			vector<Map::Cell*> _path;
+
+			/**
+			 * @var  vector<Slot>  cell states
+			 */
+			vector<Slot> _slots;
+			unsigned int _used;
+
+			/**
+			 * @var  Map::Cell*  start, goal and last start cells
+			 */
+			Map::Cell* _start;
+			Map::Cell* _goal;
+			Map::Cell* _last;
+
+			/**
+			 * @var  vector<unsigned int>  open addressing table of slots (power of two)
+			 */
+			vector<unsigned int> _table;
+
+			/**
+			 * Bounds the number of cells in a corridor band around the line from the start to the goal.
+			 *
+			 * @param   double   half width
+			 * @return  double
+			 */
+			double _area(double width);
+
+			/**
+			 * Recomputes the rhs of the ends of the moves that pass over a cell.
+			 *
+			 * @param   Map::Cell*   via cell
+			 * @return  void
+			 */
+			void _bridge(Map::Cell* u);
+
+			/**
+			 * Gets the slot of a cell, generating it.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int   slot (NONE if none is left)
+			 */
+			unsigned int _cell(Map::Cell* u);
+
+			/**
+			 * Finds the change table entry of a cell, or the free entry where it goes.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int
+			 */
+			unsigned int _change(Map::Cell* u);
+
+			/**
+			 * Clears the slots, table and open list.
+			 *
+			 * @return  void
+			 */
+			void _clear();
+
+			/**
+			 * Computes shortest path.
+			 *
+			 * @return  bool   successful
+			 */
+			bool _compute();
+
+			/**
+			 * Calculates the cost from a cell to one of its neighbors.
+			 *
+			 * @param   Map::Cell*     cell a
+			 * @param   unsigned int   neighbor index
+			 * @return  double         cost between a and the neighbor
+			 */
+			double _cost(Map::Cell* a, unsigned int k);
+
+			/**
+			 * Removes an entry of the change table, moving later entries of its probe run back.
+			 *
+			 * @param   unsigned int   entry
+			 * @return  void
+			 */
+			void _erase(unsigned int i);
+
+			/**
+			 * Finds the slot of a cell without generating it.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int   slot (NONE if never generated)
+			 */
+			unsigned int _find(Map::Cell* u);
+
+			/**
+			 * Gets/Sets g value for a cell.
+			 *
+			 * @param   Map::Cell*          cell to retrieve/update
+			 * @param   double [optional]   new g value
+			 * @return  double              g value
+			 */
+			double _g(Map::Cell* u, double value = DBL_MIN);
+
+			/**
+			 * Hashes a cell for the slot and change tables.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int
+			 */
+			unsigned int _hash(Map::Cell* u);
+
+			/**
+			 * Calculates heuristic between two cells.
+			 *
+			 * @param   Map::Cell*   cell a
+			 * @param   Map::Cell*   cell b
+			 * @return  double       heuristic value
+			 */
+			double _h(Map::Cell* a, Map::Cell* b);
+
+			/**
+			 * Checks if a cell is inside the corridor (always when there is none).
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  bool
+			 */
+			bool _inside(Map::Cell* u);
+
+			/**
+			 * Calculates key value for cell.
+			 *
+			 * @param   Map::Cell*            cell to calculate for
+			 * @return  pair<double,double>   key value
+			 */
+			pair<double,double> _k(Map::Cell* u);
+
+			/**
+			 * Moves a heap entry down to its place.
+			 *
+			 * @param   unsigned int   heap position
+			 * @return  void
+			 */
+			void _list_down(unsigned int i);
+
+			/**
+			 * Inserts, moves or removes a cell in the open list.
+			 *
+			 * @param   unsigned int   slot
+			 * @param   bool           keep it in the open list
+			 * @return  void
+			 */
+			void _list_set(unsigned int s, bool open);
+
+			/**
+			 * Moves a heap entry up to its place.
+			 *
+			 * @param   unsigned int   heap position
+			 * @return  void
+			 */
+			void _list_up(unsigned int i);
+
+			/**
+			 * Finds the minimum successor cell.
+			 *
+			 * @param   Map::Cell*                root
+			 * @return  pair<Map::Cell*,double>   successor
+			 */
+			pair<Map::Cell*,double> _min_succ(Map::Cell* u);
+
+			/**
+			 * Drops all state and restricts the search to a corridor that fits.
+			 *
+			 * @return  bool   a corridor fits
+			 */
+			bool _narrow();
+
+			/**
+			 * Restricts the search to a corridor around the line from the start to the goal.
+			 *
+			 * @param   double   half width
+			 * @return  void
+			 */
+			void _restrict(double width);
+
+			/**
+			 * Gets/Sets rhs value for a cell.
+			 *
+			 * @param   Map::Cell*          cell to retrieve/update
+			 * @param   double [optional]   new rhs value
+			 * @return  double              rhs value
+			 */
+			double _rhs(Map::Cell* u, double value = DBL_MIN);
+
+			/**
+			 * Updates cell.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @return  void
+			 */
+			void _update(Map::Cell* u);
+
+			/**
+			 * Drops all state and bulges the corridor where the search was cut off.
+			 *
+			 * @return  bool   widened (false if no bulge is left or would help)
+			 */
+			bool _widen();
+	};
+};
+
+#endif // DSTARLITE_BOUNDED_PLANNER_H
@@ -0,0 +1,399 @@
+/**
+ * Components.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "components.h"
+
+/**
+ * @var  static const unsigned int  label of unwalkable cells
+ */
+const unsigned int Components::NONE = (unsigned int) -1;
+
+/**
+ * Constructor, labels the whole map.
+ *
+ * @param  Map*           map
+ * @param  CostOverlay*   costs
+ */
+Components::Components(Map* map, CostOverlay* overlay)
+{
+	_map = map;
+	_overlay = overlay;
+	_stamp = 0;
+
+	unsigned int rows = map->rows();
+	unsigned int cols = map->cols();
+
+	_labels.assign(rows * cols, NONE);
+	_marks.assign(rows * cols, 0);
+	_owners.assign(rows * cols, 0);
+
+	_queues.resize(Map::Cell::NUM_NBRS);
+	_heads.resize(Map::Cell::NUM_NBRS);
+
+	for (unsigned int i = 0; i < rows; i++)
+	{
+		for (unsigned int j = 0; j < cols; j++)
+		{
+			Map::Cell* u = (*map)(i, j);
+
+			if (_labels[_index(u)] != NONE || ! _walkable(u))
+				continue;
+
+			unsigned int label = _label();
+			_sizes[label] = _flood(u, NONE, label);
+		}
+	}
+}
+
+/**
+ * Checks if a path can join two cells.
+ *
+ * @param   Map::Cell*   a
+ * @param   Map::Cell*   b
+ * @return  bool
+ */
+bool Components::connected(Map::Cell* a, Map::Cell* b)
+{
+	unsigned int label = _labels[_index(a)];
+
+	return label != NONE && label == _labels[_index(b)];
+}
+
+/**
+ * Gets the number of components.
+ *
+ * @return  unsigned int
+ */
+unsigned int Components::count()
+{
+	return _sizes.size() - _free.size();
+}
+
+/**
+ * Gets the component of a cell.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int   label (NONE if unwalkable)
+ */
+unsigned int Components::label(Map::Cell* u)
+{
+	return _labels[_index(u)];
+}
+
+/**
+ * Catches up with a cell whose cost changed.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void Components::update(Map::Cell* u)
+{
+	bool was = _labels[_index(u)] != NONE;
+	bool is = _walkable(u);
+
+	if (is && ! was)
+	{
+		_join(u);
+	}
+	else if (was && ! is)
+	{
+		_split(u);
+	}
+}
+
+/**
+ * Relabels the cells of a component reachable from a cell.
+ *
+ * @param   Map::Cell*     first cell
+ * @param   unsigned int   old label
+ * @param   unsigned int   new label
+ * @return  unsigned int   cells relabeled
+ */
+unsigned int Components::_flood(Map::Cell* u, unsigned int from, unsigned int to)
+{
+	vector<Map::Cell*>& queue = _queues[0];
+
+	queue.clear();
+	queue.push_back(u);
+	_labels[_index(u)] = to;
+
+	for (unsigned int head = 0; head < queue.size(); head++)
+	{
+		Map::Cell* v = queue[head];
+		Map::Cell** nbrs = v->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if ( ! _linked(v, k) || _labels[_index(nbrs[k])] != from)
+				continue;
+
+			_labels[_index(nbrs[k])] = to;
+			queue.push_back(nbrs[k]);
+		}
+	}
+
+	return queue.size();
+}
+
+/**
+ * Gets the index of a cell.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int
+ */
+unsigned int Components::_index(Map::Cell* u)
+{
+	return u->y() * _map->cols() + u->x();
+}
+
+/**
+ * Merges the components next to a cell that became walkable.
+ *
+ * Moves that pass over the cell join two of its neighbors, those are
+ * joined through the cell as well.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void Components::_join(Map::Cell* u)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	// Largest component around takes the cell
+	unsigned int largest = NONE;
+
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if ( ! _linked(u, k))
+			continue;
+
+		unsigned int label = _labels[_index(nbrs[k])];
+
+		if (largest == NONE || _sizes[label] > _sizes[largest])
+		{
+			largest = label;
+		}
+	}
+
+	if (largest == NONE)
+	{
+		largest = _label();
+	}
+
+	_labels[_index(u)] = largest;
+	_sizes[largest]++;
+
+	// The others are relabeled into it
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if ( ! _linked(u, k))
+			continue;
+
+		unsigned int label = _labels[_index(nbrs[k])];
+
+		if (label == largest)
+			continue;
+
+		_sizes[largest] += _flood(nbrs[k], label, largest);
+		_sizes[label] = 0;
+		_free.push_back(label);
+	}
+}
+
+/**
+ * Gets an unused label.
+ *
+ * @return  unsigned int
+ */
+unsigned int Components::_label()
+{
+	if (_free.empty())
+	{
+		_sizes.push_back(0);
+		return _sizes.size() - 1;
+	}
+
+	unsigned int label = _free.back();
+	_free.pop_back();
+
+	return label;
+}
+
+/**
+ * Checks if a move links a cell to one of its neighbors.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   neighbor index
+ * @return  bool
+ */
+bool Components::_linked(Map::Cell* u, unsigned int k)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	if (nbrs[k] == NULL || ! _walkable(u) || ! _walkable(nbrs[k]))
+		return false;
+
+	// Moves that skip a cell may not cut through walls
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		if ( ! _walkable(nbrs[Neighborhood::VIA[k][0]]) || ! _walkable(nbrs[Neighborhood::VIA[k][1]]))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Splits off the pieces cut off by a cell that became unwalkable.
+ *
+ * Every link the cell took away had an end next to it (moves passing over
+ * it included), so the former neighbors are the only floods needed.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void Components::_split(Map::Cell* u)
+{
+	unsigned int old = _labels[_index(u)];
+
+	_labels[_index(u)] = NONE;
+
+	if (--_sizes[old] == 0)
+	{
+		_free.push_back(old);
+		return;
+	}
+
+	Map::Cell** nbrs = u->nbrs();
+
+	// One flood per neighbor, classes of floods that met (tiny union-find)
+	unsigned int floods = 0;
+	unsigned int classes[Map::Cell::NUM_NBRS];
+	bool closed[Map::Cell::NUM_NBRS];
+
+	_stamp++;
+
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if (nbrs[k] == NULL || _labels[_index(nbrs[k])] != old || _marks[_index(nbrs[k])] == _stamp)
+			continue;
+
+		_marks[_index(nbrs[k])] = _stamp;
+		_owners[_index(nbrs[k])] = floods;
+
+		_queues[floods].clear();
+		_queues[floods].push_back(nbrs[k]);
+		_heads[floods] = 0;
+
+		classes[floods] = floods;
+		closed[floods] = false;
+		floods++;
+	}
+
+	unsigned int active = floods;
+
+	while (active > 1)
+	{
+		// One step of each flood
+		for (unsigned int i = 0; i < floods && active > 1; i++)
+		{
+			if (_heads[i] == _queues[i].size())
+				continue;
+
+			Map::Cell* v = _queues[i][_heads[i]++];
+			Map::Cell** v_nbrs = v->nbrs();
+
+			for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+			{
+				if ( ! _linked(v, k))
+					continue;
+
+				unsigned int w = _index(v_nbrs[k]);
+
+				if (_marks[w] != _stamp)
+				{
+					_marks[w] = _stamp;
+					_owners[w] = i;
+					_queues[i].push_back(v_nbrs[k]);
+					continue;
+				}
+
+				// Met another flood, same piece
+				unsigned int a = i, b = _owners[w];
+
+				while (classes[a] != a) a = classes[a];
+				while (classes[b] != b) b = classes[b];
+
+				if (a != b)
+				{
+					classes[b] = a;
+					active--;
+				}
+			}
+		}
+
+		// A class whose floods all ran out is a piece of its own
+		for (unsigned int c = 0; c < floods && active > 1; c++)
+		{
+			if (classes[c] != c || closed[c])
+				continue;
+
+			bool done = true;
+
+			for (unsigned int i = 0; i < floods && done; i++)
+			{
+				unsigned int a = i;
+
+				while (classes[a] != a) a = classes[a];
+
+				done = (a != c || _heads[i] == _queues[i].size());
+			}
+
+			if ( ! done)
+				continue;
+
+			unsigned int label = _label();
+
+			for (unsigned int i = 0; i < floods; i++)
+			{
+				unsigned int a = i;
+
+				while (classes[a] != a) a = classes[a];
+
+				if (a != c)
+					continue;
+
+				for (unsigned int j = 0; j < _queues[i].size(); j++)
+				{
+					_labels[_index(_queues[i][j])] = label;
+				}
+
+				_sizes[label] += _queues[i].size();
+				_sizes[old] -= _queues[i].size();
+
+				// Out of the running
+				_queues[i].clear();
+				_heads[i] = 0;
+			}
+
+			closed[c] = true;
+			active--;
+		}
+	}
+}
+
+/**
+ * Checks if a cell is walkable.
+ *
+ * @param   Map::Cell*   cell
+ * @return  bool
+ */
+bool Components::_walkable(Map::Cell* u)
+{
+	return _overlay->cost(u) != Map::Cell::COST_UNWALKABLE;
+}
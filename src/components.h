@@ -0,0 +1,184 @@
+/**
+ * Components.
+ *
+ * Connected components of the walkable cells, kept up to date as cells
+ * change, so a planner can tell in O(1) that the goal is walled off instead
+ * of searching until it runs out of steps.  Cells are linked like the
+ * planner moves (see Neighborhood).
+ *
+ * Each walkable cell carries the label of its component.  When a cell
+ * becomes walkable the components it touches are merged, the smaller ones
+ * relabeled into the largest.  When a cell becomes unwalkable its former
+ * neighbors are flooded from in lockstep: floods that meet are one piece,
+ * and a flood that runs out before meeting the others is a piece that got
+ * cut off and gets a new label.  Most removals are settled around the cell
+ * after a few steps, a split costs the size of the smaller pieces.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_COMPONENTS_H
+#define DSTARLITE_COMPONENTS_H
+
+#include <vector>
+
+#include "cost_overlay.h"
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class Components
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  label of unwalkable cells
+			 */
+			static const unsigned int NONE;
+
+			/**
+			 * Constructor, labels the whole map.
+			 *
+			 * @param  Map*           map
+			 * @param  CostOverlay*   costs
+			 */
+			Components(Map* map, CostOverlay* overlay);
+
+			/**
+			 * Checks if a path can join two cells.
+			 *
+			 * @param   Map::Cell*   a
+			 * @param   Map::Cell*   b
+			 * @return  bool
+			 */
+			bool connected(Map::Cell* a, Map::Cell* b);
+
+			/**
+			 * Gets the number of components.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int count();
+
+			/**
+			 * Gets the component of a cell.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int   label (NONE if unwalkable)
+			 */
+			unsigned int label(Map::Cell* u);
+
+			/**
+			 * Catches up with a cell whose cost changed.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void update(Map::Cell* u);
+
+		protected:
+
+			/**
+			 * @var  vector<unsigned int>  free labels
+			 */
+			vector<unsigned int> _free;
+
+			/**
+			 * @var  vector<unsigned int>  component label of each cell
+			 */
+			vector<unsigned int> _labels;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  vector<unsigned int>  flood a cell was reached by, valid if marked with the current stamp
+			 */
+			vector<unsigned int> _marks;
+			vector<unsigned char> _owners;
+			unsigned int _stamp;
+
+			/**
+			 * @var  CostOverlay*  costs
+			 */
+			CostOverlay* _overlay;
+
+			/**
+			 * @var  vector<vector<Map::Cell*>>  cells reached by each flood (queue from its head on)
+			 */
+			vector<vector<Map::Cell*> > _queues;
+			vector<unsigned int> _heads;
+
+			/**
+			 * @var  vector<unsigned int>  size of each component (0 if the label is free)
+			 */
+			vector<unsigned int> _sizes;
+
+			/**
+			 * Relabels the cells of a component reachable from a cell.
+			 *
+			 * @param   Map::Cell*     first cell
+			 * @param   unsigned int   old label
+			 * @param   unsigned int   new label
+			 * @return  unsigned int   cells relabeled
+			 */
+			unsigned int _flood(Map::Cell* u, unsigned int from, unsigned int to);
+
+			/**
+			 * Gets the index of a cell.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int
+			 */
+			unsigned int _index(Map::Cell* u);
+
+			/**
+			 * Merges the components next to a cell that became walkable.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _join(Map::Cell* u);
+
+			/**
+			 * Gets an unused label.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int _label();
+
+			/**
+			 * Checks if a move links a cell to one of its neighbors.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   neighbor index
+			 * @return  bool
+			 */
+			bool _linked(Map::Cell* u, unsigned int k);
+
+			/**
+			 * Splits off the pieces cut off by a cell that became unwalkable.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _split(Map::Cell* u);
+
+			/**
+			 * Checks if a cell is walkable.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  bool
+			 */
+			bool _walkable(Map::Cell* u);
+	};
+};
+
+#endif // DSTARLITE_COMPONENTS_H
@@ -0,0 +1,274 @@
+/**
+ * Connectivity.
+ *
+ * Neighborhood policies, picked at compile time with DSTARLITE_CONNECTIVITY
+ * (4, 8 or 16, 8 by default).  Each one holds the neighbor offsets, the move
+ * cost multipliers and an admissible heuristic, so the planner's neighbor
+ * loops have a constant bound and look costs up by neighbor index instead of
+ * testing for diagonals.
+ *
+ * The 16-connected neighborhood adds the knight moves, which pass over two
+ * cells of the 8-neighborhood (the via cells) that must be walkable.
+ *
+ * The tables are defined here rather than in a source file, so the neighbor
+ * loops of every translation unit see them as constants.  C++98 only allows
+ * that for members of class templates, hence the unused type parameter of
+ * the specializations.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_CONNECTIVITY_H
+#define DSTARLITE_CONNECTIVITY_H
+
+#include "math.h"
+
+#ifndef DSTARLITE_CONNECTIVITY
+	#define DSTARLITE_CONNECTIVITY 8
+#endif
+
+namespace DStarLite
+{
+	template<unsigned int N, class T = void> struct Connectivity;
+
+	/**
+	 * Up, right, down, left.
+	 */
+	template<class T> struct Connectivity<4, T>
+	{
+		/**
+		 * @var  static const unsigned int  number of neighbors
+		 */
+		static const unsigned int SIZE = 4;
+
+		/**
+		 * @var  static const bool  some moves pass over via cells
+		 */
+		static const bool VIAS = false;
+
+		/**
+		 * @var  static const int  x and y offsets of each neighbor
+		 */
+		static const int DX[4];
+		static const int DY[4];
+
+		/**
+		 * @var  static const double  cost multiplier of each move
+		 */
+		static const double COST[4];
+
+		/**
+		 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+		 */
+		static const int VIA[4][2];
+
+		/**
+		 * Estimates the cost between two cells (Manhattan distance).
+		 *
+		 * @param   unsigned int   x distance
+		 * @param   unsigned int   y distance
+		 * @return  double
+		 */
+		static double h(unsigned int dx, unsigned int dy)
+		{
+			return dx + dy;
+		}
+	};
+
+	/**
+	 * Clockwise from the top left.
+	 */
+	template<class T> struct Connectivity<8, T>
+	{
+		/**
+		 * @var  static const unsigned int  number of neighbors
+		 */
+		static const unsigned int SIZE = 8;
+
+		/**
+		 * @var  static const bool  some moves pass over via cells
+		 */
+		static const bool VIAS = false;
+
+		/**
+		 * @var  static const int  x and y offsets of each neighbor
+		 */
+		static const int DX[8];
+		static const int DY[8];
+
+		/**
+		 * @var  static const double  cost multiplier of each move
+		 */
+		static const double COST[8];
+
+		/**
+		 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+		 */
+		static const int VIA[8][2];
+
+		/**
+		 * Estimates the cost between two cells (octile distance).
+		 *
+		 * @param   unsigned int   x distance
+		 * @param   unsigned int   y distance
+		 * @return  double
+		 */
+		static double h(unsigned int dx, unsigned int dy)
+		{
+			unsigned int min = dx;
+			unsigned int max = dy;
+
+			if (min > max)
+			{
+				min = dy;
+				max = dx;
+			}
+
+			return ((Math::SQRT2 - 1.0) * min + max);
+		}
+	};
+
+	/**
+	 * The 8-neighborhood, then the knight moves clockwise from the top.
+	 */
+	template<class T> struct Connectivity<16, T>
+	{
+		/**
+		 * @var  static const unsigned int  number of neighbors
+		 */
+		static const unsigned int SIZE = 16;
+
+		/**
+		 * @var  static const bool  some moves pass over via cells
+		 */
+		static const bool VIAS = true;
+
+		/**
+		 * @var  static const int  x and y offsets of each neighbor
+		 */
+		static const int DX[16];
+		static const int DY[16];
+
+		/**
+		 * @var  static const double  cost multiplier of each move
+		 */
+		static const double COST[16];
+
+		/**
+		 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+		 */
+		static const int VIA[16][2];
+
+		/**
+		 * Estimates the cost between two cells (straight line distance).
+		 *
+		 * Knight moves make the octile distance overestimate.
+		 *
+		 * @param   unsigned int   x distance
+		 * @param   unsigned int   y distance
+		 * @return  double
+		 */
+		static double h(unsigned int dx, unsigned int dy)
+		{
+			return sqrt((double) (dx * dx + dy * dy));
+		}
+	};
+
+	/**
+	 * @var  static const unsigned int  number of neighbors
+	 */
+	template<class T> const unsigned int Connectivity<4, T>::SIZE;
+
+	/**
+	 * @var  static const bool  some moves pass over via cells
+	 */
+	template<class T> const bool Connectivity<4, T>::VIAS;
+
+	/**
+	 * @var  static const int  x and y offsets of each neighbor
+	 */
+	template<class T> const int Connectivity<4, T>::DX[4] = {0, 1, 0, -1};
+	template<class T> const int Connectivity<4, T>::DY[4] = {-1, 0, 1, 0};
+
+	/**
+	 * @var  static const double  cost multiplier of each move
+	 */
+	template<class T> const double Connectivity<4, T>::COST[4] = {1.0, 1.0, 1.0, 1.0};
+
+	/**
+	 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+	 */
+	template<class T> const int Connectivity<4, T>::VIA[4][2] = {{-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}};
+
+	/**
+	 * @var  static const unsigned int  number of neighbors
+	 */
+	template<class T> const unsigned int Connectivity<8, T>::SIZE;
+
+	/**
+	 * @var  static const bool  some moves pass over via cells
+	 */
+	template<class T> const bool Connectivity<8, T>::VIAS;
+
+	/**
+	 * @var  static const int  x and y offsets of each neighbor
+	 */
+	template<class T> const int Connectivity<8, T>::DX[8] = {-1, 0, 1, 1, 1, 0, -1, -1};
+	template<class T> const int Connectivity<8, T>::DY[8] = {-1, -1, -1, 0, 1, 1, 1, 0};
+
+	/**
+	 * @var  static const double  cost multiplier of each move
+	 */
+	template<class T> const double Connectivity<8, T>::COST[8] = {
+		1.41421356237309504880, 1.0, 1.41421356237309504880, 1.0,
+		1.41421356237309504880, 1.0, 1.41421356237309504880, 1.0
+	};
+
+	/**
+	 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+	 */
+	template<class T> const int Connectivity<8, T>::VIA[8][2] = {{-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}};
+
+	/**
+	 * @var  static const unsigned int  number of neighbors
+	 */
+	template<class T> const unsigned int Connectivity<16, T>::SIZE;
+
+	/**
+	 * @var  static const bool  some moves pass over via cells
+	 */
+	template<class T> const bool Connectivity<16, T>::VIAS;
+
+	/**
+	 * @var  static const int  x and y offsets of each neighbor
+	 */
+	template<class T> const int Connectivity<16, T>::DX[16] = {-1, 0, 1, 1, 1, 0, -1, -1, 1, 2, 2, 1, -1, -2, -2, -1};
+	template<class T> const int Connectivity<16, T>::DY[16] = {-1, -1, -1, 0, 1, 1, 1, 0, -2, -1, 1, 2, 2, 1, -1, -2};
+
+	/**
+	 * @var  static const double  cost multiplier of each move
+	 */
+	template<class T> const double Connectivity<16, T>::COST[16] = {
+		1.41421356237309504880, 1.0, 1.41421356237309504880, 1.0,
+		1.41421356237309504880, 1.0, 1.41421356237309504880, 1.0,
+		2.23606797749978969641, 2.23606797749978969641, 2.23606797749978969641, 2.23606797749978969641,
+		2.23606797749978969641, 2.23606797749978969641, 2.23606797749978969641, 2.23606797749978969641
+	};
+
+	/**
+	 * @var  static const int  via cells of each move (8-neighborhood indexes, -1 if none)
+	 */
+	template<class T> const int Connectivity<16, T>::VIA[16][2] = {
+		{-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1},
+		{1, 2}, {3, 2}, {3, 4}, {5, 4}, {5, 6}, {7, 6}, {7, 0}, {1, 0}
+	};
+
+	/**
+	 * Neighborhood used by the maps and planners.
+	 */
+	typedef Connectivity<DSTARLITE_CONNECTIVITY> Neighborhood;
+};
+
+#endif // DSTARLITE_CONNECTIVITY_H
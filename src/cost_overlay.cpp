@@ -0,0 +1,159 @@
+/**
+ * Cost Overlay.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "cost_overlay.h"
+
+/**
+ * @var  unsigned int  page side (in cells, power of two)
+ */
+const unsigned int CostOverlay::PAGE_BITS = 4;
+const unsigned int CostOverlay::PAGE_SIZE = 1 << CostOverlay::PAGE_BITS;
+
+/**
+ * Constructor.
+ *
+ * @param  Map*                      base map
+ * @param  CostOverlay* [optional]   parent overlay (must not change while this overlay is used)
+ */
+CostOverlay::CostOverlay(Map* map, CostOverlay* parent)
+{
+	_map = map;
+	_parent = parent;
+	_size = 0;
+
+	unsigned int page_rows = (map->rows() + PAGE_SIZE - 1) >> PAGE_BITS;
+	_page_cols = (map->cols() + PAGE_SIZE - 1) >> PAGE_BITS;
+
+	_pages.assign(page_rows * _page_cols, (double*) NULL);
+}
+
+/**
+ * Deconstructor.
+ */
+CostOverlay::~CostOverlay()
+{
+	clear();
+}
+
+/**
+ * Drops all changes.
+ *
+ * @return  void
+ */
+void CostOverlay::clear()
+{
+	for (unsigned int i = 0; i < _pages.size(); i++)
+	{
+		if (_pages[i] != NULL)
+		{
+			delete[] _pages[i];
+			_pages[i] = NULL;
+		}
+	}
+
+	_size = 0;
+}
+
+/**
+ * Gets the cost of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double CostOverlay::cost(Map::Cell* u)
+{
+	double* page = _pages[_page(u)];
+
+	if (page == NULL)
+		return (_parent == NULL) ? u->cost : _parent->cost(u);
+
+	return page[_offset(u)];
+}
+
+/**
+ * Gets the memory used by copied pages (in bytes).
+ *
+ * @return  unsigned int
+ */
+unsigned int CostOverlay::memory()
+{
+	return _size * PAGE_SIZE * PAGE_SIZE * sizeof(double);
+}
+
+/**
+ * Gets the number of copied pages.
+ *
+ * @return  unsigned int
+ */
+unsigned int CostOverlay::pages()
+{
+	return _size;
+}
+
+/**
+ * Sets the cost of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @param   double       cost
+ * @return  void
+ */
+void CostOverlay::set(Map::Cell* u, double cost)
+{
+	unsigned int k = _page(u);
+
+	// Copy the page from the parent (or the map) on first write
+	if (_pages[k] == NULL)
+	{
+		double* page = new double[PAGE_SIZE * PAGE_SIZE];
+
+		unsigned int x0 = (u->x() >> PAGE_BITS) << PAGE_BITS;
+		unsigned int y0 = (u->y() >> PAGE_BITS) << PAGE_BITS;
+
+		for (unsigned int i = 0; i < PAGE_SIZE; i++)
+		{
+			for (unsigned int j = 0; j < PAGE_SIZE; j++)
+			{
+				if ( ! _map->has(y0 + i, x0 + j))
+				{
+					page[(i << PAGE_BITS) + j] = Map::Cell::COST_UNWALKABLE;
+					continue;
+				}
+
+				Map::Cell* v = (*_map)(y0 + i, x0 + j);
+				page[(i << PAGE_BITS) + j] = (_parent == NULL) ? v->cost : _parent->cost(v);
+			}
+		}
+
+		_pages[k] = page;
+		_size++;
+	}
+
+	_pages[k][_offset(u)] = cost;
+}
+
+/**
+ * Gets the page table slot of a cell.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int
+ */
+unsigned int CostOverlay::_page(Map::Cell* u)
+{
+	return (u->y() >> PAGE_BITS) * _page_cols + (u->x() >> PAGE_BITS);
+}
+
+/**
+ * Gets the offset of a cell within its page.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int
+ */
+unsigned int CostOverlay::_offset(Map::Cell* u)
+{
+	return ((u->y() & (PAGE_SIZE - 1)) << PAGE_BITS) + (u->x() & (PAGE_SIZE - 1));
+}
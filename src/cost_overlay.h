@@ -0,0 +1,135 @@
+/**
+ * Cost Overlay.
+ *
+ * Copy-on-write costs on top of a shared, immutable map.  The map is split
+ * into square pages; a page is copied from the map the first time one of its
+ * cells is changed, reads of untouched pages fall through to the map.  Memory
+ * grows with the changed area only, so many planners can share one map.
+ *
+ * An overlay can also sit on top of another overlay (a planner fork), reads
+ * then fall through to the parent overlay and pages are copied from it.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_COST_OVERLAY_H
+#define DSTARLITE_COST_OVERLAY_H
+
+#include <vector>
+
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class CostOverlay
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  page side (in cells, power of two)
+			 */
+			static const unsigned int PAGE_BITS;
+			static const unsigned int PAGE_SIZE;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*                      base map
+			 * @param  CostOverlay* [optional]   parent overlay (must not change while this overlay is used)
+			 */
+			CostOverlay(Map* map, CostOverlay* parent = NULL);
+
+			/**
+			 * Deconstructor.
+			 */
+			~CostOverlay();
+
+			/**
+			 * Drops all changes.
+			 *
+			 * @return  void
+			 */
+			void clear();
+
+			/**
+			 * Gets the cost of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the memory used by copied pages (in bytes).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int memory();
+
+			/**
+			 * Gets the number of copied pages.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int pages();
+
+			/**
+			 * Sets the cost of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   double       cost
+			 * @return  void
+			 */
+			void set(Map::Cell* u, double cost);
+
+		protected:
+
+			/**
+			 * @var  Map*  base map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  CostOverlay*  parent overlay (NULL if on top of the map)
+			 */
+			CostOverlay* _parent;
+
+			/**
+			 * @var  vector<double*>  page table (NULL for untouched pages)
+			 */
+			vector<double*> _pages;
+
+			/**
+			 * @var  unsigned int  page table columns
+			 */
+			unsigned int _page_cols;
+
+			/**
+			 * @var  unsigned int  copied pages
+			 */
+			unsigned int _size;
+
+			/**
+			 * Gets the page table slot of a cell.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int
+			 */
+			unsigned int _page(Map::Cell* u);
+
+			/**
+			 * Gets the offset of a cell within its page.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int
+			 */
+			unsigned int _offset(Map::Cell* u);
+	};
+};
+
+#endif // DSTARLITE_COST_OVERLAY_H
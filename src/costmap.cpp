@@ -0,0 +1,148 @@
+/**
+ * Costmap.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "costmap.h"
+
+/**
+ * Constructor, no layers.
+ *
+ * @param  Map*   map
+ */
+Costmap::Costmap(Map* map)
+{
+	_map = map;
+
+	unsigned int size = map->rows() * map->cols();
+
+	_costs.assign(size, Map::Cell::COST_UNWALKABLE);
+	_marked.assign(size, 0);
+}
+
+/**
+ * Deconstructor, deletes the layers.
+ */
+Costmap::~Costmap()
+{
+	for (unsigned int i = 0; i < _layers.size(); i++)
+	{
+		delete _layers[i];
+	}
+}
+
+/**
+ * Adds a layer on top (the costmap takes ownership).
+ *
+ * @param   BaseLayer*   layer
+ * @return  BaseLayer*
+ */
+BaseLayer* Costmap::add(BaseLayer* layer)
+{
+	_layers.push_back(layer);
+
+	return layer;
+}
+
+/**
+ * Recomposes every cell and writes the composite costs into the map.
+ *
+ * @return  void
+ */
+void Costmap::compose()
+{
+	for (unsigned int i = 0; i < _layers.size(); i++)
+	{
+		_layers[i]->reset(this);
+	}
+
+	unsigned int rows = _map->rows();
+	unsigned int cols = _map->cols();
+
+	for (unsigned int i = 0; i < rows; i++)
+	{
+		for (unsigned int j = 0; j < cols; j++)
+		{
+			Map::Cell* u = (*_map)(i, j);
+			u->cost = _costs[i * cols + j] = cost(u, NULL);
+		}
+	}
+}
+
+/**
+ * Gets the composite cost of a cell (as of the last update).
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double Costmap::cost(Map::Cell* u)
+{
+	return _costs[u->y() * _map->cols() + u->x()];
+}
+
+/**
+ * Gets the cost of a cell composed from the layers below a layer.
+ *
+ * @param   Map::Cell*   cell
+ * @param   BaseLayer*   layer (NULL for all layers)
+ * @return  double
+ */
+double Costmap::cost(Map::Cell* u, BaseLayer* layer)
+{
+	double cost = Map::Cell::COST_UNWALKABLE;
+
+	for (unsigned int i = 0; i < _layers.size() && _layers[i] != layer; i++)
+	{
+		cost = _layers[i]->cost(u, cost);
+	}
+
+	return cost;
+}
+
+/**
+ * Recomposes the cells changed by any layer.
+ *
+ * Layers are updated bottom first, so a layer sees the cells changed below it.
+ *
+ * @param   vector<Map::Cell*>&   cells whose composite cost changed (appended)
+ * @param   vector<double>&       their new costs (appended)
+ * @return  void
+ */
+void Costmap::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < _layers.size(); i++)
+	{
+		_layers[i]->update(this, _dirty);
+	}
+
+	unsigned int cols = _map->cols();
+
+	for (vector<Map::Cell*>::iterator it = _dirty.begin(); it != _dirty.end(); it++)
+	{
+		unsigned int k = (*it)->y() * cols + (*it)->x();
+
+		if (_marked[k])
+			continue;
+
+		_marked[k] = 1;
+
+		double v = cost(*it, NULL);
+
+		if (v != _costs[k])
+		{
+			_costs[k] = v;
+			cells.push_back(*it);
+			costs.push_back(v);
+		}
+	}
+
+	for (vector<Map::Cell*>::iterator it = _dirty.begin(); it != _dirty.end(); it++)
+	{
+		_marked[(*it)->y() * cols + (*it)->x()] = 0;
+	}
+
+	_dirty.clear();
+}
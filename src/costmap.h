@@ -0,0 +1,113 @@
+/**
+ * Costmap.
+ *
+ * A stack of layers (prior map, sensor data, inflation, keep out zones...)
+ * composed into one cost per cell.  Each layer tracks the cells it changed,
+ * an update only recomposes those cells and reports the ones whose composite
+ * cost changed, ready to be handed to the planner as one batch.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_COSTMAP_H
+#define DSTARLITE_COSTMAP_H
+
+#include <vector>
+
+#include "layers/layer_base.h"
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class Costmap
+	{
+		public:
+
+			/**
+			 * Constructor, no layers.
+			 *
+			 * @param  Map*   map
+			 */
+			Costmap(Map* map);
+
+			/**
+			 * Deconstructor, deletes the layers.
+			 */
+			~Costmap();
+
+			/**
+			 * Adds a layer on top (the costmap takes ownership).
+			 *
+			 * @param   BaseLayer*   layer
+			 * @return  BaseLayer*
+			 */
+			BaseLayer* add(BaseLayer* layer);
+
+			/**
+			 * Recomposes every cell and writes the composite costs into the map.
+			 *
+			 * @return  void
+			 */
+			void compose();
+
+			/**
+			 * Gets the composite cost of a cell (as of the last update).
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the cost of a cell composed from the layers below a layer.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   BaseLayer*   layer (NULL for all layers)
+			 * @return  double
+			 */
+			double cost(Map::Cell* u, BaseLayer* layer);
+
+			/**
+			 * Recomposes the cells changed by any layer.
+			 *
+			 * @param   vector<Map::Cell*>&   cells whose composite cost changed (appended)
+			 * @param   vector<double>&       their new costs (appended)
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  vector<double>  composite costs
+			 */
+			vector<double> _costs;
+
+			/**
+			 * @var  vector<Map::Cell*>  cells changed during the current update
+			 */
+			vector<Map::Cell*> _dirty;
+
+			/**
+			 * @var  vector<BaseLayer*>  layers, bottom first
+			 */
+			vector<BaseLayer*> _layers;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  vector<unsigned char>  cell already recomposed during the current update
+			 */
+			vector<unsigned char> _marked;
+	};
+};
+
+#endif // DSTARLITE_COSTMAP_H
@@ -0,0 +1,246 @@
+/**
+ * CSR Graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "csr_graph.h"
+
+/**
+ * @var  static const double  least edge cost
+ */
+const double CsrGraph::MIN_COST = 0.000001;
+
+/**
+ * @var  static const unsigned int  missing edge
+ */
+const unsigned int CsrGraph::NONE = (unsigned int) -1;
+
+/**
+ * Constructor.
+ *
+ * Counting sort by source, then each row is sorted by target.
+ *
+ * @param  unsigned int     number of vertices
+ * @param  vector<Edge>&    edges
+ */
+CsrGraph::CsrGraph(unsigned int vertices, const vector<Edge>& edges)
+{
+	_scale = 0.0;
+
+	unsigned int m = edges.size();
+
+	_out.assign(vertices + 1, 0);
+	_in.assign(vertices + 1, 0);
+
+	for (unsigned int i = 0; i < m; i++)
+	{
+		_out[edges[i].from + 1]++;
+		_in[edges[i].to + 1]++;
+	}
+
+	for (unsigned int u = 0; u < vertices; u++)
+	{
+		_out[u + 1] += _out[u];
+		_in[u + 1] += _in[u];
+	}
+
+	// Rows by source
+	vector<pair<Vertex, double> > row(m);
+	vector<unsigned int> next(_out.begin(), _out.end() - 1);
+
+	for (unsigned int i = 0; i < m; i++)
+	{
+		row[next[edges[i].from]++] = pair<Vertex, double>(edges[i].to, edges[i].cost);
+	}
+
+	_sources.resize(m);
+	_targets.resize(m);
+	_weights.resize(m);
+
+	for (unsigned int u = 0; u < vertices; u++)
+	{
+		// Stable, the first of parallel edges stays first
+		stable_sort(row.begin() + _out[u], row.begin() + _out[u + 1]);
+
+		for (unsigned int e = _out[u]; e < _out[u + 1]; e++)
+		{
+			_sources[e] = u;
+			_targets[e] = row[e].first;
+			_weights[e] = max(row[e].second, MIN_COST);
+		}
+	}
+
+	// Incoming slots, in edge order
+	_incoming.resize(m);
+	next.assign(_in.begin(), _in.end() - 1);
+
+	for (unsigned int e = 0; e < m; e++)
+	{
+		_incoming[next[_targets[e]]++] = e;
+	}
+}
+
+/**
+ * Gets the cost of an edge.
+ *
+ * @param   unsigned int   edge index
+ * @return  double
+ */
+double CsrGraph::cost(unsigned int e)
+{
+	return _weights[e];
+}
+
+/**
+ * Sets the cost of an edge.
+ *
+ * @param   unsigned int   edge index
+ * @param   double         cost (Math::INF if blocked, at least MIN_COST)
+ * @return  void
+ */
+void CsrGraph::cost(unsigned int e, double cost)
+{
+	_weights[e] = max(cost, MIN_COST);
+}
+
+/**
+ * Finds an edge.
+ *
+ * @param   Vertex         from
+ * @param   Vertex         to
+ * @return  unsigned int   edge index (NONE if there is none)
+ */
+unsigned int CsrGraph::edge(Vertex u, Vertex v)
+{
+	vector<Vertex>::iterator begin = _targets.begin() + _out[u];
+	vector<Vertex>::iterator end = _targets.begin() + _out[u + 1];
+	vector<Vertex>::iterator it = lower_bound(begin, end, v);
+
+	if (it == end || *it != v)
+		return NONE;
+
+	return it - _targets.begin();
+}
+
+/**
+ * Gets the number of edges.
+ *
+ * @return  unsigned int
+ */
+unsigned int CsrGraph::edges()
+{
+	return _targets.size();
+}
+
+/**
+ * Estimates the cost between two vertices.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double CsrGraph::h(const Vertex& a, const Vertex& b)
+{
+	if (_scale == 0.0)
+		return 0.0;
+
+	double dx = _xy[a].first - _xy[b].first;
+	double dy = _xy[a].second - _xy[b].second;
+
+	return _scale * sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Sets vertex positions for the heuristic.
+ *
+ * Call before planning, the heuristic may not change under a planner.
+ *
+ * @param   vector<pair<double,double>>&   x and y of each vertex
+ * @param   double                         least cost per unit of distance
+ * @return  void
+ */
+void CsrGraph::positions(const vector<pair<double,double> >& xy, double scale)
+{
+	_xy = xy;
+	_scale = scale;
+}
+
+/**
+ * Gets the predecessors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   predecessors and edge costs (appended)
+ * @return  void
+ */
+void CsrGraph::pred(const Vertex& u, Edges& edges)
+{
+	for (unsigned int i = _in[u]; i < _in[u + 1]; i++)
+	{
+		unsigned int e = _incoming[i];
+
+		edges.push_back(pair<Vertex, double>(_sources[e], _weights[e]));
+	}
+}
+
+/**
+ * Gets the source of an edge.
+ *
+ * @param   unsigned int   edge index
+ * @return  Vertex
+ */
+CsrGraph::Vertex CsrGraph::source(unsigned int e)
+{
+	return _sources[e];
+}
+
+/**
+ * Gets the successors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   successors and edge costs (appended)
+ * @return  void
+ */
+void CsrGraph::succ(const Vertex& u, Edges& edges)
+{
+	for (unsigned int e = _out[u]; e < _out[u + 1]; e++)
+	{
+		edges.push_back(pair<Vertex, double>(_targets[e], _weights[e]));
+	}
+}
+
+/**
+ * Gets the target of an edge.
+ *
+ * @param   unsigned int   edge index
+ * @return  Vertex
+ */
+CsrGraph::Vertex CsrGraph::target(unsigned int e)
+{
+	return _targets[e];
+}
+
+/**
+ * Gets the number of vertices.
+ *
+ * @return  unsigned int
+ */
+unsigned int CsrGraph::vertices()
+{
+	return _out.size() - 1;
+}
+
+/**
+ * Hashes a vertex.
+ *
+ * @param   Vertex   vertex
+ * @return  size_t
+ */
+size_t CsrGraph::Hash::operator()(const Vertex& u) const
+{
+	return (size_t) u * 19349663;
+}
@@ -0,0 +1,219 @@
+/**
+ * CSR Graph.
+ *
+ * Directed graph in compressed sparse row form for the D* Lite engine, for
+ * road networks, navmeshes and anything else that is not a grid.  Vertices
+ * are numbered from zero.  The outgoing edges of each vertex sit next to
+ * each other sorted by target, and a second index lists the incoming edges
+ * of each vertex, so both directions are a walk over a contiguous range.
+ *
+ * The shape is fixed once built, edge costs may change (Math::INF blocks an
+ * edge).  Costs below MIN_COST are raised to it: the engine needs positive
+ * costs, a zero cost cycle (say between two vertices at the same position)
+ * would tie with the way out of it.  Without positions the heuristic is zero; with positions it is the
+ * straight line distance times a scale, which must not be more than the
+ * cost per unit of distance of any edge, now or after an update.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_CSR_GRAPH_H
+#define DSTARLITE_CSR_GRAPH_H
+
+#include <vector>
+
+#include "math.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class CsrGraph
+	{
+		public:
+
+			typedef unsigned int Vertex;
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * Edge as given to the constructor.
+			 */
+			struct Edge
+			{
+				Vertex from;
+				Vertex to;
+				double cost;
+
+				Edge(Vertex from, Vertex to, double cost) : from(from), to(to), cost(cost) {}
+			};
+
+			/**
+			 * Vertex hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const Vertex& u) const;
+			};
+
+			/**
+			 * @var  static const double  least edge cost
+			 */
+			static const double MIN_COST;
+
+			/**
+			 * @var  static const unsigned int  missing edge
+			 */
+			static const unsigned int NONE;
+
+			/**
+			 * Constructor.
+			 *
+			 * Parallel edges and self-loops are kept, lookups find the first one.
+			 *
+			 * @param  unsigned int     number of vertices
+			 * @param  vector<Edge>&    edges
+			 */
+			CsrGraph(unsigned int vertices, const vector<Edge>& edges);
+
+			/**
+			 * Gets the cost of an edge.
+			 *
+			 * @param   unsigned int   edge index
+			 * @return  double
+			 */
+			double cost(unsigned int e);
+
+			/**
+			 * Sets the cost of an edge.
+			 *
+			 * The engine must be told about the source of the edge after.
+			 *
+			 * @param   unsigned int   edge index
+			 * @param   double         cost (Math::INF if blocked, at least MIN_COST)
+			 * @return  void
+			 */
+			void cost(unsigned int e, double cost);
+
+			/**
+			 * Finds an edge.
+			 *
+			 * @param   Vertex         from
+			 * @param   Vertex         to
+			 * @return  unsigned int   edge index (NONE if there is none)
+			 */
+			unsigned int edge(Vertex u, Vertex v);
+
+			/**
+			 * Gets the number of edges.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int edges();
+
+			/**
+			 * Estimates the cost between two vertices.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Sets vertex positions for the heuristic.
+			 *
+			 * @param   vector<pair<double,double>>&   x and y of each vertex
+			 * @param   double                         least cost per unit of distance
+			 * @return  void
+			 */
+			void positions(const vector<pair<double,double> >& xy, double scale);
+
+			/**
+			 * Gets the predecessors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   predecessors and edge costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Gets the source of an edge.
+			 *
+			 * @param   unsigned int   edge index
+			 * @return  Vertex
+			 */
+			Vertex source(unsigned int e);
+
+			/**
+			 * Gets the successors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   successors and edge costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+			/**
+			 * Gets the target of an edge.
+			 *
+			 * @param   unsigned int   edge index
+			 * @return  Vertex
+			 */
+			Vertex target(unsigned int e);
+
+			/**
+			 * Gets the number of vertices.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int vertices();
+
+		protected:
+
+			/**
+			 * @var  vector<unsigned int>  first incoming slot of each vertex (one past the end last)
+			 */
+			vector<unsigned int> _in;
+
+			/**
+			 * @var  vector<unsigned int>  edge index of each incoming slot
+			 */
+			vector<unsigned int> _incoming;
+
+			/**
+			 * @var  vector<unsigned int>  first outgoing edge of each vertex (one past the end last)
+			 */
+			vector<unsigned int> _out;
+
+			/**
+			 * @var  double  least cost per unit of distance (0 without positions)
+			 */
+			double _scale;
+
+			/**
+			 * @var  vector<Vertex>  source of each edge
+			 */
+			vector<Vertex> _sources;
+
+			/**
+			 * @var  vector<Vertex>  target of each edge
+			 */
+			vector<Vertex> _targets;
+
+			/**
+			 * @var  vector<double>  cost of each edge
+			 */
+			vector<double> _weights;
+
+			/**
+			 * @var  vector<pair<double,double>>  position of each vertex
+			 */
+			vector<pair<double,double> > _xy;
+	};
+};
+
+#endif // DSTARLITE_CSR_GRAPH_H
@@ -0,0 +1,143 @@
+/**
+ * CSR Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "csr_planner.h"
+
+/**
+ * Constructor.
+ *
+ * The graph is written by update, it must outlive the planner.
+ *
+ * @param  CsrGraph*           graph
+ * @param  CsrGraph::Vertex    start vertex
+ * @param  CsrGraph::Vertex    goal vertex
+ */
+CsrPlanner::CsrPlanner(CsrGraph* graph, CsrGraph::Vertex start, CsrGraph::Vertex goal)
+{
+	_graph = graph;
+
+	// Allow every vertex to be expanded twice on large graphs
+	unsigned int limit = 2 * graph->vertices();
+
+	if (limit < Engine<CsrGraph>::MAX_STEPS)
+	{
+		limit = Engine<CsrGraph>::MAX_STEPS;
+	}
+
+	_engine = new Engine<CsrGraph>(_graph, start, goal, limit);
+}
+
+/**
+ * Deconstructor.
+ */
+CsrPlanner::~CsrPlanner()
+{
+	delete _engine;
+}
+
+/**
+ * Gets the number of vertices expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int CsrPlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the graph.
+ *
+ * @return  CsrGraph*
+ */
+CsrGraph* CsrPlanner::graph()
+{
+	return _graph;
+}
+
+/**
+ * Gets the path from the last replan.
+ *
+ * @return  list<CsrGraph::Vertex>&
+ */
+const list<CsrGraph::Vertex>& CsrPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool CsrPlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  CsrGraph::Vertex
+ */
+CsrGraph::Vertex CsrPlanner::start()
+{
+	return _engine->start();
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   CsrGraph::Vertex   new start
+ * @return  void
+ */
+void CsrPlanner::start(CsrGraph::Vertex u)
+{
+	_engine->start(u);
+}
+
+/**
+ * Update an edge.
+ *
+ * @param   unsigned int   edge index
+ * @param   double         new cost of the edge (Math::INF if blocked)
+ * @return  void
+ */
+void CsrPlanner::update(unsigned int e, double cost)
+{
+	if (_graph->cost(e) == cost)
+		return;
+
+	_graph->cost(e, cost);
+
+	// Only the source's outgoing edges changed
+	_engine->update(_graph->source(e));
+}
+
+/**
+ * Update edges, batch.
+ *
+ * @param   vector<unsigned int>&   edge indices
+ * @param   vector<double>&         new costs of the edges
+ * @return  void
+ */
+void CsrPlanner::update(vector<unsigned int>& edges, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < edges.size(); i++)
+	{
+		update(edges[i], costs[i]);
+	}
+}
@@ -0,0 +1,126 @@
+/**
+ * CSR Planner.
+ *
+ * D* Lite over a CSR graph, with an edge cost update API in the style of
+ * the grid planner.  A changed edge repairs its source vertex only.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_CSR_PLANNER_H
+#define DSTARLITE_CSR_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "csr_graph.h"
+#include "engine.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class CsrPlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * The graph is written by update, it must outlive the planner.
+			 *
+			 * @param  CsrGraph*           graph
+			 * @param  CsrGraph::Vertex    start vertex
+			 * @param  CsrGraph::Vertex    goal vertex
+			 */
+			CsrPlanner(CsrGraph* graph, CsrGraph::Vertex start, CsrGraph::Vertex goal);
+
+			/**
+			 * Deconstructor.
+			 */
+			~CsrPlanner();
+
+			/**
+			 * Gets the number of vertices expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the graph.
+			 *
+			 * @return  CsrGraph*
+			 */
+			CsrGraph* graph();
+
+			/**
+			 * Gets the path from the last replan.
+			 *
+			 * @return  list<CsrGraph::Vertex>&
+			 */
+			const list<CsrGraph::Vertex>& path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  CsrGraph::Vertex
+			 */
+			CsrGraph::Vertex start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   CsrGraph::Vertex   new start
+			 * @return  void
+			 */
+			void start(CsrGraph::Vertex u);
+
+			/**
+			 * Update an edge.
+			 *
+			 * @param   unsigned int   edge index
+			 * @param   double         new cost of the edge (Math::INF if blocked)
+			 * @return  void
+			 */
+			void update(unsigned int e, double cost);
+
+			/**
+			 * Update edges, batch.
+			 *
+			 * @param   vector<unsigned int>&   edge indices
+			 * @param   vector<double>&         new costs of the edges
+			 * @return  void
+			 */
+			void update(vector<unsigned int>& edges, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  Engine<CsrGraph>*  D* Lite engine
+			 */
+			Engine<CsrGraph>* _engine;
+
+			/**
+			 * @var  CsrGraph*  graph
+			 */
+			CsrGraph* _graph;
+
+			/**
+			 * @var  list<CsrGraph::Vertex>  path
+			 */
+			list<CsrGraph::Vertex> _path;
+	};
+};
+
+#endif // DSTARLITE_CSR_PLANNER_H
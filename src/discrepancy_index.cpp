@@ -0,0 +1,274 @@
+/**
+ * Discrepancy Index.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "discrepancy_index.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define DSTARLITE_SSE2
+	#include <emmintrin.h>
+#endif
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  unsigned int  default bucket size (in cells)
+ */
+const unsigned int DiscrepancyIndex::BUCKET_SIZE = 16;
+
+/**
+ * Constructor, diffs the two maps.
+ *
+ * @param  unsigned char*           robot map data
+ * @param  unsigned char*           real map data
+ * @param  unsigned int             rows
+ * @param  unsigned int             columns
+ * @param  unsigned int [optional]  bucket size (in cells)
+ */
+DiscrepancyIndex::DiscrepancyIndex(unsigned char* a, unsigned char* b, unsigned int rows, unsigned int cols, unsigned int bucket_size)
+{
+	_bucket_size = bucket_size;
+	_bucket_rows = (rows + bucket_size - 1) / bucket_size;
+	_bucket_cols = (cols + bucket_size - 1) / bucket_size;
+	_buckets = new vector<unsigned int>[_bucket_rows * _bucket_cols];
+	_cols = cols;
+	_size = 0;
+
+	unsigned int n = rows * cols;
+	unsigned int k = 0;
+
+#ifdef DSTARLITE_SSE2
+	// Compare 16 cells at a time, only differing lanes are visited
+	for (; k + 16 <= n; k += 16)
+	{
+		__m128i va = _mm_loadu_si128((const __m128i*) (a + k));
+		__m128i vb = _mm_loadu_si128((const __m128i*) (b + k));
+		unsigned int mask = ~((unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) & 0xFFFF;
+
+		while (mask != 0)
+		{
+			unsigned int bit = 0;
+			while ( ! (mask & (1u << bit)))
+			{
+				bit++;
+			}
+
+			_insert(k + bit);
+			mask &= mask - 1;
+		}
+	}
+#endif
+
+	for (; k < n; k++)
+	{
+		if (a[k] != b[k])
+		{
+			_insert(k);
+		}
+	}
+}
+
+/**
+ * Deconstructor.
+ */
+DiscrepancyIndex::~DiscrepancyIndex()
+{
+	delete[] _buckets;
+}
+
+/**
+ * Adds a single discrepancy (if not indexed yet).
+ *
+ * @param   unsigned int   cell index (row * cols + col)
+ * @return  bool           added
+ */
+bool DiscrepancyIndex::add(unsigned int k)
+{
+	vector<unsigned int>* bucket = _bucket(k);
+
+	for (unsigned int i = 0; i < bucket->size(); i++)
+	{
+		if ((*bucket)[i] == k)
+			return false;
+	}
+
+	_insert(k);
+
+	return true;
+}
+
+/**
+ * Checks if any discrepancy lies within a circle.
+ *
+ * @param   unsigned int   x-coordinate
+ * @param   unsigned int   y-coordinate
+ * @param   unsigned int   radius
+ * @return  bool
+ */
+bool DiscrepancyIndex::any(unsigned int x, unsigned int y, unsigned int radius)
+{
+	return _query(x, y, radius, NULL) > 0;
+}
+
+/**
+ * Removes a single discrepancy (if indexed).
+ *
+ * @param   unsigned int   cell index (row * cols + col)
+ * @return  bool           removed
+ */
+bool DiscrepancyIndex::remove(unsigned int k)
+{
+	vector<unsigned int>* bucket = _bucket(k);
+
+	for (unsigned int i = 0; i < bucket->size(); i++)
+	{
+		if ((*bucket)[i] == k)
+		{
+			(*bucket)[i] = bucket->back();
+			bucket->pop_back();
+			_size--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Gets the number of discrepancies left.
+ *
+ * @return  unsigned int
+ */
+unsigned int DiscrepancyIndex::size()
+{
+	return _size;
+}
+
+/**
+ * Removes and returns all discrepancies within a circle.
+ *
+ * @param   unsigned int            x-coordinate
+ * @param   unsigned int            y-coordinate
+ * @param   unsigned int            radius
+ * @param   vector<unsigned int>&   found cell indices (row * cols + col)
+ * @return  unsigned int            number found
+ */
+unsigned int DiscrepancyIndex::take(unsigned int x, unsigned int y, unsigned int radius, vector<unsigned int>& found)
+{
+	return _query(x, y, radius, &found);
+}
+
+/**
+ * Gets the bucket of a cell.
+ *
+ * @param   unsigned int            cell index
+ * @return  vector<unsigned int>*
+ */
+vector<unsigned int>* DiscrepancyIndex::_bucket(unsigned int k)
+{
+	unsigned int row = k / _cols;
+	unsigned int col = k % _cols;
+
+	return &_buckets[(row / _bucket_size) * _bucket_cols + (col / _bucket_size)];
+}
+
+/**
+ * Inserts a discrepancy.
+ *
+ * @param   unsigned int   cell index
+ * @return  void
+ */
+void DiscrepancyIndex::_insert(unsigned int k)
+{
+	_bucket(k)->push_back(k);
+	_size++;
+}
+
+/**
+ * Visits the buckets intersecting a circle.
+ *
+ * @param   unsigned int             x-coordinate
+ * @param   unsigned int             y-coordinate
+ * @param   unsigned int             radius
+ * @param   vector<unsigned int>*    found cell indices (NULL to stop at the first one)
+ * @return  unsigned int             number found
+ */
+unsigned int DiscrepancyIndex::_query(unsigned int x, unsigned int y, unsigned int radius, vector<unsigned int>* found)
+{
+	if (_size == 0)
+		return 0;
+
+	long r2 = (long) radius * radius;
+
+	// Bucket range of the box around the circle
+	unsigned int min_bx = ((x > radius) ? x - radius : 0) / _bucket_size;
+	unsigned int min_by = ((y > radius) ? y - radius : 0) / _bucket_size;
+	unsigned int max_bx = (x + radius) / _bucket_size;
+	unsigned int max_by = (y + radius) / _bucket_size;
+
+	if (max_bx >= _bucket_cols)
+	{
+		max_bx = _bucket_cols - 1;
+	}
+
+	if (max_by >= _bucket_rows)
+	{
+		max_by = _bucket_rows - 1;
+	}
+
+	unsigned int count = 0;
+
+	for (unsigned int by = min_by; by <= max_by; by++)
+	{
+		for (unsigned int bx = min_bx; bx <= max_bx; bx++)
+		{
+			vector<unsigned int>* bucket = &_buckets[by * _bucket_cols + bx];
+
+			if (bucket->empty())
+				continue;
+
+			// Closest point of the bucket to the center
+			long cx = x;
+			long cy = y;
+			long x0 = bx * _bucket_size, x1 = x0 + _bucket_size - 1;
+			long y0 = by * _bucket_size, y1 = y0 + _bucket_size - 1;
+			long nx = (cx < x0) ? x0 : ((cx > x1) ? x1 : cx);
+			long ny = (cy < y0) ? y0 : ((cy > y1) ? y1 : cy);
+
+			if ((nx - cx) * (nx - cx) + (ny - cy) * (ny - cy) >= r2)
+				continue;
+
+			for (unsigned int i = 0; i < bucket->size(); )
+			{
+				unsigned int k = (*bucket)[i];
+				long dx = (long) (k % _cols) - cx;
+				long dy = (long) (k / _cols) - cy;
+
+				if (dx * dx + dy * dy >= r2)
+				{
+					i++;
+					continue;
+				}
+
+				count++;
+
+				if (found == NULL)
+					return count;
+
+				found->push_back(k);
+
+				// Resolved, swap remove
+				(*bucket)[i] = bucket->back();
+				bucket->pop_back();
+				_size--;
+			}
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,149 @@
+/**
+ * Discrepancy Index.
+ *
+ * In simulation the only cells that can ever produce an update are the ones
+ * where the robot's map differs from the real map.  That set is fixed when the
+ * maps are loaded, so it is computed once and bucketed spatially; a scan only
+ * has to visit the buckets that intersect the scan circle.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_DISCREPANCY_INDEX_H
+#define DSTARLITE_DISCREPANCY_INDEX_H
+
+#include <vector>
+
+using namespace std;
+
+namespace DStarLite
+{
+	class DiscrepancyIndex
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  default bucket size (in cells)
+			 */
+			static const unsigned int BUCKET_SIZE;
+
+			/**
+			 * Constructor, diffs the two maps.
+			 *
+			 * @param  unsigned char*           robot map data
+			 * @param  unsigned char*           real map data
+			 * @param  unsigned int             rows
+			 * @param  unsigned int             columns
+			 * @param  unsigned int [optional]  bucket size (in cells)
+			 */
+			DiscrepancyIndex(unsigned char* a, unsigned char* b, unsigned int rows, unsigned int cols, unsigned int bucket_size = BUCKET_SIZE);
+
+			/**
+			 * Deconstructor.
+			 */
+			~DiscrepancyIndex();
+
+			/**
+			 * Adds a single discrepancy (if not indexed yet).
+			 *
+			 * @param   unsigned int   cell index (row * cols + col)
+			 * @return  bool           added
+			 */
+			bool add(unsigned int k);
+
+			/**
+			 * Checks if any discrepancy lies within a circle.
+			 *
+			 * @param   unsigned int   x-coordinate
+			 * @param   unsigned int   y-coordinate
+			 * @param   unsigned int   radius
+			 * @return  bool
+			 */
+			bool any(unsigned int x, unsigned int y, unsigned int radius);
+
+			/**
+			 * Removes a single discrepancy (if indexed).
+			 *
+			 * @param   unsigned int   cell index (row * cols + col)
+			 * @return  bool           removed
+			 */
+			bool remove(unsigned int k);
+
+			/**
+			 * Gets the number of discrepancies left.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+			/**
+			 * Removes and returns all discrepancies within a circle.
+			 *
+			 * @param   unsigned int            x-coordinate
+			 * @param   unsigned int            y-coordinate
+			 * @param   unsigned int            radius
+			 * @param   vector<unsigned int>&   found cell indices (row * cols + col)
+			 * @return  unsigned int            number found
+			 */
+			unsigned int take(unsigned int x, unsigned int y, unsigned int radius, vector<unsigned int>& found);
+
+		protected:
+
+			/**
+			 * @var  unsigned int  bucket size (in cells)
+			 */
+			unsigned int _bucket_size;
+
+			/**
+			 * @var  vector<unsigned int>*  buckets of cell indices
+			 */
+			vector<unsigned int>* _buckets;
+
+			/**
+			 * @var  unsigned int  bucket rows and columns
+			 */
+			unsigned int _bucket_rows;
+			unsigned int _bucket_cols;
+
+			/**
+			 * @var  unsigned int  map columns
+			 */
+			unsigned int _cols;
+
+			/**
+			 * @var  unsigned int  discrepancies left
+			 */
+			unsigned int _size;
+
+			/**
+			 * Gets the bucket of a cell.
+			 *
+			 * @param   unsigned int            cell index
+			 * @return  vector<unsigned int>*
+			 */
+			vector<unsigned int>* _bucket(unsigned int k);
+
+			/**
+			 * Inserts a discrepancy.
+			 *
+			 * @param   unsigned int   cell index
+			 * @return  void
+			 */
+			void _insert(unsigned int k);
+
+			/**
+			 * Visits the buckets intersecting a circle.
+			 *
+			 * @param   unsigned int             x-coordinate
+			 * @param   unsigned int             y-coordinate
+			 * @param   unsigned int             radius
+			 * @param   vector<unsigned int>*    found cell indices (NULL to stop at the first one)
+			 * @return  unsigned int             number found
+			 */
+			unsigned int _query(unsigned int x, unsigned int y, unsigned int radius, vector<unsigned int>* found);
+	};
+};
+
+#endif // DSTARLITE_DISCREPANCY_INDEX_H
@@ -0,0 +1,265 @@
+/**
+ * Distance Map.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <climits>
+
+#include "distance_map.h"
+#include "math.h"
+
+/**
+ * @var  static const int  no obstacle
+ */
+const int DistanceMap::NONE = -1;
+
+/**
+ * Constructor, no obstacles.
+ *
+ * @param  Map*   map
+ * @param  int    [optional]   maximum squared distance kept (farther cells have no obstacle)
+ */
+DistanceMap::DistanceMap(Map* map, int range)
+{
+	_map = map;
+	_range = range;
+
+	unsigned int size = map->rows() * map->cols();
+
+	_dist.assign(size, INT_MAX);
+	_dirty.assign(size, 0);
+	_obst.assign(size, NONE);
+	_occ.assign(size, 0);
+	_raise.assign(size, 0);
+}
+
+/**
+ * Deconstructor.
+ */
+DistanceMap::~DistanceMap()
+{
+
+}
+
+/**
+ * Gets the distance to the closest obstacle (in cells).
+ *
+ * @param   Map::Cell*   cell
+ * @return  double       distance (Math::INF if there are no obstacles within range)
+ */
+double DistanceMap::distance(Map::Cell* u)
+{
+	int dist = _dist[u->y() * _map->cols() + u->x()];
+
+	if (dist == INT_MAX)
+		return Math::INF;
+
+	return sqrt((double) dist);
+}
+
+/**
+ * Checks if a cell is an obstacle.
+ *
+ * @param   Map::Cell*   cell
+ * @return  bool
+ */
+bool DistanceMap::obstacle(Map::Cell* u)
+{
+	return _occ[u->y() * _map->cols() + u->x()] != 0;
+}
+
+/**
+ * Marks or clears an obstacle, distances are updated on the next update().
+ *
+ * @param   Map::Cell*   cell
+ * @param   bool         obstacle
+ * @return  void
+ */
+void DistanceMap::set(Map::Cell* u, bool obstacle)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	if ((_occ[k] != 0) == obstacle)
+		return;
+
+	_occ[k] = obstacle;
+
+	if (obstacle)
+	{
+		_raise[k] = 0;
+		_assign(k, 0, k);
+	}
+	else
+	{
+		_raise[k] = 1;
+		_assign(k, INT_MAX, NONE);
+	}
+
+	_open.push(Q_PAIR(0, k));
+}
+
+/**
+ * Propagates all pending changes.
+ *
+ * @param   vector<Map::Cell*>&   cells whose distance changed within range (appended)
+ * @param   vector<double>&       their distances before the update (appended)
+ * @return  void
+ */
+void DistanceMap::update(vector<Map::Cell*>& changed, vector<double>& before)
+{
+	unsigned int cols = _map->cols();
+
+	while ( ! _open.empty())
+	{
+		unsigned int k = _open.top().second;
+		_open.pop();
+
+		if (_raise[k])
+		{
+			_raise_wave(k);
+		}
+		else if (_obst[k] != NONE && _occ[_obst[k]])
+		{
+			_lower(k);
+		}
+	}
+
+	for (unsigned int i = 0; i < _touched.size(); i++)
+	{
+		unsigned int k = _touched[i];
+		_dirty[k] = 0;
+
+		// Cleared by a raise wave and lowered back to the same distance
+		if (_dist[k] == _before[i])
+			continue;
+
+		changed.push_back((*_map)(k / cols, k % cols));
+		before.push_back((_before[i] == INT_MAX) ? Math::INF : sqrt((double) _before[i]));
+	}
+
+	_before.clear();
+	_touched.clear();
+}
+
+/**
+ * Records a distance change.
+ *
+ * @param   unsigned int   cell index
+ * @param   int            squared distance
+ * @param   int            closest obstacle
+ * @return  void
+ */
+void DistanceMap::_assign(unsigned int k, int dist, int obst)
+{
+	_obst[k] = obst;
+
+	if (_dist[k] == dist)
+		return;
+
+	if ( ! _dirty[k])
+	{
+		_dirty[k] = 1;
+		_before.push_back(_dist[k]);
+		_touched.push_back(k);
+	}
+
+	_dist[k] = dist;
+}
+
+/**
+ * Lowers the distance of the neighbors of a cell.
+ *
+ * @param   unsigned int   cell index
+ * @return  void
+ */
+void DistanceMap::_lower(unsigned int k)
+{
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	int x = k % cols;
+	int y = k / cols;
+
+	int ox = _obst[k] % cols;
+	int oy = _obst[k] / cols;
+
+	for (int dy = -1; dy <= 1; dy++)
+	{
+		for (int dx = -1; dx <= 1; dx++)
+		{
+			if (dx == 0 && dy == 0)
+				continue;
+
+			int i = y + dy;
+			int j = x + dx;
+
+			if (i < 0 || i >= rows || j < 0 || j >= cols)
+				continue;
+
+			unsigned int n = i * cols + j;
+
+			if (_raise[n])
+				continue;
+
+			int dist = (j - ox) * (j - ox) + (i - oy) * (i - oy);
+
+			// Out of range, the wave stops here
+			if (dist < _dist[n] && dist <= _range)
+			{
+				_assign(n, dist, _obst[k]);
+				_open.push(Q_PAIR(dist, n));
+			}
+		}
+	}
+}
+
+/**
+ * Clears the neighbors of a cell whose closest obstacle is gone.
+ *
+ * @param   unsigned int   cell index
+ * @return  void
+ */
+void DistanceMap::_raise_wave(unsigned int k)
+{
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	int x = k % cols;
+	int y = k / cols;
+
+	for (int dy = -1; dy <= 1; dy++)
+	{
+		for (int dx = -1; dx <= 1; dx++)
+		{
+			if (dx == 0 && dy == 0)
+				continue;
+
+			int i = y + dy;
+			int j = x + dx;
+
+			if (i < 0 || i >= rows || j < 0 || j >= cols)
+				continue;
+
+			unsigned int n = i * cols + j;
+
+			if (_obst[n] == NONE || _raise[n])
+				continue;
+
+			int dist = _dist[n];
+
+			// Neighbor lost its obstacle too, otherwise it lowers the cleared region
+			if ( ! _occ[_obst[n]])
+			{
+				_raise[n] = 1;
+				_assign(n, INT_MAX, NONE);
+			}
+
+			_open.push(Q_PAIR(dist, n));
+		}
+	}
+
+	_raise[k] = 0;
+}
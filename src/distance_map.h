@@ -0,0 +1,169 @@
+/**
+ * Distance Map.
+ *
+ * Incremental Euclidean distance transform over a map (dynamic brushfire, as
+ * in "Improved Updating of Euclidean Distance Maps and Voronoi Diagrams" by
+ * Boris Lau, Christoph Sprunk and Wolfram Burgard).  Adding or removing an
+ * obstacle only re-propagates distances in the region it affects, and never
+ * beyond the maximum range, so a new obstacle in open space does not reach
+ * every free cell.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_DISTANCE_MAP_H
+#define DSTARLITE_DISTANCE_MAP_H
+
+#include <climits>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class DistanceMap
+	{
+		public:
+
+			/**
+			 * Constructor, no obstacles.
+			 *
+			 * @param  Map*   map
+			 * @param  int    [optional]   maximum squared distance kept (farther cells have no obstacle)
+			 */
+			DistanceMap(Map* map, int range = INT_MAX);
+
+			/**
+			 * Deconstructor.
+			 */
+			~DistanceMap();
+
+			/**
+			 * Gets the distance to the closest obstacle (in cells).
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double       distance (Math::INF if there are no obstacles within range)
+			 */
+			double distance(Map::Cell* u);
+
+			/**
+			 * Checks if a cell is an obstacle.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  bool
+			 */
+			bool obstacle(Map::Cell* u);
+
+			/**
+			 * Marks or clears an obstacle, distances are updated on the next update().
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   bool         obstacle
+			 * @return  void
+			 */
+			void set(Map::Cell* u, bool obstacle);
+
+			/**
+			 * Propagates all pending changes.
+			 *
+			 * @param   vector<Map::Cell*>&   cells whose distance changed within range (appended)
+			 * @param   vector<double>&       their distances before the update (appended)
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& changed, vector<double>& before);
+
+		protected:
+
+			/**
+			 * @var  static const int  no obstacle
+			 */
+			static const int NONE;
+
+			/**
+			 * @var  priority queue of (squared distance, cell index)
+			 */
+			typedef pair<int, unsigned int> Q_PAIR;
+			typedef priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > Q;
+			Q _open;
+
+			/**
+			 * @var  vector<int>  squared distance of the touched cells before the current update
+			 */
+			vector<int> _before;
+
+			/**
+			 * @var  vector<int>  squared distance to the closest obstacle
+			 */
+			vector<int> _dist;
+
+			/**
+			 * @var  vector<unsigned char>  distance changed during the current update
+			 */
+			vector<unsigned char> _dirty;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  vector<int>  closest obstacle (cell index or NONE)
+			 */
+			vector<int> _obst;
+
+			/**
+			 * @var  vector<unsigned char>  cell is an obstacle
+			 */
+			vector<unsigned char> _occ;
+
+			/**
+			 * @var  vector<unsigned char>  cell waits for a raise wave
+			 */
+			vector<unsigned char> _raise;
+
+			/**
+			 * @var  int  maximum squared distance kept
+			 */
+			int _range;
+
+			/**
+			 * @var  vector<unsigned int>  cells whose distance changed during the current update
+			 */
+			vector<unsigned int> _touched;
+
+			/**
+			 * Records a distance change.
+			 *
+			 * @param   unsigned int   cell index
+			 * @param   int            squared distance
+			 * @param   int            closest obstacle
+			 * @return  void
+			 */
+			void _assign(unsigned int k, int dist, int obst);
+
+			/**
+			 * Lowers the distance of the neighbors of a cell.
+			 *
+			 * @param   unsigned int   cell index
+			 * @return  void
+			 */
+			void _lower(unsigned int k);
+
+			/**
+			 * Clears the neighbors of a cell whose closest obstacle is gone.
+			 *
+			 * @param   unsigned int   cell index
+			 * @return  void
+			 */
+			void _raise_wave(unsigned int k);
+	};
+};
+
+#endif // DSTARLITE_DISTANCE_MAP_H
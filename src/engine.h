@@ -0,0 +1,624 @@
+/**
+ * Engine.
+ *
+ * The D* Lite machinery (keys, open list, g/rhs values, incremental repairs)
+ * over any graph.  The graph type G provides:
+ *
+ *   typedef ... Vertex;                               copyable, comparable with ==
+ *   struct Hash { size_t operator()(const Vertex&) const; };
+ *   void succ(const Vertex& u, Edges& edges);         appends (v, cost of u -> v)
+ *   void pred(const Vertex& u, Edges& edges);         appends (v, cost of v -> u)
+ *   double h(const Vertex& a, const Vertex& b);       consistent estimate of a -> b
+ *
+ * Edge costs must be positive, blocked edges cost Math::INF and self-loops
+ * are ignored.  When edge costs change, the graph is updated first and then
+ * every vertex whose outgoing edges changed is passed to update().
+ *
+ * The grid planners are not instances of the engine.  Planner is not a
+ * template, the grid is not an Engine<G> specialization, and there is no
+ * benchmark showing the engine matches Planner on grids.  Planner,
+ * BoundedPlanner and AnyAnglePlanner keep their own loops over grid cells,
+ * because pooled storage and forks, cost overlays, compaction, fixed
+ * capacity slots and any-angle parents are outside the graph concept.  The
+ * engine runs the other backends (CSR, lattice, voxel, sparse, rolling,
+ * visibility, navmesh).  All planners order keys with the same KeyCompare
+ * (key.h).
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_ENGINE_H
+#define DSTARLITE_ENGINE_H
+
+#include <list>
+#include <map>
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+#include "key.h"
+#include "math.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	template <class G>
+	class Engine
+	{
+		public:
+
+			typedef typename G::Vertex Vertex;
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * @var  static const unsigned int  max steps before assuming no solution possible
+			 */
+			static const unsigned int MAX_STEPS = 1000000;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  G*                        graph
+			 * @param  Vertex                    start
+			 * @param  Vertex                    goal
+			 * @param  unsigned int [optional]   max steps of a compute
+			 */
+			Engine(G* graph, const Vertex& start, const Vertex& goal, unsigned int limit = MAX_STEPS);
+
+			/**
+			 * Computes the shortest path from the start to the goal.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool compute();
+
+			/**
+			 * Gets the number of vertices expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Drops the state of a vertex that left the graph.
+			 *
+			 * No edge may lead to it anymore, update() its former neighbors after.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  void
+			 */
+			void forget(const Vertex& u);
+
+			/**
+			 * Gets the g value of a vertex (cost to the goal).
+			 *
+			 * @param   Vertex   vertex
+			 * @return  double
+			 */
+			double g(const Vertex& u);
+
+			/**
+			 * Gets the goal.
+			 *
+			 * @return  Vertex
+			 */
+			Vertex goal();
+
+			/**
+			 * Gets the best successor of a vertex.
+			 *
+			 * @param   Vertex    vertex
+			 * @param   Vertex&   best successor (untouched if there is none)
+			 * @return  double    cost through the successor (Math::INF if there is none)
+			 */
+			double next(const Vertex& u, Vertex& v);
+
+			/**
+			 * Follows the best successors from the start to the goal.
+			 *
+			 * @param   list<Vertex>&   path (cleared first)
+			 * @return  bool            goal reached
+			 */
+			bool path(list<Vertex>& path);
+
+			/**
+			 * Gets the number of vertices with state.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  Vertex
+			 */
+			Vertex start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Vertex   new start
+			 * @return  void
+			 */
+			void start(const Vertex& u);
+
+			/**
+			 * Repairs a vertex whose outgoing edge costs changed.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  void
+			 */
+			void update(const Vertex& u);
+
+		protected:
+
+			typedef pair<double,double> Key;
+			typedef multimap<Key, Vertex, KeyCompare> OL;
+
+			/**
+			 * g and rhs values of a vertex and its open list slot.
+			 */
+			struct Entry
+			{
+				double g;
+				double rhs;
+				bool open;
+				typename OL::iterator it;
+
+				Entry() : g(Math::INF), rhs(Math::INF), open(false) {}
+			};
+
+#ifdef WIN32
+			typedef unordered_map<Vertex, Entry, typename G::Hash> EH;
+#else
+			typedef tr1::unordered_map<Vertex, Entry, typename G::Hash> EH;
+#endif
+
+			/**
+			 * @var  Edges  scratch edge list
+			 */
+			Edges _edges;
+
+			/**
+			 * @var  EH  vertices seen so far
+			 */
+			EH _entries;
+
+			/**
+			 * @var  unsigned int  vertices expanded
+			 */
+			unsigned int _expanded;
+
+			/**
+			 * @var  Vertex  goal
+			 */
+			Vertex _goal;
+
+			/**
+			 * @var  G*  graph
+			 */
+			G* _graph;
+
+			/**
+			 * @var  double  key modifier
+			 */
+			double _km;
+
+			/**
+			 * @var  unsigned int  max steps of a compute
+			 */
+			unsigned int _limit;
+
+			/**
+			 * @var  Vertex  start at the last edge change
+			 */
+			Vertex _last;
+
+			/**
+			 * @var  OL  open list
+			 */
+			OL _open_list;
+
+			/**
+			 * @var  Vertex  start
+			 */
+			Vertex _start;
+
+			/**
+			 * Gets the entry of a vertex, creating it if needed.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  Entry*
+			 */
+			Entry* _entry(const Vertex& u);
+
+			/**
+			 * Calculates the key of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  Key
+			 */
+			Key _k(const Vertex& u);
+
+			/**
+			 * Gets the best rhs value of a vertex from its successors.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  double
+			 */
+			double _min_succ(const Vertex& u);
+
+			/**
+			 * Puts a vertex on, or takes it off, the open list.
+			 *
+			 * @param   Vertex   vertex
+			 * @return  void
+			 */
+			void _update(const Vertex& u);
+	};
+
+	/**
+	 * Constructor.
+	 *
+	 * @param  G*                        graph
+	 * @param  Vertex                    start
+	 * @param  Vertex                    goal
+	 * @param  unsigned int [optional]   max steps of a compute
+	 */
+	template <class G>
+	Engine<G>::Engine(G* graph, const Vertex& start, const Vertex& goal, unsigned int limit)
+	{
+		_graph = graph;
+		_limit = limit;
+		_start = _last = start;
+		_goal = goal;
+		_km = 0.0;
+		_expanded = 0;
+
+		Entry* entry = _entry(_goal);
+		entry->rhs = 0.0;
+
+		_update(_goal);
+	}
+
+	/**
+	 * Computes the shortest path from the start to the goal.
+	 *
+	 * @return  bool   solution found
+	 */
+	template <class G>
+	bool Engine<G>::compute()
+	{
+		KeyCompare key_compare;
+
+		// Own list, _min_succ() reuses the scratch list
+		Edges preds;
+
+		unsigned int steps = 0;
+
+		while (( ! _open_list.empty() && key_compare(_open_list.begin()->first, _k(_start)))
+			|| ! Math::equals(_entry(_start)->rhs, _entry(_start)->g))
+		{
+			// Reached max steps or open list exhausted, quit
+			if (++steps > _limit || _open_list.empty())
+				return false;
+
+			Vertex u = _open_list.begin()->second;
+			Key k_old = _open_list.begin()->first;
+			Key k_new = _k(u);
+
+			Entry* entry = _entry(u);
+
+			if (key_compare(k_old, k_new))
+			{
+				_update(u);
+				continue;
+			}
+
+			_expanded++;
+
+			preds.clear();
+			_graph->pred(u, preds);
+
+			if (Math::greater(entry->g, entry->rhs))
+			{
+				entry->g = entry->rhs;
+				_update(u);
+
+				for (typename Edges::iterator it = preds.begin(); it != preds.end(); it++)
+				{
+					if (it->first == _goal || it->second == Math::INF)
+						continue;
+
+					Entry* p = _entry(it->first);
+					p->rhs = min(p->rhs, it->second + entry->g);
+
+					_update(it->first);
+				}
+			}
+			else
+			{
+				double g_old = entry->g;
+				entry->g = Math::INF;
+
+				if ( ! (u == _goal))
+				{
+					entry->rhs = _min_succ(u);
+				}
+
+				_update(u);
+
+				for (typename Edges::iterator it = preds.begin(); it != preds.end(); it++)
+				{
+					if (it->first == _goal || it->second == Math::INF)
+						continue;
+
+					Entry* p = _entry(it->first);
+
+					// Only predecessors that went through u need a new rhs
+					if (Math::equals(p->rhs, it->second + g_old))
+					{
+						p->rhs = _min_succ(it->first);
+					}
+
+					_update(it->first);
+				}
+			}
+		}
+
+		return _entry(_start)->rhs != Math::INF;
+	}
+
+	/**
+	 * Gets the number of vertices expanded so far.
+	 *
+	 * @return  unsigned int
+	 */
+	template <class G>
+	unsigned int Engine<G>::expanded()
+	{
+		return _expanded;
+	}
+
+	/**
+	 * Drops the state of a vertex that left the graph.
+	 *
+	 * No edge may lead to it anymore, update() its former neighbors after.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  void
+	 */
+	template <class G>
+	void Engine<G>::forget(const Vertex& u)
+	{
+		typename EH::iterator it = _entries.find(u);
+
+		if (it == _entries.end() || u == _goal)
+			return;
+
+		if (it->second.open)
+		{
+			_open_list.erase(it->second.it);
+		}
+
+		_entries.erase(it);
+	}
+
+	/**
+	 * Gets the g value of a vertex (cost to the goal).
+	 *
+	 * @param   Vertex   vertex
+	 * @return  double
+	 */
+	template <class G>
+	double Engine<G>::g(const Vertex& u)
+	{
+		typename EH::iterator it = _entries.find(u);
+
+		return (it == _entries.end()) ? Math::INF : it->second.g;
+	}
+
+	/**
+	 * Gets the goal.
+	 *
+	 * @return  Vertex
+	 */
+	template <class G>
+	typename Engine<G>::Vertex Engine<G>::goal()
+	{
+		return _goal;
+	}
+
+	/**
+	 * Gets the best successor of a vertex.
+	 *
+	 * @param   Vertex    vertex
+	 * @param   Vertex&   best successor (untouched if there is none)
+	 * @return  double    cost through the successor (Math::INF if there is none)
+	 */
+	template <class G>
+	double Engine<G>::next(const Vertex& u, Vertex& v)
+	{
+		double best = Math::INF;
+
+		_edges.clear();
+		_graph->succ(u, _edges);
+
+		for (typename Edges::iterator it = _edges.begin(); it != _edges.end(); it++)
+		{
+			// A self-loop never leads anywhere
+			if (it->first == u)
+				continue;
+
+			double tmp_g = g(it->first);
+
+			if (it->second == Math::INF || tmp_g == Math::INF)
+				continue;
+
+			if (it->second + tmp_g < best)
+			{
+				best = it->second + tmp_g;
+				v = it->first;
+			}
+		}
+
+		return best;
+	}
+
+	/**
+	 * Follows the best successors from the start to the goal.
+	 *
+	 * @param   list<Vertex>&   path (cleared first)
+	 * @return  bool            goal reached
+	 */
+	template <class G>
+	bool Engine<G>::path(list<Vertex>& path)
+	{
+		path.clear();
+
+		Vertex current = _start;
+		path.push_back(current);
+
+		for (unsigned int steps = 0; ! (current == _goal); steps++)
+		{
+			// No successor, or going around in circles (a path visits a vertex with state at most once)
+			if (steps > _entries.size() || next(current, current) == Math::INF)
+				return false;
+
+			path.push_back(current);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Gets the number of vertices with state.
+	 *
+	 * @return  unsigned int
+	 */
+	template <class G>
+	unsigned int Engine<G>::size()
+	{
+		return _entries.size();
+	}
+
+	/**
+	 * Gets the start.
+	 *
+	 * @return  Vertex
+	 */
+	template <class G>
+	typename Engine<G>::Vertex Engine<G>::start()
+	{
+		return _start;
+	}
+
+	/**
+	 * Moves the start.
+	 *
+	 * @param   Vertex   new start
+	 * @return  void
+	 */
+	template <class G>
+	void Engine<G>::start(const Vertex& u)
+	{
+		_start = u;
+	}
+
+	/**
+	 * Repairs a vertex whose outgoing edge costs changed.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  void
+	 */
+	template <class G>
+	void Engine<G>::update(const Vertex& u)
+	{
+		if (u == _goal)
+			return;
+
+		// Update km
+		_km += _graph->h(_last, _start);
+		_last = _start;
+
+		_entry(u)->rhs = _min_succ(u);
+		_update(u);
+	}
+
+	/**
+	 * Gets the entry of a vertex, creating it if needed.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  Entry*
+	 */
+	template <class G>
+	typename Engine<G>::Entry* Engine<G>::_entry(const Vertex& u)
+	{
+		return &_entries[u];
+	}
+
+	/**
+	 * Calculates the key of a vertex.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  Key
+	 */
+	template <class G>
+	typename Engine<G>::Key Engine<G>::_k(const Vertex& u)
+	{
+		Entry* entry = _entry(u);
+		double min = (entry->g < entry->rhs) ? entry->g : entry->rhs;
+
+		if (min == Math::INF)
+			return Key(Math::INF, Math::INF);
+
+		return Key(min + _graph->h(_start, u) + _km, min);
+	}
+
+	/**
+	 * Gets the best rhs value of a vertex from its successors.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  double
+	 */
+	template <class G>
+	double Engine<G>::_min_succ(const Vertex& u)
+	{
+		Vertex v;
+
+		return next(u, v);
+	}
+
+	/**
+	 * Puts a vertex on, or takes it off, the open list.
+	 *
+	 * @param   Vertex   vertex
+	 * @return  void
+	 */
+	template <class G>
+	void Engine<G>::_update(const Vertex& u)
+	{
+		Entry* entry = _entry(u);
+
+		if (entry->open)
+		{
+			_open_list.erase(entry->it);
+			entry->open = false;
+		}
+
+		if ( ! Math::equals(entry->g, entry->rhs))
+		{
+			entry->it = _open_list.insert(typename OL::value_type(_k(u), u));
+			entry->open = true;
+		}
+	}
+};
+
+#endif // DSTARLITE_ENGINE_H
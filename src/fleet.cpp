@@ -0,0 +1,490 @@
+/**
+ * Fleet.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "fleet.h"
+
+/**
+ * Constructor.
+ *
+ * @param  Map*                    map with the robots' prior knowledge (shared, never written)
+ * @param  Map*                    real map (shared, never written)
+ * @param  unsigned int            scan radius
+ * @param  unsigned int [optional] number of worker threads
+ */
+Fleet::Fleet(Map* map, Map* real, unsigned int scan_radius, unsigned int threads)
+{
+	_map = map;
+	_real = real;
+	_scanner = new Scanner(scan_radius);
+	_pool = new ThreadPool(threads);
+	_table = new ReservationTable();
+
+	_next = 0;
+	_offset = 0;
+	_tick = 0;
+	_window = 0;
+}
+
+/**
+ * Deconstructor.
+ */
+Fleet::~Fleet()
+{
+	for (unsigned int i = 0; i < _robots.size(); i++)
+	{
+		delete _robots[i];
+	}
+
+	delete _pool;
+	delete _scanner;
+	delete _table;
+}
+
+/**
+ * Adds a robot.
+ *
+ * @param   Map::Cell*   start cell (of the prior map)
+ * @param   Map::Cell*   goal cell (of the prior map)
+ * @return  Robot*
+ */
+Fleet::Robot* Fleet::add(Map::Cell* start, Map::Cell* goal)
+{
+	Robot* robot = new Robot(this, start, goal);
+	_robots.push_back(robot);
+
+	return robot;
+}
+
+/**
+ * Enables cooperative planning.
+ *
+ * @param   unsigned int   window (time steps planned ahead, replanned every half window)
+ * @return  void
+ */
+void Fleet::cooperate(unsigned int window)
+{
+	_window = window;
+	_next = _tick;
+}
+
+/**
+ * Gets the map with the robots' prior knowledge.
+ *
+ * @return  Map*
+ */
+Map* Fleet::map()
+{
+	return _map;
+}
+
+/**
+ * Gets the real map.
+ *
+ * @return  Map*
+ */
+Map* Fleet::real()
+{
+	return _real;
+}
+
+/**
+ * Gets the reservations of the current window.
+ *
+ * @return  ReservationTable*
+ */
+ReservationTable* Fleet::reservations()
+{
+	return _table;
+}
+
+/**
+ * Gets the robots.
+ *
+ * @return  vector<Robot*>&
+ */
+vector<Fleet::Robot*>& Fleet::robots()
+{
+	return _robots;
+}
+
+/**
+ * Gets the scanner.
+ *
+ * @return  Scanner*
+ */
+Scanner* Fleet::scanner()
+{
+	return _scanner;
+}
+
+/**
+ * Steps all robots that are still moving, in parallel.
+ *
+ * @return  unsigned int  number of robots still moving
+ */
+unsigned int Fleet::step()
+{
+	_active.clear();
+
+	for (unsigned int i = 0; i < _robots.size(); i++)
+	{
+		if ( ! _robots[i]->done())
+		{
+			_active.push_back(_robots[i]);
+		}
+	}
+
+	_pool->run(_active);
+
+	if (_window > 0)
+	{
+		_cooperate();
+	}
+
+	unsigned int moving = 0;
+
+	for (unsigned int i = 0; i < _robots.size(); i++)
+	{
+		if ( ! _robots[i]->done())
+		{
+			moving++;
+		}
+	}
+
+	return moving;
+}
+
+/**
+ * Gets the cooperative planning window (0 if off).
+ *
+ * @return  unsigned int
+ */
+unsigned int Fleet::window()
+{
+	return _window;
+}
+
+/**
+ * Plans all robots' windows if due and steps them (cooperative mode).
+ *
+ * Planning is sequential, each robot sees the reservations of the robots
+ * planned before it and the cells the others stand on at the next step.
+ * The heavy part (the heuristic) was refreshed by the robots on the
+ * workers already.
+ *
+ * @return  void
+ */
+void Fleet::_cooperate()
+{
+	unsigned int size = _robots.size();
+
+	bool replan = _tick >= _next;
+
+	for (unsigned int i = 0; i < size && ! replan; i++)
+	{
+		if ( ! _robots[i]->done() && _robots[i]->stale())
+		{
+			replan = true;
+		}
+	}
+
+	if (replan)
+	{
+		_table->clear();
+
+		// Every robot holds its cell now and, until it has planned, next
+		// step too (nobody moves in before its owner commits to leave);
+		// stopped robots hold it for the whole window
+		for (unsigned int i = 0; i < size; i++)
+		{
+			unsigned int until = _robots[i]->done() ? _tick + _window : _tick + 1;
+
+			for (unsigned int t = _tick; t <= until; t++)
+			{
+				_table->reserve(_robots[i]->current, t);
+			}
+		}
+
+		// Rotate the priorities so no robot always yields
+		for (unsigned int i = 0; i < size; i++)
+		{
+			Robot* robot = _robots[(_offset + i) % size];
+
+			if ( ! robot->done())
+			{
+				_table->release(robot->current, _tick + 1);
+				robot->plan(_table, _tick, _window);
+			}
+		}
+
+		_offset = size > 0 ? (_offset + 1) % size : 0;
+		_next = _tick + (_window > 1 ? _window / 2 : 1);
+	}
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		if ( ! _robots[i]->done())
+		{
+			_robots[i]->advance();
+		}
+	}
+
+	_tick++;
+}
+
+/**
+ * Constructor.
+ *
+ * @param  Fleet*       fleet
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+Fleet::Robot::Robot(Fleet* fleet, Map::Cell* start, Map::Cell* goal)
+{
+	_fleet = fleet;
+	_done = false;
+	_failed = false;
+	_changed = false;
+	_init = false;
+	_scanned = NULL;
+
+	_planner = new Planner(fleet->map(), start, goal);
+	_space_time = new SpaceTimePlanner(fleet->map(), _planner, fleet->reservations());
+
+	current = start;
+	path_traversed.push_back(start);
+}
+
+/**
+ * Deconstructor.
+ */
+Fleet::Robot::~Robot()
+{
+	delete _space_time;
+	delete _planner;
+}
+
+/**
+ * Steps along the planned path (cooperative mode), waits if there is none.
+ *
+ * @return  void
+ */
+void Fleet::Robot::advance()
+{
+	if ( ! path_planned.empty())
+	{
+		current = path_planned.front();
+		_planner->start(current);
+		path_planned.pop_front();
+	}
+
+	path_traversed.push_back(current);
+}
+
+/**
+ * Checks if the robot stopped (goal reached or no solution).
+ *
+ * @return  bool
+ */
+bool Fleet::Robot::done()
+{
+	return _done;
+}
+
+/**
+ * Checks if no solution was found.
+ *
+ * @return  bool
+ */
+bool Fleet::Robot::failed()
+{
+	return _failed;
+}
+
+/**
+ * Plans the robot's window and reserves it (cooperative mode).
+ *
+ * @param   ReservationTable*   reservations of robots planned before
+ * @param   unsigned int        current time step
+ * @param   unsigned int        window
+ * @return  bool                path found
+ */
+bool Fleet::Robot::plan(ReservationTable* table, unsigned int t, unsigned int window)
+{
+	_changed = false;
+	path_planned.clear();
+
+	// Boxed in by robots planned before, wait and retry next tick
+	if ( ! _space_time->plan(current, t, window))
+	{
+		for (unsigned int i = 1; i <= window; i++)
+		{
+			table->reserve(current, t + i);
+		}
+
+		return false;
+	}
+
+	path_planned = _space_time->path();
+	path_planned.pop_front();
+
+	unsigned int i = 1;
+
+	for (list<Map::Cell*>::iterator it = path_planned.begin(); it != path_planned.end() && i <= window; it++, i++)
+	{
+		table->reserve(*it, t + i);
+	}
+
+	// Arrived within the window, hold the goal for the rest of it
+	for (Map::Cell* u = path_planned.empty() ? current : path_planned.back(); i <= window; i++)
+	{
+		table->reserve(u, t + i);
+	}
+
+	return true;
+}
+
+/**
+ * Gets the planner.
+ *
+ * @return  Planner*
+ */
+Planner* Fleet::Robot::planner()
+{
+	return _planner;
+}
+
+/**
+ * Checks if the robot's window must be replanned (costs changed or no path).
+ *
+ * @return  bool
+ */
+bool Fleet::Robot::stale()
+{
+	return _changed || path_planned.empty();
+}
+
+/**
+ * Executes one tick: scan, replan if needed and step.
+ *
+ * @return  void
+ */
+void Fleet::Robot::run()
+{
+	if (_done)
+		return;
+
+	if (current == _planner->goal())
+	{
+		_done = true;
+		return;
+	}
+
+	// Cooperative mode, only refresh the heuristic, the fleet plans and steps
+	if (_fleet->window() > 0)
+	{
+		if (_scan() || ! _init)
+		{
+			_init = true;
+			_changed = true;
+			_space_time->invalidate();
+		}
+
+		if (_space_time->distance()->get(current) == Math::INF)
+		{
+			_done = _failed = true;
+		}
+
+		return;
+	}
+
+	// Replan on the first tick or when something changed
+	if (_scan() || ! _init)
+	{
+		_init = true;
+
+		if ( ! _planner->replan())
+		{
+			_done = _failed = true;
+			return;
+		}
+
+		path_planned = _planner->path();
+
+		if ( ! path_planned.empty())
+		{
+			path_planned.pop_front();
+		}
+	}
+
+	if (path_planned.empty())
+	{
+		_done = _failed = true;
+		return;
+	}
+
+	// Step
+	current = path_planned.front();
+	_planner->start(current);
+	path_planned.pop_front();
+	path_traversed.push_back(current);
+}
+
+/**
+ * Scans the real map around the robot.
+ *
+ * @return  bool  updates found
+ */
+bool Fleet::Robot::_scan()
+{
+	bool error = false;
+
+	Scanner* scanner = _fleet->scanner();
+	Map* real = _fleet->real();
+	Map* map = _fleet->map();
+
+	int x = current->x();
+	int y = current->y();
+	int rows = map->rows();
+	int cols = map->cols();
+
+	vector<Scanner::Offset>* offsets = &scanner->disk();
+
+	if (_scanned != NULL)
+	{
+		int dx = x - (int) _scanned->x();
+		int dy = y - (int) _scanned->y();
+
+		if (dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1)
+		{
+			offsets = &scanner->crescent(dx, dy);
+		}
+	}
+
+	_scanned = current;
+
+	for (vector<Scanner::Offset>::iterator it = offsets->begin(); it != offsets->end(); it++)
+	{
+		int i = y + it->second;
+		int j = x + it->first;
+
+		if (i < 0 || i >= rows || j < 0 || j >= cols)
+			continue;
+
+		Map::Cell* u = (*map)(i, j);
+		double cost = (*real)(i, j)->cost;
+
+		if (_planner->cost(u) != cost)
+		{
+			error = true;
+			_planner->update(u, cost);
+		}
+	}
+
+	return error;
+}
@@ -0,0 +1,327 @@
+/**
+ * Fleet.
+ *
+ * Headless multi-robot simulation core.  The robots share one read-only map
+ * with their prior knowledge and one read-only real map; each robot keeps what
+ * it has learned in its planner's cost overlay, so planners never write to the
+ * shared maps and all robots can be stepped in parallel.
+ *
+ * In cooperative mode (windowed hierarchical cooperative A*) the robots also
+ * avoid each other.  Each robot keeps the exact static cost to its goal as a
+ * heuristic, refreshed on the workers, and every few ticks the fleet plans
+ * all robots for a rolling window in space-time, one after the other in a
+ * rotating priority order, each reserving its window in a shared table.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_FLEET_H
+#define DSTARLITE_FLEET_H
+
+#include <list>
+#include <vector>
+
+#include "map.h"
+#include "planner.h"
+#include "reservation_table.h"
+#include "scanner.h"
+#include "space_time_planner.h"
+#include "thread_pool.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class Fleet
+	{
+		public:
+
+			/**
+			 * Robot.
+			 */
+			class Robot : public ThreadPool::Job
+			{
+				public:
+
+					/**
+					 * @var  Map::Cell*  current position
+					 */
+					Map::Cell* current;
+
+					/**
+					 * @var  list<Map::Cell*>  planned path
+					 */
+					list<Map::Cell*> path_planned;
+
+					/**
+					 * @var  list<Map::Cell*>  traversed path
+					 */
+					list<Map::Cell*> path_traversed;
+
+					/**
+					 * Constructor.
+					 *
+					 * @param  Fleet*       fleet
+					 * @param  Map::Cell*   start cell
+					 * @param  Map::Cell*   goal cell
+					 */
+					Robot(Fleet* fleet, Map::Cell* start, Map::Cell* goal);
+
+					/**
+					 * Deconstructor.
+					 */
+					~Robot();
+
+					/**
+					 * Steps along the planned path (cooperative mode), waits if there is none.
+					 *
+					 * @return  void
+					 */
+					void advance();
+
+					/**
+					 * Checks if the robot stopped (goal reached or no solution).
+					 *
+					 * @return  bool
+					 */
+					bool done();
+
+					/**
+					 * Checks if no solution was found.
+					 *
+					 * @return  bool
+					 */
+					bool failed();
+
+					/**
+					 * Plans the robot's window and reserves it (cooperative mode).
+					 *
+					 * @param   ReservationTable*   reservations of robots planned before
+					 * @param   unsigned int        current time step
+					 * @param   unsigned int        window
+					 * @return  bool                path found
+					 */
+					bool plan(ReservationTable* table, unsigned int t, unsigned int window);
+
+					/**
+					 * Gets the planner.
+					 *
+					 * @return  Planner*
+					 */
+					Planner* planner();
+
+					/**
+					 * Checks if the robot's window must be replanned (costs changed or no path).
+					 *
+					 * @return  bool
+					 */
+					bool stale();
+
+					/**
+					 * Executes one tick: scan, replan if needed and step.
+					 *
+					 * @return  void
+					 */
+					virtual void run();
+
+				protected:
+
+					/**
+					 * @var  bool  costs changed since the last window was planned
+					 */
+					bool _changed;
+
+					/**
+					 * @var  bool  goal reached or no solution
+					 */
+					bool _done;
+
+					/**
+					 * @var  bool  no solution found
+					 */
+					bool _failed;
+
+					/**
+					 * @var  Fleet*  fleet
+					 */
+					Fleet* _fleet;
+
+					/**
+					 * @var  bool  initial plan made
+					 */
+					bool _init;
+
+					/**
+					 * @var  Planner*  planner
+					 */
+					Planner* _planner;
+
+					/**
+					 * @var  Map::Cell*  position of the last scan (NULL if never scanned)
+					 */
+					Map::Cell* _scanned;
+
+					/**
+					 * @var  SpaceTimePlanner*  space-time planner (cooperative mode)
+					 */
+					SpaceTimePlanner* _space_time;
+
+					/**
+					 * Scans the real map around the robot.
+					 *
+					 * @return  bool  updates found
+					 */
+					bool _scan();
+			};
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*                    map with the robots' prior knowledge (shared, never written)
+			 * @param  Map*                    real map (shared, never written)
+			 * @param  unsigned int            scan radius
+			 * @param  unsigned int [optional] number of worker threads
+			 */
+			Fleet(Map* map, Map* real, unsigned int scan_radius, unsigned int threads = 0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~Fleet();
+
+			/**
+			 * Adds a robot.
+			 *
+			 * @param   Map::Cell*   start cell (of the prior map)
+			 * @param   Map::Cell*   goal cell (of the prior map)
+			 * @return  Robot*
+			 */
+			Robot* add(Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Enables cooperative planning.
+			 *
+			 * @param   unsigned int   window (time steps planned ahead, replanned every half window)
+			 * @return  void
+			 */
+			void cooperate(unsigned int window);
+
+			/**
+			 * Gets the map with the robots' prior knowledge.
+			 *
+			 * @return  Map*
+			 */
+			Map* map();
+
+			/**
+			 * Gets the real map.
+			 *
+			 * @return  Map*
+			 */
+			Map* real();
+
+			/**
+			 * Gets the reservations of the current window.
+			 *
+			 * @return  ReservationTable*
+			 */
+			ReservationTable* reservations();
+
+			/**
+			 * Gets the robots.
+			 *
+			 * @return  vector<Robot*>&
+			 */
+			vector<Robot*>& robots();
+
+			/**
+			 * Gets the scanner.
+			 *
+			 * @return  Scanner*
+			 */
+			Scanner* scanner();
+
+			/**
+			 * Steps all robots that are still moving, in parallel.
+			 *
+			 * @return  unsigned int  number of robots still moving
+			 */
+			unsigned int step();
+
+			/**
+			 * Gets the cooperative planning window (0 if off).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int window();
+
+		protected:
+
+			/**
+			 * @var  vector<ThreadPool::Job*>  robots still moving
+			 */
+			vector<ThreadPool::Job*> _active;
+
+			/**
+			 * @var  Map*  map with the robots' prior knowledge
+			 */
+			Map* _map;
+
+			/**
+			 * @var  unsigned int  time step of the next cooperative replan
+			 */
+			unsigned int _next;
+
+			/**
+			 * @var  unsigned int  robot planned first in the next cooperative replan
+			 */
+			unsigned int _offset;
+
+			/**
+			 * @var  ThreadPool*  workers
+			 */
+			ThreadPool* _pool;
+
+			/**
+			 * @var  Map*  real map
+			 */
+			Map* _real;
+
+			/**
+			 * @var  vector<Robot*>  robots
+			 */
+			vector<Robot*> _robots;
+
+			/**
+			 * @var  Scanner*  precomputed scan offsets (shared, read-only)
+			 */
+			Scanner* _scanner;
+
+			/**
+			 * @var  ReservationTable*  reservations of the current window
+			 */
+			ReservationTable* _table;
+
+			/**
+			 * @var  unsigned int  current time step
+			 */
+			unsigned int _tick;
+
+			/**
+			 * @var  unsigned int  cooperative planning window (0 if off)
+			 */
+			unsigned int _window;
+
+			/**
+			 * Plans all robots' windows if due and steps them (cooperative mode).
+			 *
+			 * @return  void
+			 */
+			void _cooperate();
+	};
+};
+
+#endif // DSTARLITE_FLEET_H
@@ -0,0 +1,24 @@
+/**
+ * Key.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "key.h"
+#include "math.h"
+
+using namespace DStarLite;
+
+/**
+ * Key compare function.
+ */
+bool KeyCompare::operator()(const pair<double,double>& p1, const pair<double,double>& p2) const
+{
+	if (Math::less(p1.first, p2.first))				return true;
+	else if (Math::greater(p1.first, p2.first))		return false;
+	else if (Math::less(p1.second,  p2.second))		return true;
+	else if (Math::greater(p1.second, p2.second))	return false;
+													return false;
+}
@@ -0,0 +1,32 @@
+/**
+ * Key.
+ *
+ * Order of the D* Lite keys [min(g, rhs) + h + km; min(g, rhs)], compared
+ * with the Math precision.  Shared by the grid planners and the generic
+ * engine, so all of them break ties the same way.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_KEY_H
+#define DSTARLITE_KEY_H
+
+#include <functional>
+#include <utility>
+
+using namespace std;
+
+namespace DStarLite
+{
+	/**
+	 * Key compare struct.
+	 */
+	struct KeyCompare : public binary_function<pair<double,double>, pair<double,double>, bool>
+	{
+		bool operator()(const pair<double,double>& p1, const pair<double,double>& p2) const;
+	};
+};
+
+#endif // DSTARLITE_KEY_H
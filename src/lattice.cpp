@@ -0,0 +1,386 @@
+/**
+ * Lattice.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "lattice.h"
+#include "math.h"
+
+/**
+ * @var  static const unsigned int  number of heading bins
+ */
+const unsigned int Lattice::HEADINGS = 8;
+
+/**
+ * @var  static const unsigned int  heading of the virtual goal state
+ */
+const unsigned int Lattice::ANY = Lattice::HEADINGS;
+
+/**
+ * @var  static const double  cost multiplier of the reverse move
+ */
+const double Lattice::REVERSE_PENALTY = 3.0;
+
+/**
+ * Constructor.
+ *
+ * @param  Map*           map
+ * @param  CostOverlay*   costs
+ * @param  Map::Cell*     goal cell
+ */
+Lattice::Lattice(Map* map, CostOverlay* overlay, Map::Cell* goal)
+{
+	_map = map;
+	_overlay = overlay;
+	_goal = goal;
+
+	_from.resize(HEADINGS);
+	_to.resize(HEADINGS);
+	_reverse.resize(HEADINGS);
+
+	// Axis heading: forward, turn left, turn right, reverse
+	_add(0, 0, 1, 0, 1.0);
+	_add(0, 1, 2, 1, 1.0);
+	_add(0, 7, 2, -1, 1.0);
+	_add(0, 0, -1, 0, Lattice::REVERSE_PENALTY);
+
+	// Diagonal heading: forward, turn left, turn right, reverse
+	_add(1, 1, 1, 1, 1.0);
+	_add(1, 2, 1, 2, 1.0);
+	_add(1, 0, 2, 1, 1.0);
+	_add(1, 1, -1, -1, Lattice::REVERSE_PENALTY);
+}
+
+/**
+ * Gets the states whose outgoing primitives sweep a cell.
+ *
+ * @param   Map::Cell*        cell
+ * @param   vector<State>&    states (appended)
+ * @return  void
+ */
+void Lattice::affected(Map::Cell* u, vector<State>& states)
+{
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	for (unsigned int h = 0; h < HEADINGS; h++)
+	{
+		for (vector<pair<int,int> >::iterator it = _reverse[h].begin(); it != _reverse[h].end(); it++)
+		{
+			State s;
+			s.x = (int) u->x() - it->first;
+			s.y = (int) u->y() - it->second;
+			s.heading = h;
+
+			if (s.x < 0 || s.x >= cols || s.y < 0 || s.y >= rows)
+				continue;
+
+			states.push_back(s);
+		}
+	}
+}
+
+/**
+ * Gets the virtual goal state.
+ *
+ * @return  State
+ */
+Lattice::State Lattice::goal()
+{
+	return state(_goal, ANY);
+}
+
+/**
+ * Estimates the cost between two states (straight line distance).
+ *
+ * A primitive is never shorter than the straight line between its ends
+ * and no cell costs less than one, so the estimate is admissible.
+ *
+ * @param   State   a
+ * @param   State   b
+ * @return  double
+ */
+double Lattice::h(const State& a, const State& b)
+{
+	double dx = a.x - b.x;
+	double dy = a.y - b.y;
+
+	return sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Gets the heading bin closest to a direction.
+ *
+ * @param   int            x offset
+ * @param   int            y offset
+ * @return  unsigned int
+ */
+unsigned int Lattice::heading(int dx, int dy)
+{
+	double degrees = Math::rad2deg(atan2((double) dy, (double) dx));
+	int bin = (int) floor(degrees / (360.0 / HEADINGS) + 0.5);
+
+	return (unsigned int) ((bin + (int) HEADINGS) % (int) HEADINGS);
+}
+
+/**
+ * Gets the predecessors of a state.
+ *
+ * @param   State    state
+ * @param   Edges&   predecessors and primitive costs (appended)
+ * @return  void
+ */
+void Lattice::pred(const State& u, Edges& edges)
+{
+	// Any heading of the goal cell leads to the virtual goal
+	if (u.heading == ANY)
+	{
+		for (unsigned int h = 0; h < HEADINGS; h++)
+		{
+			edges.push_back(pair<State, double>(state(_goal, h), 0.0));
+		}
+
+		return;
+	}
+
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	for (vector<unsigned int>::iterator it = _to[u.heading].begin(); it != _to[u.heading].end(); it++)
+	{
+		Primitive& p = _primitives[*it];
+
+		State v;
+		v.x = u.x - p.dx;
+		v.y = u.y - p.dy;
+		v.heading = p.from;
+
+		if (v.x < 0 || v.x >= cols || v.y < 0 || v.y >= rows)
+			continue;
+
+		edges.push_back(pair<State, double>(v, _cost(v.x, v.y, p)));
+	}
+}
+
+/**
+ * Gets the motion primitives.
+ *
+ * @return  vector<Primitive>&
+ */
+vector<Lattice::Primitive>& Lattice::primitives()
+{
+	return _primitives;
+}
+
+/**
+ * Makes a state.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   heading
+ * @return  State
+ */
+Lattice::State Lattice::state(Map::Cell* u, unsigned int heading)
+{
+	State s;
+	s.x = u->x();
+	s.y = u->y();
+	s.heading = heading;
+
+	return s;
+}
+
+/**
+ * Gets the successors of a state.
+ *
+ * @param   State    state
+ * @param   Edges&   successors and primitive costs (appended)
+ * @return  void
+ */
+void Lattice::succ(const State& u, Edges& edges)
+{
+	if (u.heading == ANY)
+		return;
+
+	if (u.x == (int) _goal->x() && u.y == (int) _goal->y())
+	{
+		edges.push_back(pair<State, double>(goal(), 0.0));
+	}
+
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	for (vector<unsigned int>::iterator it = _from[u.heading].begin(); it != _from[u.heading].end(); it++)
+	{
+		Primitive& p = _primitives[*it];
+
+		State v;
+		v.x = u.x + p.dx;
+		v.y = u.y + p.dy;
+		v.heading = p.to;
+
+		if (v.x < 0 || v.x >= cols || v.y < 0 || v.y >= rows)
+			continue;
+
+		edges.push_back(pair<State, double>(v, _cost(u.x, u.y, p)));
+	}
+}
+
+/**
+ * Adds a primitive and its three rotations by 90 degrees.
+ *
+ * The footprint is sampled along a cubic curve between the start and end
+ * poses (a straight line for moves that keep the heading).
+ *
+ * @param   unsigned int   start heading (0 or 1)
+ * @param   unsigned int   end heading
+ * @param   int            end x offset
+ * @param   int            end y offset
+ * @param   double         cost multiplier
+ * @return  void
+ */
+void Lattice::_add(unsigned int from, unsigned int to, int dx, int dy, double penalty)
+{
+	const unsigned int SAMPLES = 32;
+
+	double chord = sqrt((double) (dx * dx + dy * dy));
+
+	// Tangents of the start and end poses
+	double angle0 = Math::deg2rad(from * 360.0 / HEADINGS);
+	double angle1 = Math::deg2rad(to * 360.0 / HEADINGS);
+	double tx0 = chord * cos(angle0), ty0 = chord * sin(angle0);
+	double tx1 = chord * cos(angle1), ty1 = chord * sin(angle1);
+
+	Primitive p;
+	p.from = from;
+	p.to = to;
+	p.dx = dx;
+	p.dy = dy;
+	p.length = 0.0;
+
+	double px = 0.0, py = 0.0;
+
+	for (unsigned int i = 0; i <= SAMPLES; i++)
+	{
+		double t = (double) i / SAMPLES;
+		double x, y;
+
+		if (from == to)
+		{
+			x = t * dx;
+			y = t * dy;
+		}
+		else
+		{
+			// Cubic Hermite basis
+			double h10 = t * t * t - 2 * t * t + t;
+			double h01 = -2 * t * t * t + 3 * t * t;
+			double h11 = t * t * t - t * t;
+
+			x = h10 * tx0 + h01 * dx + h11 * tx1;
+			y = h10 * ty0 + h01 * dy + h11 * ty1;
+		}
+
+		p.length += sqrt((x - px) * (x - px) + (y - py) * (y - py));
+		px = x;
+		py = y;
+
+		pair<int,int> offset((int) floor(x + 0.5), (int) floor(y + 0.5));
+
+		if (find(p.footprint.begin(), p.footprint.end(), offset) == p.footprint.end())
+		{
+			p.footprint.push_back(offset);
+		}
+	}
+
+	p.length *= penalty;
+
+	// Rotate by 90 degrees: (x, y) -> (-y, x), two heading bins
+	for (unsigned int r = 0; r < 4; r++)
+	{
+		unsigned int k = _primitives.size();
+
+		_primitives.push_back(p);
+		_from[p.from].push_back(k);
+		_to[p.to].push_back(k);
+
+		for (vector<pair<int,int> >::iterator it = p.footprint.begin(); it != p.footprint.end(); it++)
+		{
+			if (find(_reverse[p.from].begin(), _reverse[p.from].end(), *it) == _reverse[p.from].end())
+			{
+				_reverse[p.from].push_back(*it);
+			}
+
+			*it = pair<int,int>(-it->second, it->first);
+		}
+
+		int tmp = p.dx;
+		p.dx = -p.dy;
+		p.dy = tmp;
+
+		p.from = (p.from + 2) % HEADINGS;
+		p.to = (p.to + 2) % HEADINGS;
+	}
+}
+
+/**
+ * Gets the cost of a primitive from a cell.
+ *
+ * The length of the primitive times the average cost of the cells it sweeps.
+ *
+ * @param   int            x-coordinate
+ * @param   int            y-coordinate
+ * @param   Primitive&     primitive
+ * @return  double         cost (Math::INF if blocked or off the map)
+ */
+double Lattice::_cost(int x, int y, Primitive& p)
+{
+	int rows = _map->rows();
+	int cols = _map->cols();
+
+	double sum = 0.0;
+
+	for (vector<pair<int,int> >::iterator it = p.footprint.begin(); it != p.footprint.end(); it++)
+	{
+		int j = x + it->first;
+		int i = y + it->second;
+
+		if (i < 0 || i >= rows || j < 0 || j >= cols)
+			return Math::INF;
+
+		double cost = _overlay->cost((*_map)(i, j));
+
+		if (cost == Map::Cell::COST_UNWALKABLE)
+			return Math::INF;
+
+		sum += cost;
+	}
+
+	return p.length * sum / p.footprint.size();
+}
+
+/**
+ * Compares two states.
+ *
+ * @param   State   state
+ * @return  bool
+ */
+bool Lattice::State::operator==(const State& s) const
+{
+	return x == s.x && y == s.y && heading == s.heading;
+}
+
+/**
+ * Hashes a state.
+ *
+ * @param   State   state
+ * @return  size_t
+ */
+size_t Lattice::Hash::operator()(const State& s) const
+{
+	return ((size_t) s.y * 73856093) ^ ((size_t) s.x * 19349663) ^ ((size_t) s.heading * 83492791);
+}
@@ -0,0 +1,240 @@
+/**
+ * Lattice.
+ *
+ * State lattice over a map for robots that cannot turn in place.  A state is
+ * a cell plus one of eight heading bins (45 degrees apart), states are joined
+ * by precomputed motion primitives (straight moves, gentle 45 degree turns
+ * and a reverse move).  Each primitive keeps the cells it sweeps as offsets,
+ * and a reverse index of those offsets tells which states a changed cell
+ * affects, so repairs stay incremental.
+ *
+ * All headings of the goal cell lead to a virtual goal state with heading
+ * ANY, the robot may reach the goal in any heading.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LATTICE_H
+#define DSTARLITE_LATTICE_H
+
+#include <vector>
+
+#include "cost_overlay.h"
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class Lattice
+	{
+		public:
+
+			/**
+			 * State.
+			 */
+			struct State
+			{
+				int x;
+				int y;
+				unsigned int heading;
+
+				bool operator==(const State& s) const;
+			};
+
+			/**
+			 * State hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const State& s) const;
+			};
+
+			/**
+			 * Motion primitive.
+			 */
+			struct Primitive
+			{
+				/**
+				 * @var  unsigned int  start and end heading
+				 */
+				unsigned int from;
+				unsigned int to;
+
+				/**
+				 * @var  int  end cell offset
+				 */
+				int dx;
+				int dy;
+
+				/**
+				 * @var  double  length of the motion (in cells), times any penalty
+				 */
+				double length;
+
+				/**
+				 * @var  vector<pair<int,int>>  swept cells (x, y offsets, start and end included)
+				 */
+				vector<pair<int,int> > footprint;
+			};
+
+			typedef State Vertex;
+			typedef vector<pair<State, double> > Edges;
+
+			/**
+			 * @var  static const unsigned int  number of heading bins
+			 */
+			static const unsigned int HEADINGS;
+
+			/**
+			 * @var  static const unsigned int  heading of the virtual goal state
+			 */
+			static const unsigned int ANY;
+
+			/**
+			 * @var  static const double  cost multiplier of the reverse move
+			 */
+			static const double REVERSE_PENALTY;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*           map
+			 * @param  CostOverlay*   costs
+			 * @param  Map::Cell*     goal cell
+			 */
+			Lattice(Map* map, CostOverlay* overlay, Map::Cell* goal);
+
+			/**
+			 * Gets the states whose outgoing primitives sweep a cell.
+			 *
+			 * @param   Map::Cell*        cell
+			 * @param   vector<State>&    states (appended)
+			 * @return  void
+			 */
+			void affected(Map::Cell* u, vector<State>& states);
+
+			/**
+			 * Gets the virtual goal state.
+			 *
+			 * @return  State
+			 */
+			State goal();
+
+			/**
+			 * Estimates the cost between two states (straight line distance).
+			 *
+			 * @param   State   a
+			 * @param   State   b
+			 * @return  double
+			 */
+			double h(const State& a, const State& b);
+
+			/**
+			 * Gets the heading bin closest to a direction.
+			 *
+			 * @param   int            x offset
+			 * @param   int            y offset
+			 * @return  unsigned int
+			 */
+			static unsigned int heading(int dx, int dy);
+
+			/**
+			 * Gets the predecessors of a state.
+			 *
+			 * @param   State    state
+			 * @param   Edges&   predecessors and primitive costs (appended)
+			 * @return  void
+			 */
+			void pred(const State& u, Edges& edges);
+
+			/**
+			 * Gets the motion primitives.
+			 *
+			 * @return  vector<Primitive>&
+			 */
+			vector<Primitive>& primitives();
+
+			/**
+			 * Makes a state.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   heading
+			 * @return  State
+			 */
+			static State state(Map::Cell* u, unsigned int heading);
+
+			/**
+			 * Gets the successors of a state.
+			 *
+			 * @param   State    state
+			 * @param   Edges&   successors and primitive costs (appended)
+			 * @return  void
+			 */
+			void succ(const State& u, Edges& edges);
+
+		protected:
+
+			/**
+			 * @var  vector<vector<unsigned int>>  primitives by start heading
+			 */
+			vector<vector<unsigned int> > _from;
+
+			/**
+			 * @var  Map::Cell*  goal cell
+			 */
+			Map::Cell* _goal;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  CostOverlay*  costs
+			 */
+			CostOverlay* _overlay;
+
+			/**
+			 * @var  vector<Primitive>  motion primitives
+			 */
+			vector<Primitive> _primitives;
+
+			/**
+			 * @var  vector<vector<pair<int,int>>>  footprint offsets of all primitives by start heading (no duplicates)
+			 */
+			vector<vector<pair<int,int> > > _reverse;
+
+			/**
+			 * @var  vector<vector<unsigned int>>  primitives by end heading
+			 */
+			vector<vector<unsigned int> > _to;
+
+			/**
+			 * Adds a primitive and its three rotations by 90 degrees.
+			 *
+			 * @param   unsigned int   start heading (0 or 1)
+			 * @param   unsigned int   end heading
+			 * @param   int            end x offset
+			 * @param   int            end y offset
+			 * @param   double         cost multiplier
+			 * @return  void
+			 */
+			void _add(unsigned int from, unsigned int to, int dx, int dy, double penalty);
+
+			/**
+			 * Gets the cost of a primitive from a cell.
+			 *
+			 * @param   int            x-coordinate
+			 * @param   int            y-coordinate
+			 * @param   Primitive&     primitive
+			 * @return  double         cost (Math::INF if blocked or off the map)
+			 */
+			double _cost(int x, int y, Primitive& p);
+	};
+};
+
+#endif // DSTARLITE_LATTICE_H
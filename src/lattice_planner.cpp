@@ -0,0 +1,157 @@
+/**
+ * Lattice Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "lattice_planner.h"
+
+/**
+ * Constructor.
+ *
+ * The map is never written, cost updates go into the planner's own overlay.
+ *
+ * @param  Map*           map
+ * @param  Map::Cell*     start cell
+ * @param  unsigned int   start heading
+ * @param  Map::Cell*     goal cell
+ */
+LatticePlanner::LatticePlanner(Map* map, Map::Cell* start, unsigned int heading, Map::Cell* goal)
+{
+	_overlay = new CostOverlay(map);
+	_lattice = new Lattice(map, _overlay, goal);
+	_engine = new Engine<Lattice>(_lattice, Lattice::state(start, heading), _lattice->goal());
+}
+
+/**
+ * Deconstructor.
+ */
+LatticePlanner::~LatticePlanner()
+{
+	delete _engine;
+	delete _lattice;
+	delete _overlay;
+}
+
+/**
+ * Gets the cost of a cell as known by the planner.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double LatticePlanner::cost(Map::Cell* u)
+{
+	return _overlay->cost(u);
+}
+
+/**
+ * Gets the number of states expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int LatticePlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the lattice.
+ *
+ * @return  Lattice*
+ */
+Lattice* LatticePlanner::lattice()
+{
+	return _lattice;
+}
+
+/**
+ * Gets the path from the last replan (without the virtual goal).
+ *
+ * @return  list<Lattice::State>
+ */
+list<Lattice::State> LatticePlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool LatticePlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	_path.pop_back();
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  Lattice::State
+ */
+Lattice::State LatticePlanner::start()
+{
+	return _engine->start();
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   Lattice::State   new start
+ * @return  void
+ */
+void LatticePlanner::start(const Lattice::State& s)
+{
+	_engine->start(s);
+}
+
+/**
+ * Update map.
+ *
+ * @param   Map::Cell*   cell to update
+ * @param   double       new cost of the cell
+ * @return  void
+ */
+void LatticePlanner::update(Map::Cell* u, double cost)
+{
+	if (_overlay->cost(u) == cost)
+		return;
+
+	_overlay->set(u, cost);
+
+	// Only states with a primitive sweeping the cell change
+	_affected.clear();
+	_lattice->affected(u, _affected);
+
+	for (vector<Lattice::State>::iterator it = _affected.begin(); it != _affected.end(); it++)
+	{
+		_engine->update(*it);
+	}
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  void
+ */
+void LatticePlanner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		update(cells[i], costs[i]);
+	}
+}
@@ -0,0 +1,148 @@
+/**
+ * Lattice Planner.
+ *
+ * D* Lite over the heading-aware state lattice.  Uses the same incremental
+ * engine as the grid planner, a cost change only repairs the states whose
+ * primitives sweep the changed cell.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LATTICE_PLANNER_H
+#define DSTARLITE_LATTICE_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "cost_overlay.h"
+#include "engine.h"
+#include "lattice.h"
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class LatticePlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * The map is never written, cost updates go into the planner's own overlay.
+			 *
+			 * @param  Map*           map
+			 * @param  Map::Cell*     start cell
+			 * @param  unsigned int   start heading
+			 * @param  Map::Cell*     goal cell
+			 */
+			LatticePlanner(Map* map, Map::Cell* start, unsigned int heading, Map::Cell* goal);
+
+			/**
+			 * Deconstructor.
+			 */
+			~LatticePlanner();
+
+			/**
+			 * Gets the cost of a cell as known by the planner.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the number of states expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the lattice.
+			 *
+			 * @return  Lattice*
+			 */
+			Lattice* lattice();
+
+			/**
+			 * Gets the path from the last replan (without the virtual goal).
+			 *
+			 * @return  list<Lattice::State>
+			 */
+			list<Lattice::State> path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  Lattice::State
+			 */
+			Lattice::State start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Lattice::State   new start
+			 * @return  void
+			 */
+			void start(const Lattice::State& s);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @param   double       new cost of the cell
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  vector<Lattice::State>  scratch list of affected states
+			 */
+			vector<Lattice::State> _affected;
+
+			/**
+			 * @var  Engine<Lattice>*  D* Lite engine
+			 */
+			Engine<Lattice>* _engine;
+
+			/**
+			 * @var  Lattice*  lattice
+			 */
+			Lattice* _lattice;
+
+			/**
+			 * @var  CostOverlay*  cost changes on top of the map
+			 */
+			CostOverlay* _overlay;
+
+			/**
+			 * @var  list<Lattice::State>  path
+			 */
+			list<Lattice::State> _path;
+	};
+};
+
+#endif // DSTARLITE_LATTICE_PLANNER_H
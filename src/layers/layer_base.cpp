@@ -0,0 +1,79 @@
+/**
+ * Base Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "layer_base.h"
+
+/**
+ * Constructor.
+ *
+ * @param  Map*   map
+ */
+BaseLayer::BaseLayer(Map* map)
+{
+	_map = map;
+	_marked.assign(map->rows() * map->cols(), 0);
+}
+
+/**
+ * Deconstructor.
+ */
+BaseLayer::~BaseLayer()
+{
+
+}
+
+/**
+ * Rebuilds the layer from the layers below and drops all changes.
+ *
+ * @param   Costmap*   costmap
+ * @return  void
+ */
+void BaseLayer::reset(Costmap*)
+{
+	for (vector<Map::Cell*>::iterator it = _dirty.begin(); it != _dirty.end(); it++)
+	{
+		_marked[(*it)->y() * _map->cols() + (*it)->x()] = 0;
+	}
+
+	_dirty.clear();
+}
+
+/**
+ * Appends the cells changed since the last update.
+ *
+ * @param   Costmap*              costmap
+ * @param   vector<Map::Cell*>&   cells changed by the layers below (in), all changed cells (out)
+ * @return  void
+ */
+void BaseLayer::update(Costmap*, vector<Map::Cell*>& dirty)
+{
+	for (vector<Map::Cell*>::iterator it = _dirty.begin(); it != _dirty.end(); it++)
+	{
+		_marked[(*it)->y() * _map->cols() + (*it)->x()] = 0;
+		dirty.push_back(*it);
+	}
+
+	_dirty.clear();
+}
+
+/**
+ * Marks a cell as changed.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void BaseLayer::_touch(Map::Cell* u)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	if (_marked[k])
+		return;
+
+	_marked[k] = 1;
+	_dirty.push_back(u);
+}
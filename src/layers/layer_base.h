@@ -0,0 +1,96 @@
+/**
+ * Base Layer.
+ *
+ * A costmap layer.  Layers are stacked, each one combines its own data with
+ * the cost of the layers below it and keeps track of the cells it changed
+ * since the last costmap update.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_BASE_H
+#define DSTARLITE_LAYER_BASE_H
+
+#include <vector>
+
+#include "../map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class Costmap;
+
+	class BaseLayer
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*   map
+			 */
+			BaseLayer(Map* map);
+
+			/**
+			 * Deconstructor.
+			 */
+			virtual ~BaseLayer();
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   double       cost of the layers below
+			 * @return  double
+			 */
+			virtual double cost(Map::Cell* u, double cost) = 0;
+
+			/**
+			 * Rebuilds the layer from the layers below and drops all changes.
+			 *
+			 * @param   Costmap*   costmap
+			 * @return  void
+			 */
+			virtual void reset(Costmap* costmap);
+
+			/**
+			 * Appends the cells changed since the last update.
+			 *
+			 * @param   Costmap*              costmap
+			 * @param   vector<Map::Cell*>&   cells changed by the layers below (in), all changed cells (out)
+			 * @return  void
+			 */
+			virtual void update(Costmap* costmap, vector<Map::Cell*>& dirty);
+
+		protected:
+
+			/**
+			 * @var  vector<Map::Cell*>  cells changed since the last update
+			 */
+			vector<Map::Cell*> _dirty;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  vector<unsigned char>  cell is in the dirty list
+			 */
+			vector<unsigned char> _marked;
+
+			/**
+			 * Marks a cell as changed.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _touch(Map::Cell* u);
+	};
+};
+
+#endif // DSTARLITE_LAYER_BASE_H
@@ -0,0 +1,168 @@
+/**
+ * Decay Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "layer_decay.h"
+
+/**
+ * @var  static const unsigned int  never expired
+ */
+const unsigned int DecayLayer::NEVER = (unsigned int) -1;
+
+/**
+ * Constructor, no obstacles, walkable cells of the map count as observed free.
+ *
+ * @param  Map*   map
+ */
+DecayLayer::DecayLayer(Map* map) : BaseLayer(map)
+{
+	unsigned int rows = map->rows();
+	unsigned int cols = map->cols();
+
+	_costs.assign(rows * cols, 0.0);
+	_expires.assign(rows * cols, 0);
+	_forgotten.assign(rows * cols, NEVER);
+	_seen.resize(rows * cols);
+	_set.assign(rows * cols, 0);
+	_size = 0;
+	_now = 0;
+
+	for (unsigned int i = 0; i < rows; i++)
+	{
+		for (unsigned int j = 0; j < cols; j++)
+		{
+			_seen[i * cols + j] = (*map)(i, j)->cost != Map::Cell::COST_UNWALKABLE;
+		}
+	}
+}
+
+/**
+ * Removes an obstacle, later obstacles in the cell are transient (observed free).
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void DecayLayer::clear(Map::Cell* u)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	_seen[k] = 1;
+
+	if ( ! _set[k])
+		return;
+
+	// The heap entry goes stale, it is dropped when it comes up
+	_set[k] = 0;
+	_size--;
+	_touch(u);
+}
+
+/**
+ * Combines the layer with the cost of the layers below.
+ *
+ * @see  parent
+ */
+double DecayLayer::cost(Map::Cell* u, double cost)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	return _set[k] ? _costs[k] : cost;
+}
+
+/**
+ * Removes all obstacles that expired, their cells revert to the cost of the layers below.
+ *
+ * @param   unsigned int          current time
+ * @param   vector<Map::Cell*>&   expired cells (appended)
+ * @return  unsigned int          number expired
+ */
+unsigned int DecayLayer::expire(unsigned int now, vector<Map::Cell*>& expired)
+{
+	unsigned int count = 0;
+	unsigned int cols = _map->cols();
+
+	_now = now;
+
+	while ( ! _queue.empty() && _queue.top().first <= now)
+	{
+		Q_PAIR top = _queue.top();
+		_queue.pop();
+
+		unsigned int k = top.second;
+
+		// Cleared or refreshed since this entry was pushed
+		if ( ! _set[k] || _expires[k] != top.first)
+			continue;
+
+		Map::Cell* u = (*_map)(k / cols, k % cols);
+
+		// Found here again later, the obstacle did not move
+		_set[k] = 0;
+		_seen[k] = 0;
+		_forgotten[k] = now;
+		_size--;
+		_touch(u);
+
+		expired.push_back(u);
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * Marks an obstacle, or refreshes it if marked already.
+ *
+ * The expiration time is ignored for walls: cells not observed free since
+ * they last expired, unless they expired just now (still in view).
+ *
+ * @param   Map::Cell*     cell
+ * @param   double         cost
+ * @param   unsigned int   expiration time
+ * @return  void
+ */
+void DecayLayer::mark(Map::Cell* u, double cost, unsigned int expires)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	// Refreshed with the same time, the pending heap entry still holds
+	bool pending = _set[k] && _expires[k] == expires;
+
+	if ( ! _set[k] || _costs[k] != cost)
+	{
+		_touch(u);
+	}
+
+	if ( ! _set[k])
+	{
+		_set[k] = 1;
+		_size++;
+	}
+
+	_costs[k] = cost;
+
+	// A wall, it is kept until observed free
+	if ( ! _seen[k] && _forgotten[k] != _now)
+		return;
+
+	// Older entries of this cell go stale
+	if ( ! pending)
+	{
+		_expires[k] = expires;
+		_queue.push(Q_PAIR(expires, k));
+	}
+}
+
+/**
+ * Gets the number of marked obstacles (walls included).
+ *
+ * @return  unsigned int
+ */
+unsigned int DecayLayer::size()
+{
+	return _size;
+}
@@ -0,0 +1,139 @@
+/**
+ * Decay Layer.
+ *
+ * Transient obstacles (people, carts...) that expire unless they are
+ * observed again.  Expiration times are kept in a min-heap with lazy
+ * deletion, re-marking a cell just pushes a newer entry, so expiring costs
+ * O(expired) per tick instead of a scan over all marked cells.
+ * Cells walkable in the map the layer is built on count as observed free.
+ * An obstacle found in a cell observed free is transient.  Once expired, the
+ * cell no longer counts as observed free: if the obstacle is found there
+ * again (other than right away, while still in view) it did not move, it is
+ * a wall and is kept until the cell is observed free.  So a cell expires at
+ * most once between free observations, and the robot cannot keep going back
+ * to walls it forgot.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_DECAY_H
+#define DSTARLITE_LAYER_DECAY_H
+
+#include <functional>
+#include <queue>
+
+#include "layer_base.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class DecayLayer : public BaseLayer
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  never expired
+			 */
+			static const unsigned int NEVER;
+
+			/**
+			 * Constructor, no obstacles, walkable cells of the map count as observed free.
+			 *
+			 * @param  Map*   map
+			 */
+			DecayLayer(Map* map);
+
+			/**
+			 * Removes an obstacle, later obstacles in the cell are transient (observed free).
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void clear(Map::Cell* u);
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * @see  parent
+			 */
+			virtual double cost(Map::Cell* u, double cost);
+
+			/**
+			 * Removes all obstacles that expired, their cells revert to the cost of the layers below.
+			 *
+			 * @param   unsigned int          current time
+			 * @param   vector<Map::Cell*>&   expired cells (appended)
+			 * @return  unsigned int          number expired
+			 */
+			unsigned int expire(unsigned int now, vector<Map::Cell*>& expired);
+
+			/**
+			 * Marks an obstacle, or refreshes it if marked already.
+			 *
+			 * The expiration time is ignored for walls (see above).
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   double         cost
+			 * @param   unsigned int   expiration time
+			 * @return  void
+			 */
+			void mark(Map::Cell* u, double cost, unsigned int expires);
+
+			/**
+			 * Gets the number of marked obstacles (walls included).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+		protected:
+
+			/**
+			 * @var  vector<double>  obstacle costs
+			 */
+			vector<double> _costs;
+
+			/**
+			 * @var  vector<unsigned int>  expiration time of each cell (only valid if marked)
+			 */
+			vector<unsigned int> _expires;
+
+			/**
+			 * @var  vector<unsigned int>  time of the last expiration of each cell (NEVER if none)
+			 */
+			vector<unsigned int> _forgotten;
+
+			/**
+			 * @var  unsigned int  time of the last expire()
+			 */
+			unsigned int _now;
+
+			/**
+			 * @var  min-heap of (expiration time, cell index), stale entries are skipped
+			 */
+			typedef pair<unsigned int, unsigned int> Q_PAIR;
+			typedef priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > Q;
+			Q _queue;
+
+			/**
+			 * @var  vector<unsigned char>  cell was observed free since its last expiration (its obstacles expire)
+			 */
+			vector<unsigned char> _seen;
+
+			/**
+			 * @var  vector<unsigned char>  cell holds an obstacle
+			 */
+			vector<unsigned char> _set;
+
+			/**
+			 * @var  unsigned int  number of marked obstacles
+			 */
+			unsigned int _size;
+	};
+};
+
+#endif // DSTARLITE_LAYER_DECAY_H
@@ -0,0 +1,111 @@
+/**
+ * Inflation Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cmath>
+
+#include "../costmap.h"
+#include "layer_inflation.h"
+
+/**
+ * Constructor.
+ *
+ * @param  Map*     map
+ * @param  double   robot radius (in cells)
+ * @param  double   extra cost of a cell touching an obstacle
+ */
+InflationLayer::InflationLayer(Map* map, double radius, double penalty) : BaseLayer(map)
+{
+	_radius = radius;
+	_penalty = penalty;
+	// Distances past the inflated band are never needed
+	_distance = new DistanceMap(map, (int) ceil((radius + 1.0) * (radius + 1.0)));
+}
+
+/**
+ * Deconstructor.
+ */
+InflationLayer::~InflationLayer()
+{
+	delete _distance;
+}
+
+/**
+ * Combines the layer with the cost of the layers below.
+ *
+ * The extra cost falls off with the distance, it stays finite so a
+ * robot next to a newly found obstacle can still move away from it.
+ *
+ * @see  parent
+ */
+double InflationLayer::cost(Map::Cell* u, double cost)
+{
+	if (cost == Map::Cell::COST_UNWALKABLE)
+		return cost;
+
+	double d = _distance->distance(u);
+
+	if (d <= _radius)
+	{
+		cost += _penalty * (_radius + 1.0 - d) / _radius;
+	}
+
+	return cost;
+}
+
+/**
+ * Rebuilds the layer from the layers below and drops all changes.
+ *
+ * @see  parent
+ */
+void InflationLayer::reset(Costmap* costmap)
+{
+	for (unsigned int i = 0; i < _map->rows(); i++)
+	{
+		for (unsigned int j = 0; j < _map->cols(); j++)
+		{
+			Map::Cell* u = (*_map)(i, j);
+			_distance->set(u, costmap->cost(u, this) == Map::Cell::COST_UNWALKABLE);
+		}
+	}
+
+	_distance->update(_changed, _changed_before);
+	_changed.clear();
+	_changed_before.clear();
+
+	BaseLayer::reset(costmap);
+}
+
+/**
+ * Appends the cells changed since the last update.
+ *
+ * @see  parent
+ */
+void InflationLayer::update(Costmap* costmap, vector<Map::Cell*>& dirty)
+{
+	// Only cells changed below can add or remove an obstacle
+	for (unsigned int i = 0; i < dirty.size(); i++)
+	{
+		_distance->set(dirty[i], costmap->cost(dirty[i], this) == Map::Cell::COST_UNWALKABLE);
+	}
+
+	_distance->update(_changed, _changed_before);
+
+	// The extra cost only changes if the cell is or was within the radius
+	for (unsigned int i = 0; i < _changed.size(); i++)
+	{
+		if (_changed_before[i] <= _radius || _distance->distance(_changed[i]) <= _radius)
+		{
+			_touch(_changed[i]);
+		}
+	}
+
+	_changed.clear();
+	_changed_before.clear();
+
+	BaseLayer::update(costmap, dirty);
+}
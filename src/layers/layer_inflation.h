@@ -0,0 +1,94 @@
+/**
+ * Inflation Layer.
+ *
+ * Adds an extra cost to cells within the robot radius of an obstacle of the
+ * layers below.  Obstacle distances are kept in a distance map, so a changed
+ * obstacle only re-inflates the cells around it.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_INFLATION_H
+#define DSTARLITE_LAYER_INFLATION_H
+
+#include "../distance_map.h"
+#include "layer_base.h"
+
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class InflationLayer : public BaseLayer
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*     map
+			 * @param  double   robot radius (in cells)
+			 * @param  double   extra cost of a cell touching an obstacle
+			 */
+			InflationLayer(Map* map, double radius, double penalty);
+
+			/**
+			 * Deconstructor.
+			 */
+			virtual ~InflationLayer();
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * The extra cost falls off with the distance, it stays finite so a
+			 * robot next to a newly found obstacle can still move away from it.
+			 *
+			 * @see  parent
+			 */
+			virtual double cost(Map::Cell* u, double cost);
+
+			/**
+			 * Rebuilds the layer from the layers below and drops all changes.
+			 *
+			 * @see  parent
+			 */
+			virtual void reset(Costmap* costmap);
+
+			/**
+			 * Appends the cells changed since the last update.
+			 *
+			 * @see  parent
+			 */
+			virtual void update(Costmap* costmap, vector<Map::Cell*>& dirty);
+
+		protected:
+
+			/**
+			 * @var  DistanceMap*  distance of each cell to the closest obstacle below
+			 */
+			DistanceMap* _distance;
+
+			/**
+			 * @var  double  extra cost of a cell touching an obstacle
+			 */
+			double _penalty;
+
+			/**
+			 * @var  double  robot radius (in cells)
+			 */
+			double _radius;
+
+			/**
+			 * @var  vector<Map::Cell*>  cells whose obstacle distance changed
+			 */
+			vector<Map::Cell*> _changed;
+
+			/**
+			 * @var  vector<double>  obstacle distances of the changed cells before the change
+			 */
+			vector<double> _changed_before;
+	};
+};
+
+#endif // DSTARLITE_LAYER_INFLATION_H
@@ -0,0 +1,92 @@
+/**
+ * Keep Out Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "layer_keep_out.h"
+
+/**
+ * Constructor, no zones.
+ *
+ * @param  Map*   map
+ */
+KeepOutLayer::KeepOutLayer(Map* map) : BaseLayer(map)
+{
+	_zones.assign(map->rows() * map->cols(), 0);
+}
+
+/**
+ * Adds a zone (zones may overlap).
+ *
+ * @param   Map::Cell*   corner
+ * @param   Map::Cell*   opposite corner
+ * @return  void
+ */
+void KeepOutLayer::add(Map::Cell* a, Map::Cell* b)
+{
+	_cover(a, b, 1);
+}
+
+/**
+ * Combines the layer with the cost of the layers below.
+ *
+ * @see  parent
+ */
+double KeepOutLayer::cost(Map::Cell* u, double cost)
+{
+	if (_zones[u->y() * _map->cols() + u->x()] > 0)
+		return Map::Cell::COST_UNWALKABLE;
+
+	return cost;
+}
+
+/**
+ * Removes a zone added before.
+ *
+ * @param   Map::Cell*   corner
+ * @param   Map::Cell*   opposite corner
+ * @return  void
+ */
+void KeepOutLayer::remove(Map::Cell* a, Map::Cell* b)
+{
+	_cover(a, b, -1);
+}
+
+/**
+ * Adds to the zone count of every cell of a rectangle.
+ *
+ * @param   Map::Cell*   corner
+ * @param   Map::Cell*   opposite corner
+ * @param   int          count change
+ * @return  void
+ */
+void KeepOutLayer::_cover(Map::Cell* a, Map::Cell* b, int count)
+{
+	unsigned int x0 = min(a->x(), b->x());
+	unsigned int x1 = max(a->x(), b->x());
+	unsigned int y0 = min(a->y(), b->y());
+	unsigned int y1 = max(a->y(), b->y());
+
+	unsigned int cols = _map->cols();
+
+	for (unsigned int i = y0; i <= y1; i++)
+	{
+		for (unsigned int j = x0; j <= x1; j++)
+		{
+			unsigned int k = i * cols + j;
+
+			// Only the first zone in and the last zone out change the cost
+			if ((count > 0 && _zones[k] == 0) || (count < 0 && _zones[k] == 1))
+			{
+				_touch((*_map)(i, j));
+			}
+
+			_zones[k] += count;
+		}
+	}
+}
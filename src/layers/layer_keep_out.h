@@ -0,0 +1,75 @@
+/**
+ * Keep Out Layer.
+ *
+ * Rectangular zones the robot must not enter, whatever the layers below say.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_KEEP_OUT_H
+#define DSTARLITE_LAYER_KEEP_OUT_H
+
+#include "layer_base.h"
+
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class KeepOutLayer : public BaseLayer
+	{
+		public:
+
+			/**
+			 * Constructor, no zones.
+			 *
+			 * @param  Map*   map
+			 */
+			KeepOutLayer(Map* map);
+
+			/**
+			 * Adds a zone (zones may overlap).
+			 *
+			 * @param   Map::Cell*   corner
+			 * @param   Map::Cell*   opposite corner
+			 * @return  void
+			 */
+			void add(Map::Cell* a, Map::Cell* b);
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * @see  parent
+			 */
+			virtual double cost(Map::Cell* u, double cost);
+
+			/**
+			 * Removes a zone added before.
+			 *
+			 * @param   Map::Cell*   corner
+			 * @param   Map::Cell*   opposite corner
+			 * @return  void
+			 */
+			void remove(Map::Cell* a, Map::Cell* b);
+
+		protected:
+
+			/**
+			 * @var  vector<unsigned int>  number of zones covering each cell
+			 */
+			vector<unsigned int> _zones;
+
+			/**
+			 * Adds to the zone count of every cell of a rectangle.
+			 *
+			 * @param   Map::Cell*   corner
+			 * @param   Map::Cell*   opposite corner
+			 * @param   int          count change
+			 * @return  void
+			 */
+			void _cover(Map::Cell* a, Map::Cell* b, int count);
+	};
+};
+
+#endif // DSTARLITE_LAYER_KEEP_OUT_H
@@ -0,0 +1,65 @@
+/**
+ * Sensor Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "layer_sensor.h"
+
+/**
+ * @var  static const double  no observation
+ */
+const double SensorLayer::UNKNOWN = -1.0;
+
+/**
+ * Constructor, nothing observed.
+ *
+ * @param  Map*   map
+ */
+SensorLayer::SensorLayer(Map* map) : BaseLayer(map)
+{
+	_costs.assign(map->rows() * map->cols(), UNKNOWN);
+}
+
+/**
+ * Forgets the observation of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void SensorLayer::clear(Map::Cell* u)
+{
+	set(u, UNKNOWN);
+}
+
+/**
+ * Combines the layer with the cost of the layers below.
+ *
+ * @see  parent
+ */
+double SensorLayer::cost(Map::Cell* u, double cost)
+{
+	double v = _costs[u->y() * _map->cols() + u->x()];
+
+	return (v == UNKNOWN) ? cost : v;
+}
+
+/**
+ * Records the observed cost of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @param   double       cost
+ * @return  void
+ */
+void SensorLayer::set(Map::Cell* u, double cost)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	if (_costs[k] == cost)
+		return;
+
+	_costs[k] = cost;
+	_touch(u);
+}
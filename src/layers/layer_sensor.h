@@ -0,0 +1,69 @@
+/**
+ * Sensor Layer.
+ *
+ * Costs observed by the robot, they override the layers below.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_SENSOR_H
+#define DSTARLITE_LAYER_SENSOR_H
+
+#include "layer_base.h"
+
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class SensorLayer : public BaseLayer
+	{
+		public:
+
+			/**
+			 * @var  static const double  no observation
+			 */
+			static const double UNKNOWN;
+
+			/**
+			 * Constructor, nothing observed.
+			 *
+			 * @param  Map*   map
+			 */
+			SensorLayer(Map* map);
+
+			/**
+			 * Forgets the observation of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void clear(Map::Cell* u);
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * @see  parent
+			 */
+			virtual double cost(Map::Cell* u, double cost);
+
+			/**
+			 * Records the observed cost of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   double       cost
+			 * @return  void
+			 */
+			void set(Map::Cell* u, double cost);
+
+		protected:
+
+			/**
+			 * @var  vector<double>  observed costs (UNKNOWN if never observed)
+			 */
+			vector<double> _costs;
+	};
+};
+
+#endif // DSTARLITE_LAYER_SENSOR_H
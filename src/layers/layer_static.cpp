@@ -0,0 +1,58 @@
+/**
+ * Static Layer.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "layer_static.h"
+
+/**
+ * Constructor, copies the current costs of the map.
+ *
+ * @param  Map*   map
+ */
+StaticLayer::StaticLayer(Map* map) : BaseLayer(map)
+{
+	unsigned int rows = map->rows();
+	unsigned int cols = map->cols();
+
+	_costs.resize(rows * cols);
+
+	for (unsigned int i = 0; i < rows; i++)
+	{
+		for (unsigned int j = 0; j < cols; j++)
+		{
+			_costs[i * cols + j] = (*map)(i, j)->cost;
+		}
+	}
+}
+
+/**
+ * Combines the layer with the cost of the layers below.
+ *
+ * @see  parent
+ */
+double StaticLayer::cost(Map::Cell* u, double)
+{
+	return _costs[u->y() * _map->cols() + u->x()];
+}
+
+/**
+ * Sets the prior cost of a cell.
+ *
+ * @param   Map::Cell*   cell
+ * @param   double       cost
+ * @return  void
+ */
+void StaticLayer::set(Map::Cell* u, double cost)
+{
+	unsigned int k = u->y() * _map->cols() + u->x();
+
+	if (_costs[k] == cost)
+		return;
+
+	_costs[k] = cost;
+	_touch(u);
+}
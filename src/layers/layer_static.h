@@ -0,0 +1,56 @@
+/**
+ * Static Layer.
+ *
+ * Prior knowledge of the map, the bottom layer of a costmap.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LAYER_STATIC_H
+#define DSTARLITE_LAYER_STATIC_H
+
+#include "layer_base.h"
+
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class StaticLayer : public BaseLayer
+	{
+		public:
+
+			/**
+			 * Constructor, copies the current costs of the map.
+			 *
+			 * @param  Map*   map
+			 */
+			StaticLayer(Map* map);
+
+			/**
+			 * Combines the layer with the cost of the layers below.
+			 *
+			 * @see  parent
+			 */
+			virtual double cost(Map::Cell* u, double cost);
+
+			/**
+			 * Sets the prior cost of a cell.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @param   double       cost
+			 * @return  void
+			 */
+			void set(Map::Cell* u, double cost);
+
+		protected:
+
+			/**
+			 * @var  vector<double>  costs
+			 */
+			vector<double> _costs;
+	};
+};
+
+#endif // DSTARLITE_LAYER_STATIC_H
@@ -0,0 +1,302 @@
+/**
+ * Line Of Sight.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "line_of_sight.h"
+
+/**
+ * Constructor, copies the costs of the map.
+ *
+ * @param  Map*   map
+ */
+LineOfSight::LineOfSight(Map* map)
+{
+	_cols = map->cols();
+	_rows = map->rows();
+
+	_costs.resize(_rows * _cols);
+
+	for (unsigned int i = 0; i < _rows; i++)
+	{
+		for (unsigned int j = 0; j < _cols; j++)
+		{
+			_costs[i * _cols + j] = (*map)(i, j)->cost;
+		}
+	}
+}
+
+/**
+ * Gets the cost of a cell.
+ *
+ * @param   int      x-coordinate
+ * @param   int      y-coordinate
+ * @return  double   cost (COST_UNWALKABLE off the map)
+ */
+double LineOfSight::cell(int x, int y)
+{
+	if (x < 0 || y < 0 || x >= (int) _cols || y >= (int) _rows)
+		return Map::Cell::COST_UNWALKABLE;
+
+	return _costs[y * _cols + x];
+}
+
+/**
+ * Sets the cost of a cell.
+ *
+ * @param   unsigned int   x-coordinate
+ * @param   unsigned int   y-coordinate
+ * @param   double         cost
+ * @return  void
+ */
+void LineOfSight::cell(unsigned int x, unsigned int y, double cost)
+{
+	_costs[y * _cols + x] = cost;
+}
+
+/**
+ * Gets the number of cols.
+ *
+ * @return  unsigned int
+ */
+unsigned int LineOfSight::cols()
+{
+	return _cols;
+}
+
+/**
+ * Gets the cost of a straight move, the length through each cell times its cost.
+ *
+ * The ends are put in order first, so the cost is the same both ways.
+ *
+ * @param   int                               x of the first point (doubled)
+ * @param   int                               y of the first point (doubled)
+ * @param   int                               x of the second point (doubled)
+ * @param   int                               y of the second point (doubled)
+ * @param   vector<unsigned int>* [optional]  indices of the cells crossed, blocked or not (appended)
+ * @return  double                            cost (Math::INF if blocked)
+ */
+double LineOfSight::line(int x0, int y0, int x1, int y1, vector<unsigned int>* cells)
+{
+	if (x0 == x1 && y0 == y1)
+		return 0.0;
+
+	if (x0 == x1)
+		return _axis(x0, min(y0, y1), max(y0, y1), true, cells);
+
+	if (y0 == y1)
+		return _axis(y0, min(x0, x1), max(x0, x1), false, cells);
+
+	// Left to right
+	if (x1 < x0)
+	{
+		swap(x0, x1);
+		swap(y0, y1);
+	}
+
+	int sy = (y1 > y0) ? 1 : -1;
+
+	long long dx = x1 - x0;
+	long long dy = (y1 > y0) ? y1 - y0 : y0 - y1;
+
+	// First and last cell, corners leave into the cell ahead
+	int cx = (x0 % 2) ? (x0 - 1) / 2 : x0 / 2;
+	int cy = (y0 % 2) ? (y0 - 1) / 2 : ((sy > 0) ? y0 / 2 : y0 / 2 - 1);
+	int ex = (x1 % 2) ? (x1 - 1) / 2 : x1 / 2 - 1;
+	int ey = (y1 % 2) ? (y1 - 1) / 2 : ((sy > 0) ? y1 / 2 - 1 : y1 / 2);
+
+	bool blocked = false;
+	double sum = 0.0;
+	double t_prev = 0.0;
+
+	while (true)
+	{
+		double w = _weight(cx, cy, cells);
+
+		if (w == Math::INF)
+		{
+			if (cells == NULL)
+				return Math::INF;
+
+			blocked = true;
+		}
+
+		if ((cx == ex && cy == ey) || cx > ex)
+		{
+			if ( ! blocked)
+			{
+				sum += (1.0 - t_prev) * w;
+			}
+
+			break;
+		}
+
+		// Distances to the next column and row lines, compared as t = n / d
+		long long nx = 2 * (cx + 1) - x0;
+		long long ny = (sy > 0) ? 2 * (cy + 1) - y0 : y0 - 2 * cy;
+
+		double t;
+
+		if (nx * dy < ny * dx)
+		{
+			t = (double) nx / dx;
+			cx++;
+		}
+		else if (nx * dy > ny * dx)
+		{
+			t = (double) ny / dy;
+			cy += sy;
+		}
+		else
+		{
+			// Through a corner, not between two walls
+			t = (double) nx / dx;
+
+			double w1 = _weight(cx + 1, cy, cells);
+			double w2 = _weight(cx, cy + sy, cells);
+
+			if (w1 == Math::INF && w2 == Math::INF)
+			{
+				if (cells == NULL)
+					return Math::INF;
+
+				blocked = true;
+			}
+
+			cx++;
+			cy += sy;
+		}
+
+		if ( ! blocked)
+		{
+			sum += (t - t_prev) * w;
+		}
+
+		t_prev = t;
+	}
+
+	if (blocked)
+		return Math::INF;
+
+	return sum * sqrt((double) (dx * dx + dy * dy)) / 2.0;
+}
+
+/**
+ * Gets the number of rows.
+ *
+ * @return  unsigned int
+ */
+unsigned int LineOfSight::rows()
+{
+	return _rows;
+}
+
+/**
+ * Checks if a segment touches a cell (sides and corners included).
+ *
+ * @param   int    x of the first point (doubled)
+ * @param   int    y of the first point (doubled)
+ * @param   int    x of the second point (doubled)
+ * @param   int    y of the second point (doubled)
+ * @param   int    x-coordinate of the cell
+ * @param   int    y-coordinate of the cell
+ * @return  bool
+ */
+bool LineOfSight::touches(int x0, int y0, int x1, int y1, int x, int y)
+{
+	long long left = 2 * x, top = 2 * y, right = left + 2, bottom = top + 2;
+
+	if (max(x0, x1) < left || min(x0, x1) > right || max(y0, y1) < top || min(y0, y1) > bottom)
+		return false;
+
+	// Corners of the cell on both sides of the line, or on it
+	long long dx = x1 - x0;
+	long long dy = y1 - y0;
+
+	bool below = false, above = false;
+
+	for (int j = 0; j < 4; j++)
+	{
+		long long side = dx * (((j / 2) ? bottom : top) - y0) - dy * (((j % 2) ? right : left) - x0);
+
+		below = below || side <= 0;
+		above = above || side >= 0;
+	}
+
+	return below && above;
+}
+
+/**
+ * Gets the cost of a move along a row or a column.
+ *
+ * On a cell side the cheaper of the two cells counts.
+ *
+ * @param   int                     fixed coordinate (doubled)
+ * @param   int                     first moving coordinate (doubled)
+ * @param   int                     last moving coordinate (doubled, not less than the first)
+ * @param   bool                    along a column
+ * @param   vector<unsigned int>*   cells crossed (appended, if not NULL)
+ * @return  double                  cost (Math::INF if blocked)
+ */
+double LineOfSight::_axis(int fixed, int from, int to, bool column, vector<unsigned int>* cells)
+{
+	bool blocked = false;
+	double sum = 0.0;
+
+	// Lines of cells on either side (the same one through centers)
+	int a = (fixed % 2) ? (fixed - 1) / 2 : fixed / 2 - 1;
+	int b = (fixed % 2) ? a : a + 1;
+
+	for (int k = from / 2; 2 * k < to; k++)
+	{
+		double overlap = (min(to, 2 * k + 2) - max(from, 2 * k)) / 2.0;
+
+		double w = column ? _weight(a, k, cells) : _weight(k, a, cells);
+
+		if (b != a)
+		{
+			w = min(w, column ? _weight(b, k, cells) : _weight(k, b, cells));
+		}
+
+		if (w == Math::INF)
+		{
+			if (cells == NULL)
+				return Math::INF;
+
+			blocked = true;
+			continue;
+		}
+
+		sum += overlap * w;
+	}
+
+	return blocked ? Math::INF : sum;
+}
+
+/**
+ * Gets the cost per unit of length of a cell (Math::INF if unwalkable).
+ *
+ * @param   int                     x-coordinate
+ * @param   int                     y-coordinate
+ * @param   vector<unsigned int>*   cells crossed (appended, if not NULL and on the map)
+ * @return  double
+ */
+double LineOfSight::_weight(int x, int y, vector<unsigned int>* cells)
+{
+	if (x < 0 || y < 0 || x >= (int) _cols || y >= (int) _rows)
+		return Math::INF;
+
+	if (cells != NULL)
+	{
+		cells->push_back(y * _cols + x);
+	}
+
+	double cost = _costs[y * _cols + x];
+
+	return (cost == Map::Cell::COST_UNWALKABLE) ? Math::INF : cost;
+}
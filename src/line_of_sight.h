@@ -0,0 +1,138 @@
+/**
+ * Line Of Sight.
+ *
+ * Straight moves over a grid, for planners whose paths are not bound to the
+ * eight neighbors.  Keeps the costs of the map in one row-major block (the
+ * map itself allocates every cell on its own) and walks a segment through
+ * the cells it crosses, in order, with exact integer steps.
+ *
+ * Points are in doubled coordinates, so cell corners are even and cell
+ * centers odd.  A segment may run along a cell side if one of the two
+ * cells is walkable, and may pass through a corner unless both cells
+ * across it are unwalkable; off the map counts as unwalkable.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_LINE_OF_SIGHT_H
+#define DSTARLITE_LINE_OF_SIGHT_H
+
+#include <vector>
+
+#include "map.h"
+#include "math.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class LineOfSight
+	{
+		public:
+
+			/**
+			 * Constructor, copies the costs of the map.
+			 *
+			 * @param  Map*   map
+			 */
+			LineOfSight(Map* map);
+
+			/**
+			 * Gets the cost of a cell.
+			 *
+			 * @param   int      x-coordinate
+			 * @param   int      y-coordinate
+			 * @return  double   cost (COST_UNWALKABLE off the map)
+			 */
+			double cell(int x, int y);
+
+			/**
+			 * Sets the cost of a cell.
+			 *
+			 * @param   unsigned int   x-coordinate
+			 * @param   unsigned int   y-coordinate
+			 * @param   double         cost
+			 * @return  void
+			 */
+			void cell(unsigned int x, unsigned int y, double cost);
+
+			/**
+			 * Gets the number of cols.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int cols();
+
+			/**
+			 * Gets the cost of a straight move, the length through each cell times its cost.
+			 *
+			 * @param   int                               x of the first point (doubled)
+			 * @param   int                               y of the first point (doubled)
+			 * @param   int                               x of the second point (doubled)
+			 * @param   int                               y of the second point (doubled)
+			 * @param   vector<unsigned int>* [optional]  indices of the cells crossed, blocked or not (appended)
+			 * @return  double                            cost (Math::INF if blocked)
+			 */
+			double line(int x0, int y0, int x1, int y1, vector<unsigned int>* cells = NULL);
+
+			/**
+			 * Checks if a segment touches a cell (sides and corners included).
+			 *
+			 * @param   int    x of the first point (doubled)
+			 * @param   int    y of the first point (doubled)
+			 * @param   int    x of the second point (doubled)
+			 * @param   int    y of the second point (doubled)
+			 * @param   int    x-coordinate of the cell
+			 * @param   int    y-coordinate of the cell
+			 * @return  bool
+			 */
+			static bool touches(int x0, int y0, int x1, int y1, int x, int y);
+
+			/**
+			 * Gets the number of rows.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int rows();
+
+		protected:
+
+			/**
+			 * @var  unsigned int  map size
+			 */
+			unsigned int _cols;
+			unsigned int _rows;
+
+			/**
+			 * @var  vector<double>  cost of each cell, row-major
+			 */
+			vector<double> _costs;
+
+			/**
+			 * Gets the cost of a move along a row or a column.
+			 *
+			 * @param   int                     fixed coordinate (doubled)
+			 * @param   int                     first moving coordinate (doubled)
+			 * @param   int                     last moving coordinate (doubled, not less than the first)
+			 * @param   bool                    along a column
+			 * @param   vector<unsigned int>*   cells crossed (appended, if not NULL)
+			 * @return  double                  cost (Math::INF if blocked)
+			 */
+			double _axis(int fixed, int from, int to, bool column, vector<unsigned int>* cells);
+
+			/**
+			 * Gets the cost per unit of length of a cell (Math::INF if unwalkable).
+			 *
+			 * @param   int                     x-coordinate
+			 * @param   int                     y-coordinate
+			 * @param   vector<unsigned int>*   cells crossed (appended, if not NULL and on the map)
+			 * @return  double
+			 */
+			double _weight(int x, int y, vector<unsigned int>* cells);
+	};
+};
+
+#endif // DSTARLITE_LINE_OF_SIGHT_H
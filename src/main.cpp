@@ -1,6 +1,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "simulator.h"
 
@@ -14,7 +15,7 @@
 int main(int argc, char **argv)
 {
 	// Make sure we have the minimum number of arguments
-	if (argc != 9)
+	if (argc < 9)
 	{
 		printf("Not enough arguments: %d", argc);
 		throw;
@@ -37,6 +38,52 @@ int main(int argc, char **argv)
 	// Robot scan radius
 	config.scan_radius = atoi(argv[8]);
 
+	// Optional flags
+	for (int i = 9; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--index") == 0)
+		{
+			config.index = true;
+		}
+		else if (strcmp(argv[i], "--fast-forward") == 0)
+		{
+			config.fast_forward = true;
+		}
+		else if (strcmp(argv[i], "--lattice") == 0)
+		{
+			config.lattice = true;
+		}
+		else if (strcmp(argv[i], "--inflate") == 0)
+		{
+			config.inflate = true;
+		}
+		else if (strncmp(argv[i], "--decay=", 8) == 0)
+		{
+			config.decay = atoi(argv[i] + 8);
+		}
+		else if (strncmp(argv[i], "--keep-out=", 11) == 0)
+		{
+			unsigned int zone[4];
+
+			if (sscanf(argv[i] + 11, "%u,%u,%u,%u", &zone[0], &zone[1], &zone[2], &zone[3]) != 4)
+			{
+				printf("Invalid keep out zone: %s", argv[i]);
+				throw;
+			}
+
+			config.keep_out.insert(config.keep_out.end(), zone, zone + 4);
+		}
+		else if (strncmp(argv[i], "--beams=", 8) == 0)
+		{
+			config.beams = atoi(argv[i] + 8);
+		}
+		else
+		{
+			printf("Unknown option: %s", argv[i]);
+			throw;
+		}
+	}
+
 	// Build the simulator and draw
 	Simulator sim = Simulator(argv[1], config);
 	sim.draw();
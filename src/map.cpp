@@ -14,7 +14,7 @@ using namespace DStarLite;
 /**
  * @var  unsigned int  number of cell neighbors
  */
-const unsigned int Map::Cell::NUM_NBRS = 8;
+const unsigned int Map::Cell::NUM_NBRS;
 
 /**
  * @var  double  cost of an unwalkable tile
@@ -56,61 +56,22 @@ Map::Map(unsigned int rows, unsigned int cols)
 		for (unsigned int j = 0; j < cols; j++)
 		{
 			Cell** nbrs = new Cell*[Cell::NUM_NBRS];
+
 			for (unsigned int k = 0; k < Cell::NUM_NBRS; k++)
 			{
-				nbrs[k] = NULL;
-			}
+				int y = (int) i + Neighborhood::DY[k];
+				int x = (int) j + Neighborhood::DX[k];
 
-			// Top
-			if (i != 0)
-			{
-				if (j != 0)
+				if (y < 0 || y >= (int) rows || x < 0 || x >= (int) cols)
 				{
-					// Top left
-					nbrs[0] = _cells[i - 1][j - 1];
+					nbrs[k] = NULL;
 				}
-
-				// Top middle
-				nbrs[1] = _cells[i - 1][j];
-
-				if (j < cols - 1)
+				else
 				{
-					// Top right
-					nbrs[2] = _cells[i - 1][j + 1];
+					nbrs[k] = _cells[y][x];
 				}
 			}
 
-			if (j < cols - 1)
-			{
-				// Middle right
-				nbrs[3] = _cells[i][j + 1];
-			}
-			
-			// Bottom
-			if (i < rows - 1)
-			{
-				if (j < cols - 1)
-				{
-					// Bottom right
-					nbrs[4] = _cells[i + 1][j + 1];
-				}
-
-				// Bottom middle
-				nbrs[5] = _cells[i + 1][j];
-
-				if (j != 0)
-				{
-					// Bottom left
-					nbrs[6] = _cells[i + 1][j - 1];
-				}
-			}
-
-			if (j != 0)
-			{
-				// Middle left
-				nbrs[7] = _cells[i][j - 1];
-			}
-
 			_cells[i][j]->init(nbrs);
 		}
 	}
@@ -165,7 +126,7 @@ unsigned int Map::cols()
  */
 bool Map::has(unsigned int row, unsigned int col)
 {
-	return (row >= 0 && row < _rows && col >= 0 && col < _cols);
+	return (row < _rows && col < _cols);
 }
 
 /**
@@ -12,6 +12,7 @@
 #include <functional>
 #include <stdlib.h>
 
+#include "connectivity.h"
 #include "math.h"
 
 using namespace std;
@@ -48,9 +49,9 @@ namespace DStarLite
 					};
 
 					/**
-					 * @var  static const int  number of cell neighbors
+					 * @var  static const int  number of cell neighbors (see Neighborhood)
 					 */
-					static const unsigned int NUM_NBRS;
+					static const unsigned int NUM_NBRS = Neighborhood::SIZE;
 
 					/**
 					 * @var  static const double  cost of an unwalkable cell
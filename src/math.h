@@ -57,7 +57,7 @@ namespace DStarLite
 			 * @param   double [optional]   precision
 			 * @return  bool
 			 */
-			static bool equals(double a, double b, double precision = 0.000000000000001);
+			static bool equals(double a, double b, double precision = 0.000000001);
 
 			/**
 			 * Determines if a double is greater than compared to another double
@@ -68,7 +68,7 @@ namespace DStarLite
 			 * @param   double [optional]   precision
 			 * @return  bool
 			 */
-			static bool greater(double a, double b, double precision = 0.000000000000001);
+			static bool greater(double a, double b, double precision = 0.000000001);
 
 			/**
 			 * Determines if a double is less than compared to another double
@@ -79,7 +79,7 @@ namespace DStarLite
 			 * @param   double [optional]   precision
 			 * @return  bool
 			 */
-			static bool less(double a, double b, double precision = 0.000000000000001);
+			static bool less(double a, double b, double precision = 0.000000001);
 
 			/**
 			 * Converts radians to degrees.
@@ -0,0 +1,608 @@
+/**
+ * Nav Mesh.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "nav_mesh.h"
+
+/**
+ * @var  static const unsigned int  missing rectangle
+ */
+const unsigned int NavMesh::NONE = (unsigned int) -1;
+
+/**
+ * @var  static const unsigned int  size of a tile (in cells)
+ */
+const unsigned int NavMesh::TILE = 16;
+
+/**
+ * Constructor, decomposes the whole map.
+ *
+ * Costs are copied, the map is never written.
+ *
+ * @param  Map*         map
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+NavMesh::NavMesh(Map* map, Map::Cell* start, Map::Cell* goal)
+{
+	_cols = map->cols();
+	_rows = map->rows();
+
+	_start = vertex(start);
+	_goal = vertex(goal);
+
+	_costs.resize(_rows * _cols);
+	_owners.assign(_rows * _cols, NONE);
+
+	for (unsigned int i = 0; i < _rows; i++)
+	{
+		for (unsigned int j = 0; j < _cols; j++)
+		{
+			_costs[i * _cols + j] = (*map)(i, j)->cost;
+		}
+	}
+
+	_tiles.resize(((_rows + TILE - 1) / TILE) * ((_cols + TILE - 1) / TILE));
+
+	for (unsigned int t = 0; t < _tiles.size(); t++)
+	{
+		_decompose(t);
+	}
+
+	for (unsigned int r = 0; r < _rects.size(); r++)
+	{
+		_link(r);
+	}
+}
+
+/**
+ * Gets the cost of a cell as known by the mesh.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double NavMesh::cost(Map::Cell* u)
+{
+	return _costs[u->y() * _cols + u->x()];
+}
+
+/**
+ * Estimates the cost between two vertices (straight line distance).
+ *
+ * No cell costs less than one, so the estimate is admissible.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double NavMesh::h(const Vertex& a, const Vertex& b)
+{
+	pair<double,double> p = point(a);
+	pair<double,double> q = point(b);
+
+	double dx = p.first - q.first;
+	double dy = p.second - q.second;
+
+	return sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Gets the position of a vertex (in cells, the middle of a portal).
+ *
+ * @param   Vertex             vertex
+ * @return  pair<double,double>   x and y
+ */
+pair<double,double> NavMesh::point(const Vertex& v)
+{
+	return pair<double,double>((v.x0 + v.x1) / 4.0, (v.y0 + v.y1) / 4.0);
+}
+
+/**
+ * Gets the number of portals.
+ *
+ * @return  unsigned int
+ */
+unsigned int NavMesh::portals()
+{
+	return _portals.size();
+}
+
+/**
+ * Gets the predecessors of a vertex.
+ *
+ * Edges are symmetric, the start only leads out and the goal only leads in.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   predecessors and costs (appended)
+ * @return  void
+ */
+void NavMesh::pred(const Vertex& u, Edges& edges)
+{
+	if (u.x0 == u.x1 && u.y0 == u.y1)
+	{
+		if (u == _goal)
+		{
+			unsigned int r = _owner((u.x0 - 1) / 2, (u.y0 - 1) / 2);
+
+			if (r != NONE)
+			{
+				_edges(u, r, _start, edges);
+			}
+		}
+
+		return;
+	}
+
+	PH::iterator it = _portals.find(u);
+
+	if (it == _portals.end())
+		return;
+
+	_edges(u, it->second.first, _start, edges);
+	_edges(u, it->second.second, _start, edges);
+}
+
+/**
+ * Gets the rectangle of a cell.
+ *
+ * @param   Map::Cell*     cell
+ * @return  unsigned int   rectangle (NONE if unwalkable)
+ */
+unsigned int NavMesh::rect(Map::Cell* u)
+{
+	return _owners[u->y() * _cols + u->x()];
+}
+
+/**
+ * Gets a rectangle.
+ *
+ * @param   unsigned int   rectangle
+ * @return  Rect&
+ */
+NavMesh::Rect& NavMesh::rect(unsigned int r)
+{
+	return _rects[r];
+}
+
+/**
+ * Gets the number of rectangles.
+ *
+ * @return  unsigned int
+ */
+unsigned int NavMesh::rects()
+{
+	return _rects.size() - _free.size();
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   Map::Cell*   start cell
+ * @return  Vertex       start vertex
+ */
+NavMesh::Vertex NavMesh::start(Map::Cell* u)
+{
+	_start = vertex(u);
+
+	return _start;
+}
+
+/**
+ * Gets the successors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   successors and costs (appended)
+ * @return  void
+ */
+void NavMesh::succ(const Vertex& u, Edges& edges)
+{
+	if (u.x0 == u.x1 && u.y0 == u.y1)
+	{
+		if ( ! (u == _goal))
+		{
+			unsigned int r = _owner((u.x0 - 1) / 2, (u.y0 - 1) / 2);
+
+			if (r != NONE)
+			{
+				_edges(u, r, _goal, edges);
+			}
+		}
+
+		return;
+	}
+
+	PH::iterator it = _portals.find(u);
+
+	if (it == _portals.end())
+		return;
+
+	_edges(u, it->second.first, _goal, edges);
+	_edges(u, it->second.second, _goal, edges);
+}
+
+/**
+ * Changes the cost of a cell and re-decomposes its tile.
+ *
+ * The changed vertices are the portals of the tile's rectangles and of the
+ * rectangles next to the tile before or after, they may repeat.  The start is not included.
+ *
+ * @param   Map::Cell*        cell
+ * @param   double            new cost
+ * @param   vector<Vertex>&   portals that vanished (appended)
+ * @param   vector<Vertex>&   vertices whose edges changed (appended)
+ * @return  void
+ */
+void NavMesh::update(Map::Cell* u, double cost, vector<Vertex>& removed, vector<Vertex>& changed)
+{
+	unsigned int index = u->y() * _cols + u->x();
+
+	if (_costs[index] == cost)
+		return;
+
+	unsigned int t = _tile(u->x(), u->y());
+
+	// Portals before, and the rectangles around (those outlive the tile's)
+	vector<Vertex> old;
+	vector<unsigned int> around;
+
+	for (vector<unsigned int>::iterator it = _tiles[t].begin(); it != _tiles[t].end(); it++)
+	{
+		vector<Vertex>& portals = _rects[*it].portals;
+
+		for (vector<Vertex>::iterator p = portals.begin(); p != portals.end(); p++)
+		{
+			old.push_back(*p);
+
+			pair<unsigned int, unsigned int>& sides = _portals[*p];
+			unsigned int other = (sides.first == *it) ? sides.second : sides.first;
+
+			if (_tile(_rects[other].x, _rects[other].y) != t)
+			{
+				around.push_back(other);
+			}
+		}
+	}
+
+	for (vector<unsigned int>::iterator it = _tiles[t].begin(); it != _tiles[t].end(); it++)
+	{
+		_unlink(*it);
+	}
+
+	_tiles[t].clear();
+	_costs[index] = cost;
+
+	_decompose(t);
+
+	for (vector<unsigned int>::iterator it = _tiles[t].begin(); it != _tiles[t].end(); it++)
+	{
+		_link(*it);
+	}
+
+	// Portals after, and the portals of the rectangles around (before and after)
+	for (vector<unsigned int>::iterator it = _tiles[t].begin(); it != _tiles[t].end(); it++)
+	{
+		vector<Vertex>& portals = _rects[*it].portals;
+
+		for (vector<Vertex>::iterator p = portals.begin(); p != portals.end(); p++)
+		{
+			changed.push_back(*p);
+
+			pair<unsigned int, unsigned int>& sides = _portals[*p];
+			unsigned int other = (sides.first == *it) ? sides.second : sides.first;
+
+			if (_tile(_rects[other].x, _rects[other].y) != t)
+			{
+				around.push_back(other);
+			}
+		}
+	}
+
+	sort(around.begin(), around.end());
+	around.erase(unique(around.begin(), around.end()), around.end());
+
+	for (vector<unsigned int>::iterator it = around.begin(); it != around.end(); it++)
+	{
+		changed.insert(changed.end(), _rects[*it].portals.begin(), _rects[*it].portals.end());
+	}
+
+	for (vector<Vertex>::iterator it = old.begin(); it != old.end(); it++)
+	{
+		if (_portals.find(*it) == _portals.end())
+		{
+			removed.push_back(*it);
+		}
+		else
+		{
+			changed.push_back(*it);
+		}
+	}
+}
+
+/**
+ * Gets the vertex of a cell center.
+ *
+ * @param   Map::Cell*   cell
+ * @return  Vertex
+ */
+NavMesh::Vertex NavMesh::vertex(Map::Cell* u)
+{
+	Vertex v;
+	v.x0 = v.x1 = 2 * u->x() + 1;
+	v.y0 = v.y1 = 2 * u->y() + 1;
+
+	return v;
+}
+
+/**
+ * Splits a tile into rectangles.
+ *
+ * Greedy: the first free cell grows right while the cost stays the same,
+ * then down while whole rows match.
+ *
+ * @param   unsigned int   tile
+ * @return  void
+ */
+void NavMesh::_decompose(unsigned int t)
+{
+	unsigned int tiles = (_cols + TILE - 1) / TILE;
+
+	unsigned int x0 = (t % tiles) * TILE;
+	unsigned int y0 = (t / tiles) * TILE;
+	unsigned int x1 = min(x0 + TILE, _cols);
+	unsigned int y1 = min(y0 + TILE, _rows);
+
+	for (unsigned int y = y0; y < y1; y++)
+	{
+		for (unsigned int x = x0; x < x1; x++)
+		{
+			double cost = _costs[y * _cols + x];
+
+			if (_owners[y * _cols + x] != NONE || cost == Map::Cell::COST_UNWALKABLE)
+				continue;
+
+			unsigned int w = 1;
+
+			while (x + w < x1 && _owners[y * _cols + x + w] == NONE && _costs[y * _cols + x + w] == cost)
+			{
+				w++;
+			}
+
+			unsigned int h = 1;
+
+			for (bool grow = true; grow && y + h < y1; )
+			{
+				for (unsigned int i = 0; i < w && grow; i++)
+				{
+					unsigned int index = (y + h) * _cols + x + i;
+
+					grow = (_owners[index] == NONE && _costs[index] == cost);
+				}
+
+				if (grow)
+				{
+					h++;
+				}
+			}
+
+			unsigned int r;
+
+			if (_free.empty())
+			{
+				r = _rects.size();
+				_rects.push_back(Rect());
+			}
+			else
+			{
+				r = _free.back();
+				_free.pop_back();
+			}
+
+			Rect& rect = _rects[r];
+			rect.x = x;
+			rect.y = y;
+			rect.w = w;
+			rect.h = h;
+			rect.cost = cost;
+			rect.portals.clear();
+
+			for (unsigned int i = 0; i < h; i++)
+			{
+				for (unsigned int j = 0; j < w; j++)
+				{
+					_owners[(y + i) * _cols + x + j] = r;
+				}
+			}
+
+			_tiles[t].push_back(r);
+		}
+	}
+}
+
+/**
+ * Gets the cost between two vertices across a rectangle.
+ *
+ * @param   Vertex         a
+ * @param   Vertex         b
+ * @param   unsigned int   rectangle
+ * @return  double
+ */
+double NavMesh::_distance(const Vertex& a, const Vertex& b, unsigned int r)
+{
+	return h(a, b) * _rects[r].cost;
+}
+
+/**
+ * Adds the edges out of a rectangle from one of its vertices.
+ *
+ * @param   Vertex         vertex
+ * @param   unsigned int   rectangle
+ * @param   Vertex         vertex at the far end besides the portals (goal or start)
+ * @param   Edges&         edges (appended)
+ * @return  void
+ */
+void NavMesh::_edges(const Vertex& u, unsigned int r, const Vertex& end, Edges& edges)
+{
+	vector<Vertex>& portals = _rects[r].portals;
+
+	for (vector<Vertex>::iterator it = portals.begin(); it != portals.end(); it++)
+	{
+		if ( ! (*it == u))
+		{
+			edges.push_back(pair<Vertex, double>(*it, _distance(u, *it, r)));
+		}
+	}
+
+	if ( ! (end == u) && _owner((end.x0 - 1) / 2, (end.y0 - 1) / 2) == r)
+	{
+		edges.push_back(pair<Vertex, double>(end, _distance(u, end, r)));
+	}
+}
+
+/**
+ * Joins a rectangle to the rectangles next to it.
+ *
+ * Two rectangles share at most one stretch of side, that is their portal.
+ * Rectangles that only touch at a corner are not joined.
+ *
+ * @param   unsigned int   rectangle
+ * @return  void
+ */
+void NavMesh::_link(unsigned int r)
+{
+	Rect& rect = _rects[r];
+
+	// Left, right, top and bottom sides: cells just outside
+	for (unsigned int side = 0; side < 4; side++)
+	{
+		bool vertical = (side < 2);
+		int fixed = (side == 0) ? (int) rect.x - 1 : (side == 1) ? (int) (rect.x + rect.w) : (side == 2) ? (int) rect.y - 1 : (int) (rect.y + rect.h);
+		unsigned int from = vertical ? rect.y : rect.x;
+		unsigned int length = vertical ? rect.h : rect.w;
+
+		unsigned int last = NONE;
+
+		for (unsigned int i = from; i < from + length; i++)
+		{
+			unsigned int q = vertical ? _owner(fixed, i) : _owner(i, fixed);
+
+			if (q == NONE || q == last)
+				continue;
+
+			last = q;
+
+			Rect& other = _rects[q];
+
+			// Common stretch of the two sides
+			Vertex p;
+
+			if (vertical)
+			{
+				p.x0 = p.x1 = 2 * ((side == 0) ? rect.x : rect.x + rect.w);
+				p.y0 = 2 * max(rect.y, other.y);
+				p.y1 = 2 * min(rect.y + rect.h, other.y + other.h);
+			}
+			else
+			{
+				p.y0 = p.y1 = 2 * ((side == 2) ? rect.y : rect.y + rect.h);
+				p.x0 = 2 * max(rect.x, other.x);
+				p.x1 = 2 * min(rect.x + rect.w, other.x + other.w);
+			}
+
+			if (_portals.find(p) != _portals.end())
+				continue;
+
+			_portals[p] = pair<unsigned int, unsigned int>(r, q);
+			rect.portals.push_back(p);
+			other.portals.push_back(p);
+		}
+	}
+}
+
+/**
+ * Gets the rectangle of a cell.
+ *
+ * @param   unsigned int   x-coordinate
+ * @param   unsigned int   y-coordinate
+ * @return  unsigned int   rectangle (NONE if unwalkable)
+ */
+unsigned int NavMesh::_owner(int x, int y)
+{
+	if (x < 0 || y < 0 || x >= (int) _cols || y >= (int) _rows)
+		return NONE;
+
+	return _owners[y * _cols + x];
+}
+
+/**
+ * Gets the tile of a cell.
+ *
+ * @param   unsigned int   x-coordinate
+ * @param   unsigned int   y-coordinate
+ * @return  unsigned int
+ */
+unsigned int NavMesh::_tile(unsigned int x, unsigned int y)
+{
+	return (y / TILE) * ((_cols + TILE - 1) / TILE) + x / TILE;
+}
+
+/**
+ * Drops a rectangle and its portals.
+ *
+ * @param   unsigned int   rectangle
+ * @return  void
+ */
+void NavMesh::_unlink(unsigned int r)
+{
+	Rect& rect = _rects[r];
+
+	for (vector<Vertex>::iterator it = rect.portals.begin(); it != rect.portals.end(); it++)
+	{
+		PH::iterator p = _portals.find(*it);
+
+		unsigned int other = (p->second.first == r) ? p->second.second : p->second.first;
+		vector<Vertex>& portals = _rects[other].portals;
+
+		portals.erase(find(portals.begin(), portals.end(), *it));
+		_portals.erase(p);
+	}
+
+	rect.portals.clear();
+
+	for (unsigned int i = 0; i < rect.h; i++)
+	{
+		for (unsigned int j = 0; j < rect.w; j++)
+		{
+			_owners[(rect.y + i) * _cols + rect.x + j] = NONE;
+		}
+	}
+
+	_free.push_back(r);
+}
+
+/**
+ * Compares two vertices.
+ *
+ * @param   Vertex   vertex
+ * @return  bool
+ */
+bool NavMesh::Vertex::operator==(const Vertex& v) const
+{
+	return x0 == v.x0 && y0 == v.y0 && x1 == v.x1 && y1 == v.y1;
+}
+
+/**
+ * Hashes a vertex.
+ *
+ * @param   Vertex   vertex
+ * @return  size_t
+ */
+size_t NavMesh::Hash::operator()(const Vertex& v) const
+{
+	return ((size_t) v.y0 * 73856093) ^ ((size_t) v.x0 * 19349663) ^ ((size_t) v.y1 * 83492791) ^ ((size_t) v.x1 * 50331653);
+}
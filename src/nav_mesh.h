@@ -0,0 +1,335 @@
+/**
+ * Nav Mesh.
+ *
+ * Walkable cells of a map decomposed into rectangles of uniform cost (the
+ * convex polygons of the mesh), as a graph for the D* Lite engine.  Two
+ * rectangles that touch share a portal, the segment of their common side,
+ * and the vertices of the graph are the portals plus the start and goal
+ * cells.  Crossing a rectangle from one portal to another costs the
+ * straight line between their midpoints times the rectangle's cost, so a
+ * large open area is a handful of vertices instead of thousands of cells.
+ *
+ * Rectangles never cross tile borders (TILE cells square).  A cost change
+ * re-decomposes the tile of the cell only, and the portals that vanished or
+ * whose edges changed are reported to the caller for the engine.
+ *
+ * Coordinates of vertices are doubled so that cell sides (even) and cell
+ * centers (odd) are integers.  Paths run through portal midpoints and are
+ * not shortest on the grid, they are meant to be smoothed or followed with
+ * a local planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_NAV_MESH_H
+#define DSTARLITE_NAV_MESH_H
+
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "map.h"
+#include "math.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class NavMesh
+	{
+		public:
+
+			/**
+			 * Vertex, a portal segment or a cell center (both ends the same), doubled coordinates.
+			 */
+			struct Vertex
+			{
+				int x0;
+				int y0;
+				int x1;
+				int y1;
+
+				bool operator==(const Vertex& v) const;
+			};
+
+			/**
+			 * Vertex hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const Vertex& v) const;
+			};
+
+			/**
+			 * Rectangle of cells of the same cost.
+			 */
+			struct Rect
+			{
+				/**
+				 * @var  unsigned int  first cell and size (in cells)
+				 */
+				unsigned int x;
+				unsigned int y;
+				unsigned int w;
+				unsigned int h;
+
+				/**
+				 * @var  double  cost of its cells
+				 */
+				double cost;
+
+				/**
+				 * @var  vector<Vertex>  portals to the rectangles around
+				 */
+				vector<Vertex> portals;
+			};
+
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * @var  static const unsigned int  missing rectangle
+			 */
+			static const unsigned int NONE;
+
+			/**
+			 * @var  static const unsigned int  size of a tile (in cells)
+			 */
+			static const unsigned int TILE;
+
+			/**
+			 * Constructor, decomposes the whole map.
+			 *
+			 * Costs are copied, the map is never written.
+			 *
+			 * @param  Map*         map
+			 * @param  Map::Cell*   start cell
+			 * @param  Map::Cell*   goal cell
+			 */
+			NavMesh(Map* map, Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Gets the cost of a cell as known by the mesh.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Estimates the cost between two vertices.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Gets the position of a vertex (in cells, the middle of a portal).
+			 *
+			 * @param   Vertex             vertex
+			 * @return  pair<double,double>   x and y
+			 */
+			static pair<double,double> point(const Vertex& v);
+
+			/**
+			 * Gets the number of portals.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int portals();
+
+			/**
+			 * Gets the predecessors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   predecessors and costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Gets the rectangle of a cell.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @return  unsigned int   rectangle (NONE if unwalkable)
+			 */
+			unsigned int rect(Map::Cell* u);
+
+			/**
+			 * Gets a rectangle.
+			 *
+			 * @param   unsigned int   rectangle
+			 * @return  Rect&
+			 */
+			Rect& rect(unsigned int r);
+
+			/**
+			 * Gets the number of rectangles.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int rects();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Map::Cell*   start cell
+			 * @return  Vertex       start vertex
+			 */
+			Vertex start(Map::Cell* u);
+
+			/**
+			 * Gets the successors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   successors and costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+			/**
+			 * Changes the cost of a cell and re-decomposes its tile.
+			 *
+			 * @param   Map::Cell*        cell
+			 * @param   double            new cost
+			 * @param   vector<Vertex>&   portals that vanished (appended)
+			 * @param   vector<Vertex>&   vertices whose edges changed (appended)
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost, vector<Vertex>& removed, vector<Vertex>& changed);
+
+			/**
+			 * Gets the vertex of a cell center.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  Vertex
+			 */
+			static Vertex vertex(Map::Cell* u);
+
+		protected:
+
+#ifdef WIN32
+			typedef unordered_map<Vertex, pair<unsigned int, unsigned int>, Hash> PH;
+#else
+			typedef tr1::unordered_map<Vertex, pair<unsigned int, unsigned int>, Hash> PH;
+#endif
+
+			/**
+			 * @var  unsigned int  map size
+			 */
+			unsigned int _cols;
+			unsigned int _rows;
+
+			/**
+			 * @var  vector<double>  cost of each cell
+			 */
+			vector<double> _costs;
+
+			/**
+			 * @var  vector<unsigned int>  unused rectangle slots
+			 */
+			vector<unsigned int> _free;
+
+			/**
+			 * @var  Vertex  goal vertex
+			 */
+			Vertex _goal;
+
+			/**
+			 * @var  vector<unsigned int>  rectangle of each cell
+			 */
+			vector<unsigned int> _owners;
+
+			/**
+			 * @var  PH  rectangles on both sides of each portal
+			 */
+			PH _portals;
+
+			/**
+			 * @var  vector<Rect>  rectangles (slots in _free are unused)
+			 */
+			vector<Rect> _rects;
+
+			/**
+			 * @var  Vertex  start vertex
+			 */
+			Vertex _start;
+
+			/**
+			 * @var  vector<vector<unsigned int>>  rectangles of each tile
+			 */
+			vector<vector<unsigned int> > _tiles;
+
+			/**
+			 * Splits a tile into rectangles.
+			 *
+			 * @param   unsigned int   tile
+			 * @return  void
+			 */
+			void _decompose(unsigned int t);
+
+			/**
+			 * Gets the cost between two vertices across a rectangle.
+			 *
+			 * @param   Vertex         a
+			 * @param   Vertex         b
+			 * @param   unsigned int   rectangle
+			 * @return  double
+			 */
+			double _distance(const Vertex& a, const Vertex& b, unsigned int r);
+
+			/**
+			 * Adds the edges out of a rectangle from one of its vertices.
+			 *
+			 * @param   Vertex         vertex
+			 * @param   unsigned int   rectangle
+			 * @param   Vertex         vertex at the far end besides the portals (goal or start)
+			 * @param   Edges&         edges (appended)
+			 * @return  void
+			 */
+			void _edges(const Vertex& u, unsigned int r, const Vertex& end, Edges& edges);
+
+			/**
+			 * Joins a rectangle to the rectangles next to it.
+			 *
+			 * @param   unsigned int   rectangle
+			 * @return  void
+			 */
+			void _link(unsigned int r);
+
+			/**
+			 * Gets the rectangle of a cell.
+			 *
+			 * @param   unsigned int   x-coordinate
+			 * @param   unsigned int   y-coordinate
+			 * @return  unsigned int   rectangle (NONE if unwalkable)
+			 */
+			unsigned int _owner(int x, int y);
+
+			/**
+			 * Gets the tile of a cell.
+			 *
+			 * @param   unsigned int   x-coordinate
+			 * @param   unsigned int   y-coordinate
+			 * @return  unsigned int
+			 */
+			unsigned int _tile(unsigned int x, unsigned int y);
+
+			/**
+			 * Drops a rectangle and its portals.
+			 *
+			 * @param   unsigned int   rectangle
+			 * @return  void
+			 */
+			void _unlink(unsigned int r);
+	};
+};
+
+#endif // DSTARLITE_NAV_MESH_H
@@ -0,0 +1,167 @@
+/**
+ * Nav Mesh Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "nav_mesh_planner.h"
+
+/**
+ * Constructor.
+ *
+ * The map is never written, the mesh keeps its own costs.
+ *
+ * @param  Map*         map
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+NavMeshPlanner::NavMeshPlanner(Map* map, Map::Cell* start, Map::Cell* goal)
+{
+	_mesh = new NavMesh(map, start, goal);
+	_engine = new Engine<NavMesh>(_mesh, NavMesh::vertex(start), NavMesh::vertex(goal));
+	_start = start;
+}
+
+/**
+ * Deconstructor.
+ */
+NavMeshPlanner::~NavMeshPlanner()
+{
+	delete _engine;
+	delete _mesh;
+}
+
+/**
+ * Gets the cost of a cell as known by the planner.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double NavMeshPlanner::cost(Map::Cell* u)
+{
+	return _mesh->cost(u);
+}
+
+/**
+ * Gets the number of vertices expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int NavMeshPlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the mesh.
+ *
+ * @return  NavMesh*
+ */
+NavMesh* NavMeshPlanner::mesh()
+{
+	return _mesh;
+}
+
+/**
+ * Gets the path from the last replan (start cell, portals, goal cell).
+ *
+ * @return  list<NavMesh::Vertex>&
+ */
+const list<NavMesh::Vertex>& NavMeshPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool NavMeshPlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  Map::Cell*
+ */
+Map::Cell* NavMeshPlanner::start()
+{
+	return _start;
+}
+
+/**
+ * Moves the start.
+ *
+ * The start is a vertex of its own, its edges are worked out on the spot.
+ *
+ * @param   Map::Cell*   new start
+ * @return  void
+ */
+void NavMeshPlanner::start(Map::Cell* u)
+{
+	_start = u;
+
+	NavMesh::Vertex v = _mesh->start(u);
+
+	_engine->start(v);
+	_engine->update(v);
+}
+
+/**
+ * Update map.
+ *
+ * @param   Map::Cell*   cell to update
+ * @param   double       new cost of the cell
+ * @return  void
+ */
+void NavMeshPlanner::update(Map::Cell* u, double cost)
+{
+	if (_mesh->cost(u) == cost)
+		return;
+
+	_removed.clear();
+	_changed.clear();
+
+	_mesh->update(u, cost, _removed, _changed);
+
+	for (vector<NavMesh::Vertex>::iterator it = _removed.begin(); it != _removed.end(); it++)
+	{
+		_engine->forget(*it);
+	}
+
+	for (vector<NavMesh::Vertex>::iterator it = _changed.begin(); it != _changed.end(); it++)
+	{
+		_engine->update(*it);
+	}
+
+	// The start's rectangle may have changed too
+	_engine->update(NavMesh::vertex(_start));
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  void
+ */
+void NavMeshPlanner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		update(cells[i], costs[i]);
+	}
+}
@@ -0,0 +1,147 @@
+/**
+ * Nav Mesh Planner.
+ *
+ * D* Lite over the portals of a nav mesh, with the same incremental update
+ * API as the grid planner.  A cost change re-decomposes one tile, portals
+ * that vanished are forgotten and the portals around are repaired.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_NAV_MESH_PLANNER_H
+#define DSTARLITE_NAV_MESH_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "engine.h"
+#include "map.h"
+#include "nav_mesh.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class NavMeshPlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * The map is never written, the mesh keeps its own costs.
+			 *
+			 * @param  Map*         map
+			 * @param  Map::Cell*   start cell
+			 * @param  Map::Cell*   goal cell
+			 */
+			NavMeshPlanner(Map* map, Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Deconstructor.
+			 */
+			~NavMeshPlanner();
+
+			/**
+			 * Gets the cost of a cell as known by the planner.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the number of vertices expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the mesh.
+			 *
+			 * @return  NavMesh*
+			 */
+			NavMesh* mesh();
+
+			/**
+			 * Gets the path from the last replan (start cell, portals, goal cell).
+			 *
+			 * @return  list<NavMesh::Vertex>&
+			 */
+			const list<NavMesh::Vertex>& path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  Map::Cell*
+			 */
+			Map::Cell* start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Map::Cell*   new start
+			 * @return  void
+			 */
+			void start(Map::Cell* u);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @param   double       new cost of the cell
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  vector<NavMesh::Vertex>  scratch lists of vanished and changed vertices
+			 */
+			vector<NavMesh::Vertex> _changed;
+			vector<NavMesh::Vertex> _removed;
+
+			/**
+			 * @var  Engine<NavMesh>*  D* Lite engine
+			 */
+			Engine<NavMesh>* _engine;
+
+			/**
+			 * @var  NavMesh*  mesh
+			 */
+			NavMesh* _mesh;
+
+			/**
+			 * @var  list<NavMesh::Vertex>  path
+			 */
+			list<NavMesh::Vertex> _path;
+
+			/**
+			 * @var  Map::Cell*  start cell
+			 */
+			Map::Cell* _start;
+	};
+};
+
+#endif // DSTARLITE_NAV_MESH_PLANNER_H
@@ -11,6 +11,8 @@
  * @copyright	Copyright (C) 2011 Aaron Zampaglione
  * @license		MIT
  */
+#include <queue>
+
 #include "planner.h"
 
 /*
@@ -18,6 +20,11 @@
  */
 const double Planner::MAX_STEPS = 1000000;
 
+/**
+ * @var  static const double  fraction of the budget left after a compaction
+ */
+const double Planner::COMPACT_RATIO = 0.75;
+
 /**
  * Constructor.
  *
@@ -26,6 +33,9 @@ const double Planner::MAX_STEPS = 1000000;
  * @param  Map::Cell*   goal cell
  */
 Planner::Planner(Map* map, Map::Cell* start, Map::Cell* goal)
+	: _cell_hash(10, Map::Cell::Hash(), equal_to<Map::Cell*>(), CH::allocator_type(&_pool)),
+	  _open_list(KeyCompare(), OL::allocator_type(&_pool)),
+	  _open_hash(10, Map::Cell::Hash(), equal_to<Map::Cell*>(), OH::allocator_type(&_pool))
 {
 	// Clear lists
 	_open_list.clear();
@@ -33,8 +43,13 @@ Planner::Planner(Map* map, Map::Cell* start, Map::Cell* goal)
 	_path.clear();
 	
 	_km = 0;
+	_budget = 0;
+
+	_components = NULL;
+	_parent = NULL;
 
 	_map = map;
+	_overlay = new CostOverlay(map);
 	_start = start;
 	_goal = goal;
 	_last = _start;
@@ -44,19 +59,239 @@ Planner::Planner(Map* map, Map::Cell* start, Map::Cell* goal)
 	_list_insert(_goal, pair<double,double>(_h(_start, _goal), 0));
 }
 
+/**
+ * Constructor for a fork.
+ *
+ * @param  Planner*   parent planner
+ */
+Planner::Planner(Planner* parent)
+	: _cell_hash(10, Map::Cell::Hash(), equal_to<Map::Cell*>(), CH::allocator_type(&_pool)),
+	  _open_list(KeyCompare(), OL::allocator_type(&_pool)),
+	  _open_hash(10, Map::Cell::Hash(), equal_to<Map::Cell*>(), OH::allocator_type(&_pool))
+{
+	_km = parent->_km;
+	_budget = 0;
+
+	_components = NULL;
+	_parent = parent;
+	_parent_top = parent->_open_list.begin();
+
+	_map = parent->_map;
+	_overlay = new CostOverlay(_map, parent->_overlay);
+	_start = parent->_start;
+	_goal = parent->_goal;
+	_last = parent->_last;
+}
+
 /**
  * Deconstructor.
  */
 Planner::~Planner()
 {
+	delete _components;
+	delete _overlay;
+}
+
+/**
+ * Gets the memory budget.
+ *
+ * @return  unsigned int   most cells to keep state for (0 if unlimited)
+ */
+unsigned int Planner::budget()
+{
+	return _budget;
+}
+
+/**
+ * Sets the memory budget.
+ *
+ * @param   unsigned int   most cells to keep state for (0 if unlimited)
+ * @return  void
+ */
+void Planner::budget(unsigned int cells)
+{
+	_budget = cells;
+}
+
+/**
+ * Drops the state of cells far from the start.
+ *
+ * A cell is only evicted once no consistent kept cell takes its rhs from
+ * it, so those cells stay as they are and the search does not have to redo
+ * them; cells go farthest first, peeling the search tree from its leaves.
+ * Cells on the open list that took their rhs from an evicted cell get it
+ * recomputed, which only changes their key.
+ *
+ * An evicted cell goes back to g = rhs = INF, which only holds for a never
+ * visited cell if none of its neighbors has a g value.  The evicted cells
+ * next to a kept cell with a g value get their rhs back, and go on the open
+ * list (their key is large, they are far from the start).
+ *
+ * @param   unsigned int   cells with state to get down to
+ * @return  unsigned int   cells evicted
+ */
+unsigned int Planner::compact(unsigned int target)
+{
+	if (_parent != NULL || _cell_hash.size() <= target)
+		return 0;
+
+	CS keep(_path.begin(), _path.end());
+	keep.insert(_start);
+	keep.insert(_goal);
+
+	// Consistent kept cells whose rhs comes from each candidate
+	typedef tr1::unordered_map<Map::Cell*, unsigned int, Map::Cell::Hash> DH;
+	DH dependents;
+
+	for (CH::iterator it = _cell_hash.begin(); it != _cell_hash.end(); it++)
+	{
+		Map::Cell* u = it->first;
+
+		if (it->second.first != it->second.second || _open_hash.find(u) != _open_hash.end() || keep.find(u) != keep.end())
+			continue;
+
+		dependents[u] = 0;
+	}
+
+	typedef pair<double, Map::Cell*> Q_PAIR;
+	priority_queue<Q_PAIR> leaves;
+
+	for (DH::iterator it = dependents.begin(); it != dependents.end(); it++)
+	{
+		Map::Cell* u = it->first;
+		Map::Cell** nbrs = u->nbrs();
+
+		double g = _g(u);
+
+		for (unsigned int k = 0; g != Math::INF && k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] == NULL || nbrs[k] == _goal || _lookup(nbrs[k]) == NULL || _open_hash.find(nbrs[k]) != _open_hash.end())
+				continue;
+
+			if (Math::equals(_rhs(nbrs[k]), _cost(u, k) + g))
+			{
+				it->second++;
+			}
+		}
+
+		if (it->second == 0)
+		{
+			leaves.push(Q_PAIR(_h(_start, u), u));
+		}
+	}
+
+	vector<Map::Cell*> evicted;
+
+	while (_cell_hash.size() > target && ! leaves.empty())
+	{
+		Map::Cell* u = leaves.top().second;
+		leaves.pop();
+
+		Map::Cell** nbrs = u->nbrs();
+
+		double rhs = _rhs(u);
+
+		// The cells u took its rhs from lose a dependent
+		for (unsigned int k = 0; rhs != Math::INF && k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] == NULL)
+				continue;
+
+			DH::iterator it = dependents.find(nbrs[k]);
+
+			if (it != dependents.end() && it->second > 0 && Math::equals(rhs, _cost(u, k) + _g(nbrs[k])))
+			{
+				if (--it->second == 0)
+				{
+					leaves.push(Q_PAIR(_h(_start, nbrs[k]), nbrs[k]));
+				}
+			}
+		}
+
+		_cell_hash.erase(u);
+		evicted.push_back(u);
+	}
+
+	CS frontier;
+
+	for (vector<Map::Cell*>::iterator it = evicted.begin(); it != evicted.end(); it++)
+	{
+		Map::Cell** nbrs = (*it)->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] != NULL && nbrs[k] != _goal && _open_hash.find(nbrs[k]) != _open_hash.end())
+			{
+				frontier.insert(nbrs[k]);
+			}
+		}
+	}
+
+	for (CS::iterator it = frontier.begin(); it != frontier.end(); it++)
+	{
+		_rhs(*it, _min_succ(*it).second);
+		_update(*it);
+	}
+
+	// Evicted cells that a kept neighbor still reaches
+	for (vector<Map::Cell*>::iterator it = evicted.begin(); it != evicted.end(); it++)
+	{
+		Map::Cell** nbrs = (*it)->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] != NULL && _g(nbrs[k]) != Math::INF && _cost(*it, k) != Math::INF)
+			{
+				_rhs(*it, _min_succ(*it).second);
+				_update(*it);
+				break;
+			}
+		}
+	}
+
+	return evicted.size();
+}
+
+/**
+ * Gets the cost of a cell as seen by the planner.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double Planner::cost(Map::Cell* u)
+{
+	return _overlay->cost(u);
+}
+
+/**
+ * Forks the planner for what-if evaluation.
+ *
+ * @return  Planner*   fork (NULL if this planner is a fork), caller deletes
+ */
+Planner* Planner::fork()
+{
+	if (_parent != NULL)
+		return NULL;
+
+	return new Planner(this);
+}
+
+/**
+ * Gets the cost overlay (changes made through update).
+ *
+ * @return  CostOverlay*
+ */
+CostOverlay* Planner::overlay()
+{
+	return _overlay;
 }
 
 /**
  * Returns the generated path.
  *
- * @return  list<Map::Cell*>
+ * @return  list<Map::Cell*>&
  */
-list<Map::Cell*> Planner::path()
+const list<Map::Cell*>& Planner::path()
 {
 	return _path;
 }
@@ -78,6 +313,25 @@ Map::Cell* Planner::goal(Map::Cell* u)
 	return _goal;
 }
 
+/**
+ * Checks if the goal can be reached from the start at all.
+ *
+ * @return  bool
+ */
+bool Planner::reachable()
+{
+	// Forks change costs on top of the parent, keeping an index per fork is not worth it
+	if (_parent != NULL)
+		return true;
+
+	if (_components == NULL)
+	{
+		_components = new Components(_map, _overlay);
+	}
+
+	return _components->connected(_start, _goal);
+}
+
 /**
  * Replans the path.
  *
@@ -85,7 +339,18 @@ Map::Cell* Planner::goal(Map::Cell* u)
  */
 bool Planner::replan()
 {
-	_path.clear();
+	// Over budget, make room before the search (the last path is kept)
+	if (_budget > 0 && _cell_hash.size() > _budget)
+	{
+		compact((unsigned int) (_budget * COMPACT_RATIO));
+	}
+
+	// Keep the nodes for the new path
+	_spare.splice(_spare.end(), _path);
+
+	// Walled off, no need to search until the open list runs dry
+	if ( ! reachable())
+		return false;
 	
 	bool result = _compute();
 	
@@ -94,7 +359,7 @@ bool Planner::replan()
 	  return false;
 
 	Map::Cell* current = _start;
-	_path.push_back(current);
+	_path_push(current);
 
 	// Follow the path with the least cost until goal is reached
 	while (current != _goal)
@@ -104,12 +369,22 @@ bool Planner::replan()
 
 		current = _min_succ(current).first;
 
-		_path.push_back(current);
+		_path_push(current);
 	}
 
 	return true;
 }
 
+/**
+ * Gets the number of cells with state.
+ *
+ * @return  unsigned int
+ */
+unsigned int Planner::size()
+{
+	return _cell_hash.size();
+}
+
 /**
  * Gets/Sets start.
  *
@@ -144,9 +419,15 @@ void Planner::update(Map::Cell* u, double cost)
 
 	_cell(u);
 
-	double cost_old = u->cost;
+	double cost_old = this->cost(u);
 	double cost_new = cost;
-	u->cost = cost;
+
+	_overlay->set(u, cost);
+
+	if (_components != NULL)
+	{
+		_components->update(u);
+	}
 
 	Map::Cell** nbrs = u->nbrs();
 
@@ -158,10 +439,8 @@ void Planner::update(Map::Cell* u, double cost)
 	{
 		if (nbrs[i] != NULL)
 		{
-			u->cost = cost_old;
-			tmp_cost_old = _cost(u, nbrs[i]);
-			u->cost = cost_new;
-			tmp_cost_new = _cost(u, nbrs[i]);
+			tmp_cost_old = _cost(u, i, cost_old);
+			tmp_cost_new = _cost(u, i, cost_new);
 
 			tmp_rhs = _rhs(u);
 			tmp_g = _g(nbrs[i]);
@@ -190,10 +469,8 @@ void Planner::update(Map::Cell* u, double cost)
 	{
 		if (nbrs[i] != NULL)
 		{
-			u->cost = cost_old;
-			tmp_cost_old = _cost(u, nbrs[i]);
-			u->cost = cost_new;
-			tmp_cost_new = _cost(u, nbrs[i]);
+			tmp_cost_old = _cost(u, i, cost_old);
+			tmp_cost_new = _cost(u, i, cost_new);
 
 			tmp_rhs = _rhs(nbrs[i]);
 			tmp_g = _g(u);
@@ -216,6 +493,66 @@ void Planner::update(Map::Cell* u, double cost)
 			_update(nbrs[i]);
 		}
 	}
+
+	if (Neighborhood::VIAS && (cost_old == Map::Cell::COST_UNWALKABLE) != (cost_new == Map::Cell::COST_UNWALKABLE))
+	{
+		_bridge(u);
+	}
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  void
+ */
+void Planner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		update(cells[i], costs[i]);
+	}
+}
+
+/**
+ * Repairs the moves that pass over a cell whose walkability changed.
+ *
+ * Both ends of each such move get their rhs recomputed.
+ *
+ * @param   Map::Cell*   via cell
+ * @return  void
+ */
+void Planner::_bridge(Map::Cell* u)
+{
+	Map::Cell** nbrs = u->nbrs();
+
+	for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+	{
+		if (Neighborhood::VIA[k][0] < 0)
+			continue;
+
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			// Start of the move, opposite the via offset
+			Map::Cell* a = nbrs[(Neighborhood::VIA[k][s] + 4) % 8];
+
+			if (a == NULL || a->nbrs()[k] == NULL)
+				continue;
+
+			Map::Cell* ends[2] = {a, a->nbrs()[k]};
+
+			for (unsigned int e = 0; e < 2; e++)
+			{
+				if (ends[e] != _goal)
+				{
+					_rhs(ends[e], _min_succ(ends[e]).second);
+				}
+
+				_update(ends[e]);
+			}
+		}
+	}
 }
 
 /**
@@ -228,6 +565,18 @@ void Planner::_cell(Map::Cell* u)
 {
 	if (_cell_hash.find(u) != _cell_hash.end())
 		return;
+
+	// Copy on write from the parent
+	if (_parent != NULL)
+	{
+		pair<double,double>* g_rhs = _parent->_lookup(u);
+
+		if (g_rhs != NULL)
+		{
+			_cell_hash[u] = *g_rhs;
+			return;
+		}
+	}
 	
 	double h = Math::INF;
 	_cell_hash[u] = pair<double,double>(h, h);
@@ -240,7 +589,7 @@ void Planner::_cell(Map::Cell* u)
  */
 bool Planner::_compute()
 {
-	if (_open_list.empty())
+	if (_list_empty())
 		return false;
 
 	KeyCompare key_compare;
@@ -248,20 +597,26 @@ bool Planner::_compute()
 	int attempts = 0;
 
 	Map::Cell* u;
+	OL_PAIR top;
 	pair<double,double> k_old;
 	pair<double,double> k_new;
 	Map::Cell** nbrs;
 	double g_old;
 	double tmp_g, tmp_rhs;
 
-	while (( ! _open_list.empty() && key_compare(_open_list.begin()->first, _k(_start))) || ! Math::equals(_rhs(_start), _g(_start)))
+	while (( ! _list_empty() && key_compare(_list_top().first, _k(_start))) || ! Math::equals(_rhs(_start), _g(_start)))
 	{
 		// Reached max steps, quit
 		if (++attempts > Planner::MAX_STEPS)
 			return false;
 
-		u = _open_list.begin()->second;
-		k_old = _open_list.begin()->first;
+		// Open list exhausted
+		if (_list_empty())
+			return false;
+
+		top = _list_top();
+		u = top.second;
+		k_old = top.first;
 		k_new = _k(u);
 
 		tmp_rhs = _rhs(u);
@@ -286,7 +641,7 @@ bool Planner::_compute()
 				{
 					if (nbrs[i] != _goal)
 					{
-						_rhs(nbrs[i], min(_rhs(nbrs[i]), _cost(nbrs[i], u) + tmp_g));
+						_rhs(nbrs[i], min(_rhs(nbrs[i]), _cost(u, i) + tmp_g));
 					}
 
 					_update(nbrs[i]);
@@ -313,7 +668,7 @@ bool Planner::_compute()
 			{
 				if (nbrs[i] != NULL)
 				{
-					if (Math::equals(_rhs(nbrs[i]), (_cost(nbrs[i], u) + g_old)))
+					if (Math::equals(_rhs(nbrs[i]), (_cost(u, i) + g_old)))
 					{
 						if (nbrs[i] != _goal)
 						{
@@ -331,27 +686,44 @@ bool Planner::_compute()
 }
 
 /**
- * Calculates the cost from one cell to another cell.
+ * Calculates the cost from a cell to one of its neighbors.
  * 
- * @param   Map::Cell*   cell a
- * @param   Map::Cell*   cell b
- * @return  double       cost between a and b
+ * @param   Map::Cell*     cell a
+ * @param   unsigned int   neighbor index
+ * @return  double         cost between a and the neighbor
  */
-double Planner::_cost(Map::Cell* a, Map::Cell* b)
+double Planner::_cost(Map::Cell* a, unsigned int k)
 {
-	if (a->cost == Map::Cell::COST_UNWALKABLE || b->cost == Map::Cell::COST_UNWALKABLE)
-		return Map::Cell::COST_UNWALKABLE;
+	return _cost(a, k, cost(a));
+}
 
-	unsigned int dx = labs(a->x() - b->x());
-	unsigned int dy = labs(a->y() - b->y());
-	double scale = 1.0;
+/**
+ * Calculates the cost from a cell to one of its neighbors, given the cost of the first cell.
+ *
+ * Moves are symmetric, the cost from the neighbor back to a is the same.
+ * 
+ * @param   Map::Cell*     cell a
+ * @param   unsigned int   neighbor index
+ * @param   double         cost of cell a
+ * @return  double         cost between a and the neighbor
+ */
+double Planner::_cost(Map::Cell* a, unsigned int k, double a_cost)
+{
+	Map::Cell** nbrs = a->nbrs();
 
-	if ((dx + dy) > 1)
+	double b_cost = cost(nbrs[k]);
+
+	if (a_cost == Map::Cell::COST_UNWALKABLE || b_cost == Map::Cell::COST_UNWALKABLE)
+		return Map::Cell::COST_UNWALKABLE;
+
+	// Moves that skip a cell may not cut through walls
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
 	{
-		scale = Math::SQRT2;
+		if (cost(nbrs[Neighborhood::VIA[k][0]]) == Map::Cell::COST_UNWALKABLE || cost(nbrs[Neighborhood::VIA[k][1]]) == Map::Cell::COST_UNWALKABLE)
+			return Map::Cell::COST_UNWALKABLE;
 	}
 
-	return scale * ((a->cost + b->cost) / 2);
+	return Neighborhood::COST[k] * ((a_cost + b_cost) / 2);
 }
 
 /**
@@ -363,19 +735,23 @@ double Planner::_cost(Map::Cell* a, Map::Cell* b)
  */
 double Planner::_g(Map::Cell* u, double value)
 {
-	_cell(u);
-	pair<double,double>* g_rhs = &_cell_hash[u];
-
-	if (value != DBL_MIN)
+	if (value == DBL_MIN)
 	{
-		g_rhs->first = value;
+		pair<double,double>* g_rhs = _lookup(u);
+		return (g_rhs == NULL) ? Math::INF : g_rhs->first;
 	}
 
+	_cell(u);
+	pair<double,double>* g_rhs = &_cell_hash[u];
+	g_rhs->first = value;
+
 	return g_rhs->first;
 }
 
 /**
- * Calculates heuristic between two cells (manhattan distance).
+ * Calculates heuristic between two cells, the estimate of the compiled
+ * neighborhood (Manhattan, octile or straight line distance for 4, 8 or 16
+ * connectivity, see Neighborhood::h).
  *
  * @param   Map::Cell*   cell a
  * @param   Map::Cell*   cell b
@@ -383,17 +759,10 @@ double Planner::_g(Map::Cell* u, double value)
  */
 double Planner::_h(Map::Cell* a, Map::Cell* b)
 {
-	unsigned int min = labs(a->x() - b->x());
-	unsigned int max = labs(a->y() - b->y());
-	
-	if (min > max)
-	{
-		unsigned int tmp = min;
-		min = max;
-		max = tmp;
-	}
-	
-	return ((Math::SQRT2 - 1.0) * min + max);
+	unsigned int dx = abs((int) a->x() - (int) b->x());
+	unsigned int dy = abs((int) a->y() - (int) b->y());
+
+	return Neighborhood::h(dx, dy);
 }
 
 /**
@@ -410,6 +779,41 @@ pair<double,double> Planner::_k(Map::Cell* u)
 	return pair<double,double>((min + _h(_start, u) + _km), min);
 }
 
+/**
+ * Checks if the open list is empty.
+ *
+ * @return  bool
+ */
+bool Planner::_list_empty()
+{
+	if ( ! _open_list.empty() || _parent == NULL)
+		return _open_list.empty();
+
+	while (_parent_top != _parent->_open_list.end() && _owned.find(_parent_top->second) != _owned.end())
+	{
+		_parent_top++;
+	}
+
+	return _parent_top == _parent->_open_list.end();
+}
+
+/**
+ * Checks if a cell is in the open list.
+ *
+ * @param   Map::Cell*   cell
+ * @return  bool
+ */
+bool Planner::_list_has(Map::Cell* u)
+{
+	if (_open_hash.find(u) != _open_hash.end())
+		return true;
+
+	if (_parent == NULL || _owned.find(u) != _owned.end())
+		return false;
+
+	return _parent->_open_hash.find(u) != _parent->_open_hash.end();
+}
+
 /**
  * Inserts cell into open list.
  *
@@ -421,6 +825,12 @@ void Planner::_list_insert(Map::Cell* u, pair<double,double> k)
 {
 	OL::iterator pos = _open_list.insert(OL_PAIR(k, u));
 	_open_hash[u] = pos;
+
+	// Hides the parent's entry
+	if (_parent != NULL)
+	{
+		_owned.insert(u);
+	}
 }
 
 /**
@@ -431,8 +841,46 @@ void Planner::_list_insert(Map::Cell* u, pair<double,double> k)
  */
 void Planner::_list_remove(Map::Cell* u)
 {
-	_open_list.erase(_open_hash[u]);
-	_open_hash.erase(_open_hash.find(u));
+	OH::iterator it = _open_hash.find(u);
+
+	if (it != _open_hash.end())
+	{
+		_open_list.erase(it->second);
+		_open_hash.erase(it);
+	}
+
+	// Hides the parent's entry
+	if (_parent != NULL)
+	{
+		_owned.insert(u);
+	}
+}
+
+/**
+ * Gets the open list entry with the smallest key.
+ *
+ * @return  OL_PAIR
+ */
+Planner::OL_PAIR Planner::_list_top()
+{
+	if (_parent == NULL)
+		return *_open_list.begin();
+
+	// Skip parent entries that were taken over
+	while (_parent_top != _parent->_open_list.end() && _owned.find(_parent_top->second) != _owned.end())
+	{
+		_parent_top++;
+	}
+
+	if (_parent_top == _parent->_open_list.end())
+		return *_open_list.begin();
+
+	if (_open_list.empty())
+		return *_parent_top;
+
+	KeyCompare key_compare;
+
+	return key_compare(_parent_top->first, _open_list.begin()->first) ? *_parent_top : *_open_list.begin();
 }
 
 /**
@@ -444,6 +892,13 @@ void Planner::_list_remove(Map::Cell* u)
  */
 void Planner::_list_update(Map::Cell* u, pair<double,double> k)
 {
+	// Entry still belongs to the parent, take it over
+	if (_open_hash.find(u) == _open_hash.end())
+	{
+		_list_insert(u, k);
+		return;
+	}
+
 	OL::iterator pos1 = _open_hash[u];
 	OL::iterator pos2 = pos1;
 
@@ -460,6 +915,24 @@ void Planner::_list_update(Map::Cell* u, pair<double,double> k)
 	_open_hash[u] = _open_list.insert(pos2, OL_PAIR(k, u));
 }
 
+/**
+ * Appends a cell to the path, on a spare node if there is one.
+ *
+ * @param   Map::Cell*   cell
+ * @return  void
+ */
+void Planner::_path_push(Map::Cell* u)
+{
+	if (_spare.empty())
+	{
+		_path.push_back(u);
+		return;
+	}
+
+	_spare.front() = u;
+	_path.splice(_path.end(), _spare, _spare.begin());
+}
+
 /**
  * Finds the minimum successor cell.
  *
@@ -479,7 +952,7 @@ pair<Map::Cell*,double> Planner::_min_succ(Map::Cell* u)
 	{
 		if (nbrs[i] != NULL)
 		{
-			tmp_cost = _cost(u, nbrs[i]);
+			tmp_cost = _cost(u, i);
 			tmp_g = _g(nbrs[i]);
 
 			if (tmp_cost == Math::INF || tmp_g == Math::INF)
@@ -498,6 +971,25 @@ pair<Map::Cell*,double> Planner::_min_succ(Map::Cell* u)
 	return pair<Map::Cell*,double>(min_cell, min_cost);
 }
 
+/**
+ * Finds the g/rhs values of a cell without generating it.
+ *
+ * @param   Map::Cell*              cell
+ * @return  pair<double,double>*    g/rhs (NULL if never generated)
+ */
+pair<double,double>* Planner::_lookup(Map::Cell* u)
+{
+	CH::iterator it = _cell_hash.find(u);
+
+	if (it != _cell_hash.end())
+		return &it->second;
+
+	if (_parent != NULL)
+		return _parent->_lookup(u);
+
+	return NULL;
+}
+
 /**
  * Gets/Sets rhs value for a cell.
  * 
@@ -510,13 +1002,15 @@ double Planner::_rhs(Map::Cell* u, double value)
 	if (u == _goal)
 		return 0;
 
-	_cell(u);
-	pair<double,double>* g_rhs = &_cell_hash[u];
-
-	if (value != DBL_MIN)
+	if (value == DBL_MIN)
 	{
-		g_rhs->second = value;
+		pair<double,double>* g_rhs = _lookup(u);
+		return (g_rhs == NULL) ? Math::INF : g_rhs->second;
 	}
+
+	_cell(u);
+	pair<double,double>* g_rhs = &_cell_hash[u];
+	g_rhs->second = value;
 	
 	return g_rhs->second;
 }
@@ -530,7 +1024,7 @@ double Planner::_rhs(Map::Cell* u, double value)
 void Planner::_update(Map::Cell* u)
 {
 	bool diff = _g(u) != _rhs(u);
-	bool exists = (_open_hash.find(u) != _open_hash.end());
+	bool exists = _list_has(u);
 
 	if (diff && exists)
 	{
@@ -545,15 +1039,3 @@ void Planner::_update(Map::Cell* u)
 		_list_remove(u);
 	}
 }
-
-/**
- * Key compare function.
- */
-bool Planner::KeyCompare::operator()(const pair<double,double>& p1, const pair<double,double>& p2) const
-{
-	if (Math::less(p1.first, p2.first))				return true;
-	else if (Math::greater(p1.first, p2.first))		return false;
-	else if (Math::less(p1.second,  p2.second))		return true;
-	else if (Math::greater(p1.second, p2.second))	return false;
-													return false;
-}
@@ -16,13 +16,20 @@
 
 #include <list>
 #include <map>
+#include <vector>
 #ifdef WIN32
 	#include <unordered_map>
+	#include <unordered_set>
 #else
 	#include <tr1/unordered_map>
+	#include <tr1/unordered_set>
 #endif
+#include "components.h"
+#include "cost_overlay.h"
+#include "key.h"
 #include "map.h"
 #include "math.h"
+#include "pool.h"
 
 using namespace std;
 using namespace DStarLite;
@@ -33,22 +40,22 @@ namespace DStarLite
 	{
 		public:
 
-			/**
-			 * Key compare struct.
-			 */
-			struct KeyCompare : public binary_function<pair<double,double>, pair<double,double>, bool>
-			{
-				bool operator()(const pair<double,double>& p1, const pair<double,double>& p2) const;
-			};
-
 			/*
 			 * @var  static const double  max steps before assuming no solution possible
 			 */
 			static const double MAX_STEPS;
 
+			/**
+			 * @var  static const double  fraction of the budget left after a compaction
+			 */
+			static const double COMPACT_RATIO;
+
 			/**
 			 * Constructor.
 			 *
+			 * The map is never written, cost updates go into the planner's own
+			 * overlay so several planners can share one map.
+			 *
 			 * @param  Map*         map
 			 * @param  Map::Cell*   start cell
 			 * @param  Map::Cell*   goal cell
@@ -60,12 +67,72 @@ namespace DStarLite
 			 */
 			~Planner();
 
+			/**
+			 * Gets the memory budget.
+			 *
+			 * @return  unsigned int   most cells to keep state for (0 if unlimited)
+			 */
+			unsigned int budget();
+
+			/**
+			 * Sets the memory budget.
+			 *
+			 * Once more cells than the budget have state, the next replan first
+			 * compacts down to COMPACT_RATIO of it.
+			 *
+			 * @param   unsigned int   most cells to keep state for (0 if unlimited)
+			 * @return  void
+			 */
+			void budget(unsigned int cells);
+
+			/**
+			 * Drops the state of cells far from the start.
+			 *
+			 * Only cells that are consistent, off the open list and off the
+			 * path are evicted, farthest first, and they are treated as never
+			 * visited from then on.  The cells next to them are repaired, so
+			 * the search stays correct and simply revisits them if needed.
+			 * Does nothing on a fork.
+			 *
+			 * @param   unsigned int   cells with state to get down to
+			 * @return  unsigned int   cells evicted
+			 */
+			unsigned int compact(unsigned int target);
+
+			/**
+			 * Gets the cost of a cell as seen by the planner.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Forks the planner for what-if evaluation.
+			 *
+			 * The fork shares the g/rhs values, open list and costs of this
+			 * planner and only copies the state it touches; updates and replans
+			 * on the fork never affect this planner.  This planner must not be
+			 * changed (or deleted) while the fork is alive.  Forks cannot be
+			 * forked again.
+			 *
+			 * @return  Planner*   fork (NULL if this planner is a fork), caller deletes
+			 */
+			Planner* fork();
+
+			/**
+			 * Gets the cost overlay (changes made through update).
+			 *
+			 * @return  CostOverlay*
+			 */
+			CostOverlay* overlay();
+
 			/**
 			 * Returns the generated path.
 			 *
-			 * @return  list<Map::Cell*>   path
+			 * @return  list<Map::Cell*>&   path
 			 */
-			list<Map::Cell*> path();
+			const list<Map::Cell*>& path();
 
 			/**
 			 * Gets/Sets a new goal.
@@ -75,6 +142,17 @@ namespace DStarLite
 			 */
 			Map::Cell* goal(Map::Cell* u = NULL);
 
+			/**
+			 * Checks if the goal can be reached from the start at all.
+			 *
+			 * Builds a connected components index of the map on first use and
+			 * keeps it up to date through update, so walled off goals are
+			 * told apart in constant time.  Forks always say yes.
+			 *
+			 * @return  bool
+			 */
+			bool reachable();
+
 			/**
 			 * Replans the path.
 			 *
@@ -82,6 +160,13 @@ namespace DStarLite
 			 */
 			bool replan();
 
+			/**
+			 * Gets the number of cells with state.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
 			/**
 			 * Gets/Sets start.
 			 *
@@ -99,14 +184,44 @@ namespace DStarLite
 			 */
 			void update(Map::Cell* u, double cost);
 
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
 		protected:			
 
+			/**
+			 * @var  Pool  nodes of the cell hash, open list and open hash (declared first, they allocate from it)
+			 */
+			Pool _pool;
+
+			/**
+			 * @var  unsigned int  most cells to keep state for (0 if unlimited)
+			 */
+			unsigned int _budget;
+
 			/**
 			 * @var  unordered_map  cell hash (keeps track of all the cells)
 			 */
-			typedef tr1::unordered_map<Map::Cell*, pair<double,double>, Map::Cell::Hash> CH;
+			typedef tr1::unordered_map<Map::Cell*, pair<double,double>, Map::Cell::Hash, equal_to<Map::Cell*>, PoolAllocator<pair<Map::Cell* const, pair<double,double> > > > CH;
 			CH _cell_hash;
 
+			/**
+			 * @var  unordered_set  cells whose open list state was taken over from the parent
+			 */
+			typedef tr1::unordered_set<Map::Cell*, Map::Cell::Hash> CS;
+			CS _owned;
+
+			/**
+			 * @var  Components*  connected components (NULL until reachable is first asked)
+			 */
+			Components* _components;
+
 			/**
 			 * @var  double  accumulated heuristic value
 			 */
@@ -117,24 +232,44 @@ namespace DStarLite
 			 */
 			Map* _map;
 
+			/**
+			 * @var  CostOverlay*  cost overlay
+			 */
+			CostOverlay* _overlay;
+
 			/**
 			 * @var  list<Map::Cell*>  path
 			 */
 			list<Map::Cell*> _path;
 
+			/**
+			 * @var  list<Map::Cell*>  nodes of old paths, reused by the next one
+			 */
+			list<Map::Cell*> _spare;
+
 			/**
 			 * @var  multimap  open list
 			 */
 			typedef pair<pair<double,double>, Map::Cell*> OL_PAIR;
-			typedef multimap<pair<double,double>, Map::Cell*, KeyCompare> OL;
+			typedef multimap<pair<double,double>, Map::Cell*, KeyCompare, PoolAllocator<OL_PAIR> > OL;
 			OL _open_list;
 
 			/**
 			 * @var  unordered_map  open hash (stores position in multimap)
 			 */
-			typedef tr1::unordered_map<Map::Cell*, OL::iterator, Map::Cell::Hash> OH;
+			typedef tr1::unordered_map<Map::Cell*, OL::iterator, Map::Cell::Hash, equal_to<Map::Cell*>, PoolAllocator<pair<Map::Cell* const, OL::iterator> > > OH;
 			OH _open_hash;
 
+			/**
+			 * @var  Planner*  parent planner (NULL unless forked)
+			 */
+			Planner* _parent;
+
+			/**
+			 * @var  OL::iterator  first parent open list entry not yet taken over
+			 */
+			OL::iterator _parent_top;
+
 			/**
 			 * @var  Map::Cell*  start, goal, and last start tile
 			 */
@@ -142,6 +277,13 @@ namespace DStarLite
 			Map::Cell* _goal;
 			Map::Cell* _last;
 
+			/**
+			 * Constructor for a fork.
+			 *
+			 * @param  Planner*   parent planner
+			 */
+			Planner(Planner* parent);
+
 			/**
 			 * Generates a cell.
 			 *
@@ -150,6 +292,14 @@ namespace DStarLite
 			 */
 			void _cell(Map::Cell* u);
 
+			/**
+			 * Repairs the moves that pass over a cell whose walkability changed.
+			 *
+			 * @param   Map::Cell*   via cell
+			 * @return  void
+			 */
+			void _bridge(Map::Cell* u);
+
 			/**
 			 * Computes shortest path.
 			 *
@@ -158,13 +308,23 @@ namespace DStarLite
 			bool _compute();
 
 			/**
-			 * Calculates the cost from one cell to another cell.
+			 * Calculates the cost from a cell to one of its neighbors.
 			 * 
-			 * @param   Map::Cell*   cell a
-			 * @param   Map::Cell*   cell b
-			 * @return  double       cost between a and b
+			 * @param   Map::Cell*     cell a
+			 * @param   unsigned int   neighbor index
+			 * @return  double         cost between a and the neighbor
 			 */
-			double _cost(Map::Cell* a, Map::Cell* b);
+			double _cost(Map::Cell* a, unsigned int k);
+
+			/**
+			 * Calculates the cost from a cell to one of its neighbors, given the cost of the first cell.
+			 * 
+			 * @param   Map::Cell*     cell a
+			 * @param   unsigned int   neighbor index
+			 * @param   double         cost of cell a
+			 * @return  double         cost between a and the neighbor
+			 */
+			double _cost(Map::Cell* a, unsigned int k, double a_cost);
 
 			/**
 			 * Gets/Sets g value for a cell.
@@ -176,7 +336,7 @@ namespace DStarLite
 			double _g(Map::Cell* u, double value = DBL_MIN);
 
 			/**
-			 * Calculates heuristic between two cells (manhattan distance).
+			 * Calculates heuristic between two cells (see Neighborhood::h).
 			 *
 			 * @param   Map::Cell*   cell a
 			 * @param   Map::Cell*   cell b
@@ -192,6 +352,21 @@ namespace DStarLite
 			 */
 			pair<double,double> _k(Map::Cell* u);
 
+			/**
+			 * Checks if the open list is empty.
+			 *
+			 * @return  bool
+			 */
+			bool _list_empty();
+
+			/**
+			 * Checks if a cell is in the open list.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  bool
+			 */
+			bool _list_has(Map::Cell* u);
+
 			/**
 			 * Inserts cell into open list.
 			 *
@@ -209,6 +384,13 @@ namespace DStarLite
 			 */
 			void _list_remove(Map::Cell* u);
 
+			/**
+			 * Gets the open list entry with the smallest key.
+			 *
+			 * @return  OL_PAIR
+			 */
+			OL_PAIR _list_top();
+
 			/**
 			 * Updates cell in the open list.
 			 *
@@ -218,6 +400,14 @@ namespace DStarLite
 			 */
 			void _list_update(Map::Cell* u, pair<double,double> k);
 
+			/**
+			 * Appends a cell to the path, on a spare node if there is one.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  void
+			 */
+			void _path_push(Map::Cell* u);
+
 			/**
 			 * Finds the minimum successor cell.
 			 *
@@ -226,6 +416,14 @@ namespace DStarLite
 			 */
 			pair<Map::Cell*,double> _min_succ(Map::Cell* u);
 
+			/**
+			 * Finds the g/rhs values of a cell without generating it.
+			 *
+			 * @param   Map::Cell*              cell
+			 * @return  pair<double,double>*    g/rhs (NULL if never generated)
+			 */
+			pair<double,double>* _lookup(Map::Cell* u);
+
 			/**
 			 * Gets/Sets rhs value for a cell.
 			 * 
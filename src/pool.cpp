@@ -0,0 +1,114 @@
+/**
+ * Pool.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "pool.h"
+
+using namespace DStarLite;
+
+/**
+ * @var  static const unsigned int  size class granularity (in bytes)
+ */
+const unsigned int Pool::ALIGN = 16;
+
+/**
+ * @var  static const unsigned int  largest pooled block (in bytes)
+ */
+const unsigned int Pool::MAX_SIZE = 256;
+
+/**
+ * @var  static const unsigned int  chunk size (in bytes)
+ */
+const unsigned int Pool::CHUNK_SIZE = 65536;
+
+/**
+ * Constructor.
+ */
+Pool::Pool()
+{
+	_free.assign(MAX_SIZE / ALIGN + 1, (void*) NULL);
+	_left = 0;
+}
+
+/**
+ * Deconstructor, frees all chunks.
+ */
+Pool::~Pool()
+{
+	for (unsigned int i = 0; i < _chunks.size(); i++)
+	{
+		delete[] _chunks[i];
+	}
+}
+
+/**
+ * Gets a block.
+ *
+ * @param   size_t   size (in bytes)
+ * @return  void*
+ */
+void* Pool::allocate(size_t size)
+{
+	if (size > MAX_SIZE)
+		return ::operator new(size);
+
+	unsigned int k = max((unsigned int) (size + ALIGN - 1) / ALIGN, 1u);
+
+	// Recycled block, the free list link is stored in it
+	if (_free[k] != NULL)
+	{
+		void* p = _free[k];
+		_free[k] = *(void**) p;
+
+		return p;
+	}
+
+	size_t bytes = k * ALIGN;
+
+	if (_left < bytes)
+	{
+		_chunks.push_back(new char[CHUNK_SIZE]);
+		_left = CHUNK_SIZE;
+	}
+
+	_left -= bytes;
+
+	return _chunks.back() + _left;
+}
+
+/**
+ * Returns a block.
+ *
+ * @param   void*    block
+ * @param   size_t   size (in bytes), as allocated
+ * @return  void
+ */
+void Pool::deallocate(void* p, size_t size)
+{
+	if (size > MAX_SIZE)
+	{
+		::operator delete(p);
+		return;
+	}
+
+	unsigned int k = max((unsigned int) (size + ALIGN - 1) / ALIGN, 1u);
+
+	*(void**) p = _free[k];
+	_free[k] = p;
+}
+
+/**
+ * Gets the memory taken from the heap for small blocks (in bytes).
+ *
+ * @return  unsigned int
+ */
+unsigned int Pool::memory()
+{
+	return _chunks.size() * CHUNK_SIZE;
+}
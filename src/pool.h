@@ -0,0 +1,164 @@
+/**
+ * Pool.
+ *
+ * Recycles the nodes of node based containers.  Freed blocks go on a free
+ * list by size class and are handed out again before any new memory is
+ * taken, small blocks are carved out of large chunks.  Once a planner has
+ * reached its high water mark, inserting and erasing in its containers no
+ * longer touches the heap.  Blocks larger than MAX_SIZE (bucket arrays) go
+ * straight to the heap.
+ *
+ * A pool is not thread safe, give each planner its own.  Memory is only
+ * given back when the pool is destroyed.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_POOL_H
+#define DSTARLITE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+namespace DStarLite
+{
+	class Pool
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  size class granularity (in bytes)
+			 */
+			static const unsigned int ALIGN;
+
+			/**
+			 * @var  static const unsigned int  largest pooled block (in bytes)
+			 */
+			static const unsigned int MAX_SIZE;
+
+			/**
+			 * @var  static const unsigned int  chunk size (in bytes)
+			 */
+			static const unsigned int CHUNK_SIZE;
+
+			/**
+			 * Constructor.
+			 */
+			Pool();
+
+			/**
+			 * Deconstructor, frees all chunks.
+			 */
+			~Pool();
+
+			/**
+			 * Gets a block.
+			 *
+			 * @param   size_t   size (in bytes)
+			 * @return  void*
+			 */
+			void* allocate(size_t size);
+
+			/**
+			 * Returns a block.
+			 *
+			 * @param   void*    block
+			 * @param   size_t   size (in bytes), as allocated
+			 * @return  void
+			 */
+			void deallocate(void* p, size_t size);
+
+			/**
+			 * Gets the memory taken from the heap for small blocks (in bytes).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int memory();
+
+		protected:
+
+			/**
+			 * @var  vector<char*>  chunks taken from the heap
+			 */
+			vector<char*> _chunks;
+
+			/**
+			 * @var  vector<void*>  free list heads, by size class
+			 */
+			vector<void*> _free;
+
+			/**
+			 * @var  size_t  bytes left in the last chunk
+			 */
+			size_t _left;
+
+			/**
+			 * Pools cannot be copied.
+			 */
+			Pool(const Pool& pool);
+			Pool& operator=(const Pool& pool);
+	};
+
+	/**
+	 * Standard allocator over a pool.
+	 */
+	template <class T>
+	class PoolAllocator
+	{
+		public:
+
+			typedef T value_type;
+			typedef T* pointer;
+			typedef const T* const_pointer;
+			typedef T& reference;
+			typedef const T& const_reference;
+			typedef size_t size_type;
+			typedef ptrdiff_t difference_type;
+
+			template <class U>
+			struct rebind
+			{
+				typedef PoolAllocator<U> other;
+			};
+
+			/**
+			 * @var  Pool*  pool
+			 */
+			Pool* pool;
+
+			/**
+			 * Constructors.
+			 */
+			PoolAllocator(Pool* pool) : pool(pool) {}
+
+			template <class U>
+			PoolAllocator(const PoolAllocator<U>& a) : pool(a.pool) {}
+
+			/**
+			 * Allocator interface.
+			 */
+			pointer address(reference x) const { return &x; }
+			const_pointer address(const_reference x) const { return &x; }
+
+			pointer allocate(size_type n, const void* = 0) { return (pointer) pool->allocate(n * sizeof(T)); }
+			void deallocate(pointer p, size_type n) { pool->deallocate(p, n * sizeof(T)); }
+
+			size_type max_size() const { return ((size_type) -1) / sizeof(T); }
+
+			void construct(pointer p, const T& value) { new ((void*) p) T(value); }
+			void destroy(pointer p) { p->~T(); }
+
+			template <class U>
+			bool operator==(const PoolAllocator<U>& a) const { return pool == a.pool; }
+
+			template <class U>
+			bool operator!=(const PoolAllocator<U>& a) const { return pool != a.pool; }
+	};
+};
+
+#endif // DSTARLITE_POOL_H
@@ -0,0 +1,160 @@
+/**
+ * Reservation Table.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "reservation_table.h"
+
+/**
+ * Constructor, nothing reserved.
+ */
+ReservationTable::ReservationTable()
+{
+	_horizon = 0;
+}
+
+/**
+ * Checks if moving between two cells from time t to t + 1 runs into a reservation.
+ *
+ * The target must be free at t + 1 and nothing may come the other way.
+ *
+ * @param   Map::Cell*     from
+ * @param   Map::Cell*     to
+ * @param   unsigned int   time step of the start of the move
+ * @return  bool
+ */
+bool ReservationTable::blocked(Map::Cell* a, Map::Cell* b, unsigned int t)
+{
+	if (reserved(b, t + 1))
+		return true;
+
+	// Swap with whatever holds the target now
+	return a != b && reserved(b, t) && reserved(a, t + 1);
+}
+
+/**
+ * Releases all reservations.
+ *
+ * @return  void
+ */
+void ReservationTable::clear()
+{
+	_reservations.clear();
+	_horizon = 0;
+}
+
+/**
+ * Gets the first time step after all reservations made so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int ReservationTable::horizon()
+{
+	return _horizon;
+}
+
+/**
+ * Releases a reservation.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   time step
+ * @return  void
+ */
+void ReservationTable::release(Map::Cell* u, unsigned int t)
+{
+	RH::iterator it = _reservations.find(pair<Map::Cell*, unsigned int>(u, t));
+
+	if (it == _reservations.end())
+		return;
+
+	if (--it->second == 0)
+	{
+		_reservations.erase(it);
+	}
+}
+
+/**
+ * Releases a trajectory (i-th cell at time t + i).
+ *
+ * @param   list<Map::Cell*>&   trajectory
+ * @param   unsigned int        time step of the first cell
+ * @return  void
+ */
+void ReservationTable::release(list<Map::Cell*>& trajectory, unsigned int t)
+{
+	for (list<Map::Cell*>::iterator it = trajectory.begin(); it != trajectory.end(); it++, t++)
+	{
+		release(*it, t);
+	}
+}
+
+/**
+ * Reserves a cell at a time step.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   time step
+ * @return  void
+ */
+void ReservationTable::reserve(Map::Cell* u, unsigned int t)
+{
+	_reservations[pair<Map::Cell*, unsigned int>(u, t)]++;
+
+	if (t >= _horizon)
+	{
+		_horizon = t + 1;
+	}
+}
+
+/**
+ * Reserves a trajectory (i-th cell at time t + i).
+ *
+ * @param   list<Map::Cell*>&   trajectory
+ * @param   unsigned int        time step of the first cell
+ * @return  void
+ */
+void ReservationTable::reserve(list<Map::Cell*>& trajectory, unsigned int t)
+{
+	for (list<Map::Cell*>::iterator it = trajectory.begin(); it != trajectory.end(); it++, t++)
+	{
+		reserve(*it, t);
+	}
+}
+
+/**
+ * Checks if a cell is reserved at a time step.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   time step
+ * @return  bool
+ */
+bool ReservationTable::reserved(Map::Cell* u, unsigned int t)
+{
+	if (t >= _horizon)
+		return false;
+
+	return _reservations.find(pair<Map::Cell*, unsigned int>(u, t)) != _reservations.end();
+}
+
+/**
+ * Gets the number of reserved (cell, time) pairs.
+ *
+ * @return  unsigned int
+ */
+unsigned int ReservationTable::size()
+{
+	return _reservations.size();
+}
+
+/**
+ * Hashes a (cell, time) pair.
+ *
+ * @param   pair<Map::Cell*, unsigned int>   cell and time
+ * @return  size_t
+ */
+size_t ReservationTable::Hash::operator()(const pair<Map::Cell*, unsigned int>& p) const
+{
+	return ((size_t) p.first->x() * 73856093) ^ ((size_t) p.first->y() * 19349663) ^ ((size_t) p.second * 83492791);
+}
@@ -0,0 +1,145 @@
+/**
+ * Reservation Table.
+ *
+ * Cells taken at given time steps, by predicted obstacle trajectories or by
+ * the plans of other robots.  Overlapping reservations are counted, so each
+ * one can be released on its own.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_RESERVATION_TABLE_H
+#define DSTARLITE_RESERVATION_TABLE_H
+
+#include <list>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class ReservationTable
+	{
+		public:
+
+			/**
+			 * (cell, time) hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const pair<Map::Cell*, unsigned int>& p) const;
+			};
+
+			/**
+			 * Constructor, nothing reserved.
+			 */
+			ReservationTable();
+
+			/**
+			 * Releases all reservations.
+			 *
+			 * @return  void
+			 */
+			void clear();
+
+			/**
+			 * Gets the first time step after all reservations made so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int horizon();
+
+			/**
+			 * Releases a reservation.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   time step
+			 * @return  void
+			 */
+			void release(Map::Cell* u, unsigned int t);
+
+			/**
+			 * Releases a trajectory (i-th cell at time t + i).
+			 *
+			 * @param   list<Map::Cell*>&   trajectory
+			 * @param   unsigned int        time step of the first cell
+			 * @return  void
+			 */
+			void release(list<Map::Cell*>& trajectory, unsigned int t);
+
+			/**
+			 * Reserves a cell at a time step.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   time step
+			 * @return  void
+			 */
+			void reserve(Map::Cell* u, unsigned int t);
+
+			/**
+			 * Reserves a trajectory (i-th cell at time t + i).
+			 *
+			 * @param   list<Map::Cell*>&   trajectory
+			 * @param   unsigned int        time step of the first cell
+			 * @return  void
+			 */
+			void reserve(list<Map::Cell*>& trajectory, unsigned int t);
+
+			/**
+			 * Checks if a cell is reserved at a time step.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   time step
+			 * @return  bool
+			 */
+			bool reserved(Map::Cell* u, unsigned int t);
+
+			/**
+			 * Checks if moving between two cells from time t to t + 1 runs into a reservation.
+			 *
+			 * The target must be free at t + 1 and nothing may come the other way.
+			 *
+			 * @param   Map::Cell*     from
+			 * @param   Map::Cell*     to
+			 * @param   unsigned int   time step of the start of the move
+			 * @return  bool
+			 */
+			bool blocked(Map::Cell* a, Map::Cell* b, unsigned int t);
+
+			/**
+			 * Gets the number of reserved (cell, time) pairs.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+		protected:
+
+#ifdef WIN32
+			typedef unordered_map<pair<Map::Cell*, unsigned int>, unsigned int, Hash> RH;
+#else
+			typedef tr1::unordered_map<pair<Map::Cell*, unsigned int>, unsigned int, Hash> RH;
+#endif
+
+			/**
+			 * @var  unsigned int  first time step after all reservations
+			 */
+			unsigned int _horizon;
+
+			/**
+			 * @var  RH  reservation counts
+			 */
+			RH _reservations;
+	};
+};
+
+#endif // DSTARLITE_RESERVATION_TABLE_H
@@ -0,0 +1,275 @@
+/**
+ * Rolling Graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+
+#include "rolling_graph.h"
+
+/**
+ * @var  static const Vertex  virtual vertex past the window border
+ */
+const RollingGraph::Vertex RollingGraph::EXIT = SparseMap::coord(INT_MIN, INT_MIN);
+
+/**
+ * Constructor.
+ *
+ * @param  RollingMap*   map
+ * @param  Vertex        goal cell
+ */
+RollingGraph::RollingGraph(RollingMap* map, const Vertex& goal)
+{
+	_map = map;
+	_goal = goal;
+	_reach = 0;
+
+	for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+	{
+		_reach = max(_reach, max(abs(Neighborhood::DX[k]), abs(Neighborhood::DY[k])));
+	}
+
+	_dijkstra();
+}
+
+/**
+ * Gets the cells of a window position that have a neighbor outside it.
+ *
+ * @param   Vertex            window origin
+ * @param   vector<Vertex>&   cells (appended)
+ * @return  void
+ */
+void RollingGraph::border(const Vertex& origin, vector<Vertex>& cells)
+{
+	int size = _map->size();
+
+	for (int i = 0; i < size; i++)
+	{
+		bool row = i < _reach || i >= size - _reach;
+
+		for (int j = 0; j < size; j++)
+		{
+			// Skip the inner columns
+			if ( ! row && j == _reach)
+			{
+				j = size - _reach - 1;
+				continue;
+			}
+
+			cells.push_back(SparseMap::coord(origin.x + j, origin.y + i));
+		}
+	}
+}
+
+/**
+ * Gets the cost of moving from a cell to one of its neighbors.
+ *
+ * @param   Vertex         cell
+ * @param   unsigned int   neighbor index
+ * @return  double         cost (Math::INF if blocked or outside the window)
+ */
+double RollingGraph::cost(const Vertex& u, unsigned int k)
+{
+	Vertex v = SparseMap::coord(u.x + Neighborhood::DX[k], u.y + Neighborhood::DY[k]);
+
+	if ( ! _map->has(v))
+		return Math::INF;
+
+	double u_cost = _map->cost(u);
+	double v_cost = _map->cost(v);
+
+	if (u_cost == Map::Cell::COST_UNWALKABLE || v_cost == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	// Moves that skip a cell may not cut through walls
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			int via = Neighborhood::VIA[k][s];
+
+			if (_map->cost(SparseMap::coord(u.x + Connectivity<8>::DX[via], u.y + Connectivity<8>::DY[via])) == Map::Cell::COST_UNWALKABLE)
+				return Math::INF;
+		}
+	}
+
+	return Neighborhood::COST[k] * ((u_cost + v_cost) / 2);
+}
+
+/**
+ * Estimates the cost from a cell of the window to the goal.
+ *
+ * @param   Vertex   cell
+ * @return  double   (Math::INF if the cell does not lead to EXIT)
+ */
+double RollingGraph::exit(const Vertex& u)
+{
+	if (_map->cost(u) == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	// Goal in sight, only it leads out
+	if (_map->has(_goal))
+		return (u == _goal) ? 0.0 : Math::INF;
+
+	Vertex origin = _map->origin();
+	int size = _map->size();
+
+	if (u.x - origin.x >= _reach && u.x - origin.x < size - _reach && u.y - origin.y >= _reach && u.y - origin.y < size - _reach)
+		return Math::INF;
+
+	Map::Cell* c = _map->coarse(u);
+
+	if (c == NULL || _coarse.empty())
+		return h(u, _goal);
+
+	double dist = _coarse[c->y() * _map->coarse()->cols() + c->x()];
+
+	return (dist == Math::INF) ? Math::INF : dist * _map->scale();
+}
+
+/**
+ * Gets the goal cell.
+ *
+ * @return  Vertex
+ */
+RollingGraph::Vertex RollingGraph::goal()
+{
+	return _goal;
+}
+
+/**
+ * Estimates the cost between two vertices.
+ *
+ * Zero to EXIT, it stands for the whole border.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double RollingGraph::h(const Vertex& a, const Vertex& b)
+{
+	if (a == EXIT || b == EXIT)
+		return 0.0;
+
+	return Neighborhood::h(abs(a.x - b.x), abs(a.y - b.y));
+}
+
+/**
+ * Gets the predecessors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   predecessors and move costs (appended)
+ * @return  void
+ */
+void RollingGraph::pred(const Vertex& u, Edges& edges)
+{
+	if (u == EXIT)
+	{
+		if (_map->has(_goal))
+		{
+			edges.push_back(pair<Vertex, double>(_goal, exit(_goal)));
+			return;
+		}
+
+		_border.clear();
+		border(_map->origin(), _border);
+
+		for (vector<Vertex>::iterator it = _border.begin(); it != _border.end(); it++)
+		{
+			edges.push_back(pair<Vertex, double>(*it, exit(*it)));
+		}
+
+		return;
+	}
+
+	// Moves within the window are symmetric
+	for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+	{
+		Vertex v = SparseMap::coord(u.x + Neighborhood::DX[k], u.y + Neighborhood::DY[k]);
+
+		if (_map->has(v))
+		{
+			edges.push_back(pair<Vertex, double>(v, cost(u, k)));
+		}
+	}
+}
+
+/**
+ * Gets the successors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   successors and move costs (appended)
+ * @return  void
+ */
+void RollingGraph::succ(const Vertex& u, Edges& edges)
+{
+	if (u == EXIT)
+		return;
+
+	pred(u, edges);
+
+	double cost = exit(u);
+
+	if (cost != Math::INF)
+	{
+		edges.push_back(pair<Vertex, double>(EXIT, cost));
+	}
+}
+
+/**
+ * Computes the cost from each coarse cell to the goal.
+ *
+ * @return  void
+ */
+void RollingGraph::_dijkstra()
+{
+	Map* coarse = _map->coarse();
+	Map::Cell* goal = _map->coarse(_goal);
+
+	if (coarse == NULL || goal == NULL)
+		return;
+
+	unsigned int cols = coarse->cols();
+
+	typedef pair<double, Map::Cell*> Q_PAIR;
+	priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > open;
+
+	_coarse.assign(coarse->rows() * cols, Math::INF);
+	_coarse[goal->y() * cols + goal->x()] = 0.0;
+	open.push(Q_PAIR(0.0, goal));
+
+	while ( ! open.empty())
+	{
+		Q_PAIR top = open.top();
+		open.pop();
+
+		Map::Cell* u = top.second;
+
+		if (top.first > _coarse[u->y() * cols + u->x()])
+			continue;
+
+		Map::Cell** nbrs = u->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] == NULL || u->cost == Map::Cell::COST_UNWALKABLE || nbrs[k]->cost == Map::Cell::COST_UNWALKABLE)
+				continue;
+
+			double dist = top.first + Neighborhood::COST[k] * ((u->cost + nbrs[k]->cost) / 2);
+			unsigned int n = nbrs[k]->y() * cols + nbrs[k]->x();
+
+			if (dist < _coarse[n])
+			{
+				_coarse[n] = dist;
+				open.push(Q_PAIR(dist, nbrs[k]));
+			}
+		}
+	}
+}
@@ -0,0 +1,146 @@
+/**
+ * Rolling Graph.
+ *
+ * Window of a rolling map as a graph for the D* Lite engine.  The goal is
+ * usually outside the window, so the search runs to a virtual EXIT vertex
+ * instead: the goal cell leads to it for free when it is in the window,
+ * otherwise every border cell does, at the estimated cost from that cell to
+ * the goal.  The estimate is the cost over the coarse global map (computed
+ * once, backward from the goal), or the heuristic without one.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_ROLLING_GRAPH_H
+#define DSTARLITE_ROLLING_GRAPH_H
+
+#include <vector>
+
+#include "connectivity.h"
+#include "rolling_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class RollingGraph
+	{
+		public:
+
+			typedef SparseMap::Coord Vertex;
+			typedef SparseMap::Hash Hash;
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * @var  static const Vertex  virtual vertex past the window border
+			 */
+			static const Vertex EXIT;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  RollingMap*   map
+			 * @param  Vertex        goal cell
+			 */
+			RollingGraph(RollingMap* map, const Vertex& goal);
+
+			/**
+			 * Gets the cells of a window position that have a neighbor outside it.
+			 *
+			 * @param   Vertex            window origin
+			 * @param   vector<Vertex>&   cells (appended)
+			 * @return  void
+			 */
+			void border(const Vertex& origin, vector<Vertex>& cells);
+
+			/**
+			 * Gets the cost of moving from a cell to one of its neighbors.
+			 *
+			 * @param   Vertex         cell
+			 * @param   unsigned int   neighbor index
+			 * @return  double         cost (Math::INF if blocked or outside the window)
+			 */
+			double cost(const Vertex& u, unsigned int k);
+
+			/**
+			 * Estimates the cost from a cell of the window to the goal.
+			 *
+			 * @param   Vertex   cell
+			 * @return  double   (Math::INF if the cell does not lead to EXIT)
+			 */
+			double exit(const Vertex& u);
+
+			/**
+			 * Gets the goal cell.
+			 *
+			 * @return  Vertex
+			 */
+			Vertex goal();
+
+			/**
+			 * Estimates the cost between two vertices.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Gets the predecessors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   predecessors and move costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Gets the successors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   successors and move costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+		protected:
+
+			/**
+			 * @var  vector<double>  cost from each coarse cell to the goal (empty without a coarse map)
+			 */
+			vector<double> _coarse;
+
+			/**
+			 * @var  Vertex  goal cell
+			 */
+			Vertex _goal;
+
+			/**
+			 * @var  RollingMap*  map
+			 */
+			RollingMap* _map;
+
+			/**
+			 * @var  int  farthest neighbor offset
+			 */
+			int _reach;
+
+			/**
+			 * @var  vector<Vertex>  scratch list of border cells
+			 */
+			vector<Vertex> _border;
+
+			/**
+			 * Computes the cost from each coarse cell to the goal.
+			 *
+			 * @return  void
+			 */
+			void _dijkstra();
+	};
+};
+
+#endif // DSTARLITE_ROLLING_GRAPH_H
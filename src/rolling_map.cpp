@@ -0,0 +1,223 @@
+/**
+ * Rolling Map.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "rolling_map.h"
+
+/**
+ * Constructor.
+ *
+ * @param  unsigned int              window size (cells per side)
+ * @param  Coord                     window center
+ * @param  Map* [optional]           coarse global map (never written)
+ * @param  unsigned int [optional]   fine cells per coarse cell side
+ * @param  double [optional]         cost of cells outside the coarse map
+ */
+RollingMap::RollingMap(unsigned int size, const Coord& center, Map* coarse, unsigned int scale, double cost)
+{
+	_size = size;
+	_coarse = coarse;
+	_scale = (scale > 0) ? scale : 1;
+	_default = cost;
+
+	_origin = SparseMap::coord(center.x - (int) size / 2, center.y - (int) size / 2);
+	_costs.resize(size * size);
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		for (unsigned int j = 0; j < size; j++)
+		{
+			Coord c = SparseMap::coord(_origin.x + j, _origin.y + i);
+			_costs[_index(c)] = prior(c);
+		}
+	}
+}
+
+/**
+ * Gets the coarse global map.
+ *
+ * @return  Map*   (NULL if none)
+ */
+Map* RollingMap::coarse()
+{
+	return _coarse;
+}
+
+/**
+ * Gets the coarse cell covering a fine cell.
+ *
+ * @param   Coord        cell
+ * @return  Map::Cell*   (NULL if outside the coarse map)
+ */
+Map::Cell* RollingMap::coarse(const Coord& c)
+{
+	if (_coarse == NULL || c.x < 0 || c.y < 0)
+		return NULL;
+
+	unsigned int row = c.y / _scale;
+	unsigned int col = c.x / _scale;
+
+	if ( ! _coarse->has(row, col))
+		return NULL;
+
+	return (*_coarse)(row, col);
+}
+
+/**
+ * Gets the cost of a cell in the window.
+ *
+ * @param   Coord    cell
+ * @return  double
+ */
+double RollingMap::cost(const Coord& c)
+{
+	return _costs[_index(c)];
+}
+
+/**
+ * Checks if a cell is in the window.
+ *
+ * @param   Coord   cell
+ * @return  bool
+ */
+bool RollingMap::has(const Coord& c)
+{
+	return c.x >= _origin.x && c.x < _origin.x + (int) _size && c.y >= _origin.y && c.y < _origin.y + (int) _size;
+}
+
+/**
+ * Gets the world coordinates of the window's top left cell.
+ *
+ * @return  Coord
+ */
+RollingMap::Coord RollingMap::origin()
+{
+	return _origin;
+}
+
+/**
+ * Gets the cost a cell takes when it scrolls in.
+ *
+ * @param   Coord    cell
+ * @return  double
+ */
+double RollingMap::prior(const Coord& c)
+{
+	Map::Cell* u = coarse(c);
+
+	return (u == NULL) ? _default : u->cost;
+}
+
+/**
+ * Centers the window on a cell.
+ *
+ * Only the rows and columns that scroll in are written, the others keep
+ * their slots.
+ *
+ * @param   Coord            new center
+ * @param   vector<Coord>&   cells that scrolled out (appended)
+ * @param   vector<Coord>&   cells that scrolled in (appended)
+ * @return  void
+ */
+void RollingMap::recenter(const Coord& center, vector<Coord>& out, vector<Coord>& in)
+{
+	Coord origin = SparseMap::coord(center.x - (int) _size / 2, center.y - (int) _size / 2);
+
+	if (origin == _origin)
+		return;
+
+	unsigned int first = in.size();
+
+	_difference(_origin, origin, out);
+	_difference(origin, _origin, in);
+
+	_origin = origin;
+
+	for (unsigned int i = first; i < in.size(); i++)
+	{
+		_costs[_index(in[i])] = prior(in[i]);
+	}
+}
+
+/**
+ * Gets the fine cells per coarse cell side.
+ *
+ * @return  unsigned int
+ */
+unsigned int RollingMap::scale()
+{
+	return _scale;
+}
+
+/**
+ * Sets the cost of a cell in the window.
+ *
+ * @param   Coord    cell
+ * @param   double   cost
+ * @return  void
+ */
+void RollingMap::set(const Coord& c, double cost)
+{
+	_costs[_index(c)] = cost;
+}
+
+/**
+ * Gets the window size (cells per side).
+ *
+ * @return  unsigned int
+ */
+unsigned int RollingMap::size()
+{
+	return _size;
+}
+
+/**
+ * Lists the cells of one window position that are not in another.
+ *
+ * @param   Coord            origin of the window listed
+ * @param   Coord            origin of the window left out
+ * @param   vector<Coord>&   cells (appended)
+ * @return  void
+ */
+void RollingMap::_difference(const Coord& a, const Coord& b, vector<Coord>& cells)
+{
+	int size = _size;
+
+	for (int y = a.y; y < a.y + size; y++)
+	{
+		bool row = y < b.y || y >= b.y + size;
+
+		for (int x = a.x; x < a.x + size; x++)
+		{
+			// Skip the columns both windows share
+			if ( ! row && x >= b.x && x < b.x + size)
+			{
+				x = b.x + size - 1;
+				continue;
+			}
+
+			cells.push_back(SparseMap::coord(x, y));
+		}
+	}
+}
+
+/**
+ * Gets the ring buffer slot of a cell.
+ *
+ * @param   Coord          cell
+ * @return  unsigned int
+ */
+unsigned int RollingMap::_index(const Coord& c)
+{
+	int size = _size;
+
+	// Modulo that stays positive for negative coordinates
+	int i = ((c.y % size) + size) % size;
+	int j = ((c.x % size) + size) % size;
+
+	return i * size + j;
+}
@@ -0,0 +1,178 @@
+/**
+ * Rolling Map.
+ *
+ * Square window of fine costs centered on the robot, for long traverses.
+ * The window is a ring buffer indexed by world coordinates modulo its size,
+ * recentering only moves the origin and resets the cells that scroll in, so
+ * nothing is copied and memory stays constant however far the robot goes.
+ *
+ * Cells that scroll in take their cost from an optional coarse global map
+ * (one coarse cell covers scale x scale fine cells), or the default cost.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_ROLLING_MAP_H
+#define DSTARLITE_ROLLING_MAP_H
+
+#include <vector>
+
+#include "map.h"
+#include "sparse_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class RollingMap
+	{
+		public:
+
+			typedef SparseMap::Coord Coord;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  unsigned int              window size (cells per side)
+			 * @param  Coord                     window center
+			 * @param  Map* [optional]           coarse global map (never written)
+			 * @param  unsigned int [optional]   fine cells per coarse cell side
+			 * @param  double [optional]         cost of cells outside the coarse map
+			 */
+			RollingMap(unsigned int size, const Coord& center, Map* coarse = NULL, unsigned int scale = 1, double cost = 1.0);
+
+			/**
+			 * Gets the coarse global map.
+			 *
+			 * @return  Map*   (NULL if none)
+			 */
+			Map* coarse();
+
+			/**
+			 * Gets the coarse cell covering a fine cell.
+			 *
+			 * @param   Coord        cell
+			 * @return  Map::Cell*   (NULL if outside the coarse map)
+			 */
+			Map::Cell* coarse(const Coord& c);
+
+			/**
+			 * Gets the cost of a cell in the window.
+			 *
+			 * @param   Coord    cell
+			 * @return  double
+			 */
+			double cost(const Coord& c);
+
+			/**
+			 * Checks if a cell is in the window.
+			 *
+			 * @param   Coord   cell
+			 * @return  bool
+			 */
+			bool has(const Coord& c);
+
+			/**
+			 * Gets the world coordinates of the window's top left cell.
+			 *
+			 * @return  Coord
+			 */
+			Coord origin();
+
+			/**
+			 * Gets the cost a cell takes when it scrolls in.
+			 *
+			 * @param   Coord    cell
+			 * @return  double
+			 */
+			double prior(const Coord& c);
+
+			/**
+			 * Centers the window on a cell.
+			 *
+			 * @param   Coord            new center
+			 * @param   vector<Coord>&   cells that scrolled out (appended)
+			 * @param   vector<Coord>&   cells that scrolled in (appended)
+			 * @return  void
+			 */
+			void recenter(const Coord& center, vector<Coord>& out, vector<Coord>& in);
+
+			/**
+			 * Gets the fine cells per coarse cell side.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int scale();
+
+			/**
+			 * Sets the cost of a cell in the window.
+			 *
+			 * @param   Coord    cell
+			 * @param   double   cost
+			 * @return  void
+			 */
+			void set(const Coord& c, double cost);
+
+			/**
+			 * Gets the window size (cells per side).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+		protected:
+
+			/**
+			 * @var  Map*  coarse global map (NULL if none)
+			 */
+			Map* _coarse;
+
+			/**
+			 * @var  vector<double>  ring buffer of costs
+			 */
+			vector<double> _costs;
+
+			/**
+			 * @var  double  cost of cells outside the coarse map
+			 */
+			double _default;
+
+			/**
+			 * @var  Coord  world coordinates of the window's top left cell
+			 */
+			Coord _origin;
+
+			/**
+			 * @var  unsigned int  fine cells per coarse cell side
+			 */
+			unsigned int _scale;
+
+			/**
+			 * @var  unsigned int  window size
+			 */
+			unsigned int _size;
+
+			/**
+			 * Lists the cells of one window position that are not in another.
+			 *
+			 * @param   Coord            origin of the window listed
+			 * @param   Coord            origin of the window left out
+			 * @param   vector<Coord>&   cells (appended)
+			 * @return  void
+			 */
+			void _difference(const Coord& a, const Coord& b, vector<Coord>& cells);
+
+			/**
+			 * Gets the ring buffer slot of a cell.
+			 *
+			 * @param   Coord          cell
+			 * @return  unsigned int
+			 */
+			unsigned int _index(const Coord& c);
+	};
+};
+
+#endif // DSTARLITE_ROLLING_MAP_H
@@ -0,0 +1,226 @@
+/**
+ * Rolling Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "rolling_planner.h"
+
+/**
+ * Constructor.
+ *
+ * @param  unsigned int              window size (cells per side)
+ * @param  SparseMap::Coord          start cell
+ * @param  SparseMap::Coord          goal cell
+ * @param  Map* [optional]           coarse global map (never written)
+ * @param  unsigned int [optional]   fine cells per coarse cell side
+ * @param  double [optional]         cost of cells outside the coarse map
+ */
+RollingPlanner::RollingPlanner(unsigned int size, const SparseMap::Coord& start, const SparseMap::Coord& goal, Map* coarse, unsigned int scale, double cost)
+{
+	_map = new RollingMap(size, start, coarse, scale, cost);
+	_graph = new RollingGraph(_map, goal);
+	_engine = new Engine<RollingGraph>(_graph, start, RollingGraph::EXIT);
+}
+
+/**
+ * Deconstructor.
+ */
+RollingPlanner::~RollingPlanner()
+{
+	delete _engine;
+	delete _graph;
+	delete _map;
+}
+
+/**
+ * Gets the cost of a cell in the window.
+ *
+ * @param   SparseMap::Coord   cell
+ * @return  double
+ */
+double RollingPlanner::cost(const SparseMap::Coord& c)
+{
+	return _map->cost(c);
+}
+
+/**
+ * Gets the number of cells expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int RollingPlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the graph.
+ *
+ * @return  RollingGraph*
+ */
+RollingGraph* RollingPlanner::graph()
+{
+	return _graph;
+}
+
+/**
+ * Gets the map.
+ *
+ * @return  RollingMap*
+ */
+RollingMap* RollingPlanner::map()
+{
+	return _map;
+}
+
+/**
+ * Gets the path from the last replan (up to the goal or the window border).
+ *
+ * @return  list<SparseMap::Coord>
+ */
+list<SparseMap::Coord> RollingPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool RollingPlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	// Drop the virtual exit
+	_path.pop_back();
+
+	return true;
+}
+
+/**
+ * Gets the number of cells the engine holds state for.
+ *
+ * @return  unsigned int
+ */
+unsigned int RollingPlanner::size()
+{
+	return _engine->size();
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  SparseMap::Coord
+ */
+SparseMap::Coord RollingPlanner::start()
+{
+	return _engine->start();
+}
+
+/**
+ * Moves the start, the window follows.
+ *
+ * @param   SparseMap::Coord   new start
+ * @return  void
+ */
+void RollingPlanner::start(const SparseMap::Coord& c)
+{
+	vector<SparseMap::Coord> out, in, border;
+
+	// Border edges of the old position, some of them go away
+	_graph->border(_map->origin(), border);
+
+	_map->recenter(c, out, in);
+
+	for (vector<SparseMap::Coord>::iterator it = out.begin(); it != out.end(); it++)
+	{
+		_engine->forget(*it);
+	}
+
+	// Cells that scrolled in, and the ones next to them lost their border edge or gained one
+	_graph->border(_map->origin(), border);
+
+	for (vector<SparseMap::Coord>::iterator it = in.begin(); it != in.end(); it++)
+	{
+		_engine->update(*it);
+	}
+
+	for (vector<SparseMap::Coord>::iterator it = border.begin(); it != border.end(); it++)
+	{
+		_update(*it);
+	}
+
+	_engine->start(c);
+}
+
+/**
+ * Update map (cells outside the window are ignored).
+ *
+ * @param   SparseMap::Coord   cell to update
+ * @param   double             new cost of the cell
+ * @return  void
+ */
+void RollingPlanner::update(const SparseMap::Coord& c, double cost)
+{
+	if ( ! _map->has(c))
+		return;
+
+	double old = _map->cost(c);
+
+	if (old == cost)
+		return;
+
+	_map->set(c, cost);
+
+	// The cell's moves and its neighbors' moves into it changed
+	_update(c);
+
+	for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+	{
+		_update(SparseMap::coord(c.x + Neighborhood::DX[k], c.y + Neighborhood::DY[k]));
+	}
+
+	// So did the moves passing over it, when it became or stopped being a wall
+	if (Neighborhood::VIAS && (old == Map::Cell::COST_UNWALKABLE) != (cost == Map::Cell::COST_UNWALKABLE))
+	{
+		for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+		{
+			if (Neighborhood::VIA[k][0] < 0)
+				continue;
+
+			for (unsigned int s = 0; s < 2; s++)
+			{
+				int via = Neighborhood::VIA[k][s];
+
+				SparseMap::Coord a = SparseMap::coord(c.x - Connectivity<8>::DX[via], c.y - Connectivity<8>::DY[via]);
+
+				_update(a);
+				_update(SparseMap::coord(a.x + Neighborhood::DX[k], a.y + Neighborhood::DY[k]));
+			}
+		}
+	}
+}
+
+/**
+ * Repairs a cell if it is in the window.
+ *
+ * @param   SparseMap::Coord   cell
+ * @return  void
+ */
+void RollingPlanner::_update(const SparseMap::Coord& c)
+{
+	if (_map->has(c))
+	{
+		_engine->update(c);
+	}
+}
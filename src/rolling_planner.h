@@ -0,0 +1,162 @@
+/**
+ * Rolling Planner.
+ *
+ * D* Lite over a fixed size window centered on the robot, for long
+ * traverses where the full map does not fit in memory.  The window plans to
+ * the goal when it sees it, otherwise to its border, where each cell leads
+ * on at the coarse cost-to-go (see RollingGraph).
+ *
+ * When the robot moves the window scrolls with it: the cells that scroll out
+ * are forgotten by the engine, the cells that scroll in and the ones whose
+ * border edge appeared or went away are repaired like changed cells.  The
+ * engine never holds more than the window, so memory stays constant however
+ * far the robot goes.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_ROLLING_PLANNER_H
+#define DSTARLITE_ROLLING_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "engine.h"
+#include "rolling_graph.h"
+#include "rolling_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class RollingPlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  unsigned int              window size (cells per side)
+			 * @param  SparseMap::Coord          start cell
+			 * @param  SparseMap::Coord          goal cell
+			 * @param  Map* [optional]           coarse global map (never written)
+			 * @param  unsigned int [optional]   fine cells per coarse cell side
+			 * @param  double [optional]         cost of cells outside the coarse map
+			 */
+			RollingPlanner(unsigned int size, const SparseMap::Coord& start, const SparseMap::Coord& goal, Map* coarse = NULL, unsigned int scale = 1, double cost = 1.0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~RollingPlanner();
+
+			/**
+			 * Gets the cost of a cell in the window.
+			 *
+			 * @param   SparseMap::Coord   cell
+			 * @return  double
+			 */
+			double cost(const SparseMap::Coord& c);
+
+			/**
+			 * Gets the number of cells expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the graph.
+			 *
+			 * @return  RollingGraph*
+			 */
+			RollingGraph* graph();
+
+			/**
+			 * Gets the map.
+			 *
+			 * @return  RollingMap*
+			 */
+			RollingMap* map();
+
+			/**
+			 * Gets the path from the last replan (up to the goal or the window border).
+			 *
+			 * @return  list<SparseMap::Coord>
+			 */
+			list<SparseMap::Coord> path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the number of cells the engine holds state for.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  SparseMap::Coord
+			 */
+			SparseMap::Coord start();
+
+			/**
+			 * Moves the start, the window follows.
+			 *
+			 * @param   SparseMap::Coord   new start
+			 * @return  void
+			 */
+			void start(const SparseMap::Coord& c);
+
+			/**
+			 * Update map (cells outside the window are ignored).
+			 *
+			 * @param   SparseMap::Coord   cell to update
+			 * @param   double             new cost of the cell
+			 * @return  void
+			 */
+			void update(const SparseMap::Coord& c, double cost);
+
+		protected:
+
+			/**
+			 * @var  Engine<RollingGraph>*  D* Lite engine
+			 */
+			Engine<RollingGraph>* _engine;
+
+			/**
+			 * @var  RollingGraph*  graph
+			 */
+			RollingGraph* _graph;
+
+			/**
+			 * @var  RollingMap*  map
+			 */
+			RollingMap* _map;
+
+			/**
+			 * @var  list<SparseMap::Coord>  path
+			 */
+			list<SparseMap::Coord> _path;
+
+			/**
+			 * Repairs a cell if it is in the window.
+			 *
+			 * @param   SparseMap::Coord   cell
+			 * @return  void
+			 */
+			void _update(const SparseMap::Coord& c);
+	};
+};
+
+#endif // DSTARLITE_ROLLING_PLANNER_H
@@ -0,0 +1,240 @@
+/**
+ * Scanner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+#include <stdlib.h>
+
+#include "math.h"
+#include "scanner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  unsigned int  number of one cell move directions (including no move)
+ */
+const unsigned int Scanner::NUM_DIRS = 9;
+
+/**
+ * Constructor.
+ *
+ * @param  unsigned int              scan radius
+ * @param  unsigned int [optional]   number of beams (0 for no ray tables)
+ */
+Scanner::Scanner(unsigned int radius, unsigned int beams)
+{
+	_radius = radius;
+	_beams = beams;
+	_steps = 0;
+
+	int r = (int) radius;
+
+	// Disk (same strict bound the simulator has always used)
+	for (int dy = -r; dy <= r; dy++)
+	{
+		for (int dx = -r; dx <= r; dx++)
+		{
+			if (has(dx, dy))
+			{
+				_disk.push_back(Offset(dx, dy));
+			}
+		}
+	}
+
+	// Crescents, cells in the new disk that were not in the old disk
+	_crescents = new vector<Offset>[Scanner::NUM_DIRS];
+
+	for (int mx = -1; mx <= 1; mx++)
+	{
+		for (int my = -1; my <= 1; my++)
+		{
+			vector<Offset>* crescent = &_crescents[_dir(mx, my)];
+
+			for (unsigned int i = 0; i < _disk.size(); i++)
+			{
+				if ( ! has(_disk[i].first + mx, _disk[i].second + my))
+				{
+					crescent->push_back(_disk[i]);
+				}
+			}
+		}
+	}
+
+	if (beams == 0)
+		return;
+
+	// Bresenham rays from the center (excluded) to the edge of the disk
+	vector< vector<Offset> > rays(beams);
+
+	for (unsigned int b = 0; b < beams; b++)
+	{
+		double angle = 2.0 * Math::PI * b / beams;
+		int x1 = (int) floor(r * cos(angle) + 0.5);
+		int y1 = (int) floor(r * sin(angle) + 0.5);
+
+		int dx = abs(x1), sx = (x1 < 0) ? -1 : 1;
+		int dy = -abs(y1), sy = (y1 < 0) ? -1 : 1;
+		int err = dx + dy;
+		int x = 0, y = 0;
+
+		while (x != x1 || y != y1)
+		{
+			int e2 = 2 * err;
+
+			if (e2 >= dy)
+			{
+				err += dy;
+				x += sx;
+			}
+
+			if (e2 <= dx)
+			{
+				err += dx;
+				y += sy;
+			}
+
+			if ( ! has(x, y))
+				break;
+
+			rays[b].push_back(Offset(x, y));
+		}
+
+		_ray_lengths.push_back(rays[b].size());
+
+		if (rays[b].size() > _steps)
+		{
+			_steps = rays[b].size();
+		}
+	}
+
+	// Step major, shorter beams are padded with their last offset
+	_rays.resize(_steps * beams);
+
+	for (unsigned int s = 0; s < _steps; s++)
+	{
+		for (unsigned int b = 0; b < beams; b++)
+		{
+			_rays[s * beams + b] = rays[b].empty() ? Offset(0, 0) : rays[b][min(s, (unsigned int) rays[b].size() - 1)];
+		}
+	}
+}
+
+/**
+ * Deconstructor.
+ */
+Scanner::~Scanner()
+{
+	delete[] _crescents;
+}
+
+/**
+ * Gets the number of beams.
+ *
+ * @return  unsigned int
+ */
+unsigned int Scanner::beams()
+{
+	return _beams;
+}
+
+/**
+ * Gets the offsets of the newly uncovered crescent after a one cell move.
+ *
+ * @param   int   x move (-1, 0, 1)
+ * @param   int   y move (-1, 0, 1)
+ * @return  vector<Offset>&
+ */
+vector<Scanner::Offset>& Scanner::crescent(int dx, int dy)
+{
+	return _crescents[_dir(dx, dy)];
+}
+
+/**
+ * Gets the offsets of the full scan disk.
+ *
+ * @return  vector<Offset>&
+ */
+vector<Scanner::Offset>& Scanner::disk()
+{
+	return _disk;
+}
+
+/**
+ * Checks if an offset lies within the scan disk.
+ *
+ * @param   int   x offset
+ * @param   int   y offset
+ * @return  bool
+ */
+bool Scanner::has(int dx, int dy)
+{
+	return (unsigned int) (dx * dx + dy * dy) < _radius * _radius;
+}
+
+/**
+ * Gets the scan radius.
+ *
+ * @return  unsigned int
+ */
+unsigned int Scanner::radius()
+{
+	return _radius;
+}
+
+/**
+ * Gets the number of steps of a beam.
+ *
+ * @param   unsigned int   beam
+ * @return  unsigned int
+ */
+unsigned int Scanner::ray_length(unsigned int beam)
+{
+	return _ray_lengths[beam];
+}
+
+/**
+ * Gets the number of steps of every beam.
+ *
+ * @return  vector<unsigned int>&
+ */
+vector<unsigned int>& Scanner::ray_lengths()
+{
+	return _ray_lengths;
+}
+
+/**
+ * Gets the ray offsets, step major (offset of beam b at step s is at s * beams() + b).
+ *
+ * @return  vector<Offset>&
+ */
+vector<Scanner::Offset>& Scanner::rays()
+{
+	return _rays;
+}
+
+/**
+ * Gets the number of steps of the longest beam.
+ *
+ * @return  unsigned int
+ */
+unsigned int Scanner::steps()
+{
+	return _steps;
+}
+
+/**
+ * Maps a one cell move to its direction index.
+ *
+ * @param   int   x move (-1, 0, 1)
+ * @param   int   y move (-1, 0, 1)
+ * @return  unsigned int
+ */
+unsigned int Scanner::_dir(int dx, int dy)
+{
+	return (unsigned int) ((dx + 1) * 3 + (dy + 1));
+}
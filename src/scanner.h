@@ -0,0 +1,172 @@
+/**
+ * Scanner.
+ *
+ * Precomputed offset tables for the simulated circular scanner.  The full disk
+ * is only needed the first time the robot scans (or after a jump); after a one
+ * cell move only the newly uncovered crescent of the disk has to be checked.
+ *
+ * For the raycast model the scanner also keeps one Bresenham ray per beam,
+ * stored step major so all beams can be advanced in lockstep.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_SCANNER_H
+#define DSTARLITE_SCANNER_H
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace DStarLite
+{
+	class Scanner
+	{
+		public:
+
+			/**
+			 * @var  offset (dx, dy) from the scanner center
+			 */
+			typedef pair<int,int> Offset;
+
+			/**
+			 * @var  static const unsigned int  number of one cell move directions
+			 */
+			static const unsigned int NUM_DIRS;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  unsigned int              scan radius
+			 * @param  unsigned int [optional]   number of beams (0 for no ray tables)
+			 */
+			Scanner(unsigned int radius, unsigned int beams = 0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~Scanner();
+
+			/**
+			 * Gets the number of beams.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int beams();
+
+			/**
+			 * Gets the offsets of the newly uncovered crescent after a one cell move.
+			 *
+			 * Offsets are relative to the new center; the old center is the new
+			 * center minus (dx, dy).
+			 *
+			 * @param   int   x move (-1, 0, 1)
+			 * @param   int   y move (-1, 0, 1)
+			 * @return  vector<Offset>&
+			 */
+			vector<Offset>& crescent(int dx, int dy);
+
+			/**
+			 * Gets the offsets of the full scan disk.
+			 *
+			 * @return  vector<Offset>&
+			 */
+			vector<Offset>& disk();
+
+			/**
+			 * Checks if an offset lies within the scan disk.
+			 *
+			 * @param   int   x offset
+			 * @param   int   y offset
+			 * @return  bool
+			 */
+			bool has(int dx, int dy);
+
+			/**
+			 * Gets the scan radius.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int radius();
+
+			/**
+			 * Gets the number of steps of a beam.
+			 *
+			 * @param   unsigned int   beam
+			 * @return  unsigned int
+			 */
+			unsigned int ray_length(unsigned int beam);
+
+			/**
+			 * Gets the number of steps of every beam.
+			 *
+			 * @return  vector<unsigned int>&
+			 */
+			vector<unsigned int>& ray_lengths();
+
+			/**
+			 * Gets the ray offsets, step major (offset of beam b at step s is at s * beams() + b).
+			 *
+			 * @return  vector<Offset>&
+			 */
+			vector<Offset>& rays();
+
+			/**
+			 * Gets the number of steps of the longest beam.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int steps();
+
+		protected:
+
+			/**
+			 * @var  unsigned int  number of beams
+			 */
+			unsigned int _beams;
+
+			/**
+			 * @var  vector<Offset>*  crescent offsets, one list per move direction
+			 */
+			vector<Offset>* _crescents;
+
+			/**
+			 * @var  vector<Offset>  disk offsets
+			 */
+			vector<Offset> _disk;
+
+			/**
+			 * @var  unsigned int  scan radius
+			 */
+			unsigned int _radius;
+
+			/**
+			 * @var  vector<unsigned int>  number of steps of each beam
+			 */
+			vector<unsigned int> _ray_lengths;
+
+			/**
+			 * @var  vector<Offset>  ray offsets (step major)
+			 */
+			vector<Offset> _rays;
+
+			/**
+			 * @var  unsigned int  number of steps of the longest beam
+			 */
+			unsigned int _steps;
+
+			/**
+			 * Maps a one cell move to its direction index.
+			 *
+			 * @param   int   x move (-1, 0, 1)
+			 * @param   int   y move (-1, 0, 1)
+			 * @return  unsigned int
+			 */
+			static unsigned int _dir(int dx, int dy);
+	};
+};
+
+#endif // DSTARLITE_SCANNER_H
@@ -13,6 +13,11 @@
  */
 const double Simulator::COST_DIFFERENCE = 255.0;
 
+/**
+ * @var  double  extra cost of a cell touching an obstacle (inflation)
+ */
+const double Simulator::INFLATION_COST = 1000.0;
+
 /**
  * @var  double  unwalkable value of bitmap
  */
@@ -158,6 +163,18 @@ Simulator::Simulator(char* name, Config config)
 	// Sert the scan radius
 	_robot_widget->scan_radius = config.scan_radius;
 
+	// Precompute scan offsets
+	_scanner = new Scanner(config.scan_radius, config.beams);
+	_scanned = NULL;
+
+	// Precompute map discrepancies
+	_index = NULL;
+
+	if (config.index || config.fast_forward)
+	{
+		_index = new DiscrepancyIndex(_robot_widget->data, _real_widget->data, img_height, img_width);
+	}
+
 	// Make the map
 	_map = new Map(img_height, img_width);
 
@@ -170,28 +187,69 @@ Simulator::Simulator(char* name, Config config)
 	{
 		for (int j = 0; j < img_width; j++)
 		{
-			int k = (i * img_width) + j;
-			double v = (double) _robot_widget->data[k];
+			(*_map)(i, j)->cost = _cost(i, j);
+		}
+	}
 
-			// Cell is unwalkable
-			if (v == Simulator::UNWALKABLE_CELL)
-			{
-				v = Map::Cell::COST_UNWALKABLE;
-			}
-			else
+	// Stack the costmap layers on top of the prior map
+	_costmap = new Costmap(_map);
+	_costmap->add(new StaticLayer(_map));
+	_sensor = (SensorLayer*) _costmap->add(new SensorLayer(_map));
+
+	// Observed obstacles expire unless observed again
+	_decay = NULL;
+	_tick = 0;
+
+	if (config.decay > 0)
+	{
+		_decay = (DecayLayer*) _costmap->add(new DecayLayer(_map));
+		_prior.assign(_robot_widget->data, _robot_widget->data + img_width * img_height);
+	}
+
+	if (config.inflate)
+	{
+		_costmap->add(new InflationLayer(_map, (double) _robot_widget->robot_radius, Simulator::INFLATION_COST));
+	}
+
+	if ( ! config.keep_out.empty())
+	{
+		KeepOutLayer* keep_out = new KeepOutLayer(_map);
+
+		for (unsigned int i = 0; i + 3 < config.keep_out.size(); i += 4)
+		{
+			// Make sure both corners are on the map
+			if (config.keep_out[i] >= _map->rows() || config.keep_out[i + 2] >= _map->rows()
+				|| config.keep_out[i + 1] >= _map->cols() || config.keep_out[i + 3] >= _map->cols())
 			{
-				v = Simulator::COST_DIFFERENCE - v + 1.0;
+				fl_alert("Keep Out Zone Is Outside The Map!");
+				throw;
 			}
 
-			(*_map)(i, j)->cost = v;
+			keep_out->add((*_map)(config.keep_out[i], config.keep_out[i + 1]), (*_map)(config.keep_out[i + 2], config.keep_out[i + 3]));
 		}
+
+		_costmap->add(keep_out);
 	}
 
-	// Make planner
-	_planner = new Planner(_map, _robot_widget->current, _robot_widget->goal);
+	// The planner starts from the composite costs
+	_costmap->compose();
+
+	// Make planner, the lattice planner starts facing the goal
+	_planner = NULL;
+	_lattice = NULL;
+
+	if (config.lattice)
+	{
+		unsigned int heading = Lattice::heading((int) _robot_widget->goal->x() - (int) _robot_widget->current->x(), (int) _robot_widget->goal->y() - (int) _robot_widget->current->y());
+		_lattice = new LatticePlanner(_map, _robot_widget->current, heading, _robot_widget->goal);
+	}
+	else
+	{
+		_planner = new Planner(_map, _robot_widget->current, _robot_widget->goal);
+	}
 
 	// Push start position
-	_real_widget->path_traversed.push_back(_planner->start());
+	_real_widget->path_traversed.push_back(_robot_widget->current);
 }
 
 /**
@@ -201,6 +259,10 @@ Simulator::~Simulator()
 {
 	delete _map;
 	delete _planner;
+	delete _lattice;
+	delete _scanner;
+	delete _index;
+	delete _costmap;
 	delete _window;
 }
 
@@ -223,10 +285,9 @@ int Simulator::draw()
  */
 int Simulator::execute()
 {
-	if (_planner->start() == _planner->goal())
+	if (_robot_widget->current == _robot_widget->goal)
 	{
 		fl_alert("Goal Reached!");
-		_real_widget->current = _robot_widget->current = _planner->goal();
 		return 1;
 	}
 
@@ -234,26 +295,28 @@ int Simulator::execute()
 	if (update_map())
 	{
 		// Replan the path
-		if ( ! _planner->replan())
+		if ( ! _replan())
 		{
 			fl_alert("No Solution Found!");
 			throw;
 		}
+	}
 
-		_robot_widget->path_planned = _planner->path();
+	// Step
+	_step();
+
+	if (_config.fast_forward)
+	{
+		unsigned int radius = _scanner->radius();
 
-		if ( ! _robot_widget->path_planned.empty())
+		// Keep stepping until the scan circle reaches a discrepancy, nothing can change before then
+		while ( ! _robot_widget->path_planned.empty() && _robot_widget->current != _robot_widget->goal
+			&& ! _index->any(_robot_widget->current->x(), _robot_widget->current->y(), radius))
 		{
-			_robot_widget->path_planned.pop_front();
+			_step();
 		}
 	}
 
-	// Step
-	_real_widget->path_traversed.push_back(_robot_widget->path_planned.front());
-	_planner->start(_robot_widget->path_planned.front());
-	_real_widget->current = _robot_widget->current = _planner->start();
-	_robot_widget->path_planned.pop_front();
-
 	return 0;
 }
 
@@ -269,14 +332,12 @@ bool Simulator::init()
 
 	_init = true;
 
-	if ( ! _planner->replan())
+	if ( ! _replan())
 	{
 		fl_alert("No Solution Found!");
 		throw;
 	}
 
-	_robot_widget->path_planned = _planner->path();
-
 	return false;
 }
 
@@ -293,6 +354,15 @@ void Simulator::redraw()
 /*
  * Scans map for updated tiles.
  *
+ * The raycast scanner only reveals cells up to (and including) the first
+ * unwalkable cell along each beam.  For the see through scanner with the
+ * discrepancy index only the known discrepancies inside the disk are
+ * visited.  Otherwise only the crescent uncovered since the last scan is
+ * checked after a one cell move, everything else inside the disk was
+ * already checked.
+ * Observed costs go into the sensor layer, the costmap is recomposed once
+ * after the scan.
+ *
  * @return  bool  updates found
  */
 bool Simulator::update_map()
@@ -301,60 +371,336 @@ bool Simulator::update_map()
 
 	Map::Cell* current = _robot_widget->current;
 
-	unsigned int x, y;
+	int x, y;
 	x = current->x();
 	y = current->y();
 
-	// Radius^2
-	unsigned int radius = _robot_widget->scan_radius;
-	unsigned int radius2 = radius * radius;
-
-	unsigned int rows, cols;
+	int rows, cols;
 	rows = _map->rows();
 	cols = _map->cols();
 
-	// Make an imaginary box around the scan circle
-	unsigned int max_x, max_y, min_x, min_y;
-	max_x = (x + radius < cols) ? x + radius : cols;
-	max_y = (y + radius < rows) ? y + radius : rows;
-	min_x = (x > radius) ? x - radius : 0;
-	min_y = (y > radius) ? y - radius : 0;
+	// Expired obstacles are reverted in the same batch as the scan
+	if (_decay != NULL && _expire(x, y))
+	{
+		error = true;
+	}
+
+	if (_scanner->beams() > 0)
+	{
+		// Skip the scan if nothing is left to discover within range
+		if ((_index == NULL || _index->any(x, y, _scanner->radius())) && _raycast(x, y))
+		{
+			error = true;
+		}
+	}
+	else if (_index != NULL)
+	{
+		vector<unsigned int> found;
+		_index->take(x, y, _scanner->radius(), found);
 
-	for (unsigned int i = min_y; i < max_y; i++)
+		for (vector<unsigned int>::iterator it = found.begin(); it != found.end(); it++)
+		{
+			if (_scan(*it / cols, *it % cols))
+			{
+				error = true;
+			}
+		}
+	}
+	else
 	{
-		int dy = y - i;
-		unsigned int dy2 = dy * dy;
+		vector<Scanner::Offset>* offsets = &_scanner->disk();
 
-		for (unsigned int j = min_x; j < max_x; j++)
+		if (_scanned != NULL)
 		{
-			int dx = x - j;
-			
-			if ((dx * dx) + dy2 < radius2)
+			int dx = x - (int) _scanned->x();
+			int dy = y - (int) _scanned->y();
+
+			if (dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1)
 			{
-				unsigned int k = (i * cols) + j;
+				offsets = &_scanner->crescent(dx, dy);
+			}
+		}
 
-				// Check if an update is required
-				if (_robot_widget->data[k] != _real_widget->data[k])
-				{
-					error = true;
+		_scanned = current;
+
+		for (vector<Scanner::Offset>::iterator it = offsets->begin(); it != offsets->end(); it++)
+		{
+			int i = y + it->second;
+			int j = x + it->first;
+
+			if (i < 0 || i >= rows || j < 0 || j >= cols)
+				continue;
+
+			if (_scan(i, j))
+			{
+				error = true;
+			}
+		}
+	}
+
+	// Hand the recomposed cells to the planner in one batch
+	if (error)
+	{
+		_costmap->update(_changed, _changed_costs);
+		if (_lattice != NULL)
+		{
+			_lattice->update(_changed, _changed_costs);
+		}
+		else
+		{
+			_planner->update(_changed, _changed_costs);
+		}
+
+		_changed.clear();
+		_changed_costs.clear();
+	}
+
+	return error;
+}
+
+/**
+ * Gets the cost of a cell as known by the robot.
+ *
+ * @param   unsigned int   row
+ * @param   unsigned int   col
+ * @return  double
+ */
+double Simulator::_cost(unsigned int row, unsigned int col)
+{
+	double v = (double) _robot_widget->data[(row * _map->cols()) + col];
+
+	// Cell is unwalkable
+	if (v == Simulator::UNWALKABLE_CELL)
+		return Map::Cell::COST_UNWALKABLE;
+
+	return Simulator::COST_DIFFERENCE - v + 1.0;
+}
+
+/**
+ * Forgets the expired obstacles, those still in view are observed again.
+ *
+ * The robot map reverts to the prior for expired cells, so the scanner
+ * (or the discrepancy index) finds them again once they come into view.
+ *
+ * @param   int    x-coordinate
+ * @param   int    y-coordinate
+ * @return  bool   updates found
+ */
+bool Simulator::_expire(int x, int y)
+{
+	_tick++;
+
+	if (_decay->expire(_tick, _expired) == 0)
+		return false;
+
+	unsigned int cols = _map->cols();
+
+	for (vector<Map::Cell*>::iterator it = _expired.begin(); it != _expired.end(); it++)
+	{
+		unsigned int k = (*it)->y() * cols + (*it)->x();
+		_robot_widget->data[k] = _prior[k];
+
+		// The raycast scanner looks at every visible cell anyway
+		if (_scanner->beams() == 0 && _scanner->has((int) (*it)->x() - x, (int) (*it)->y() - y))
+		{
+			_scan((*it)->y(), (*it)->x());
+		}
+		else if (_index != NULL)
+		{
+			_index->add(k);
+		}
+	}
+
+	_expired.clear();
+
+	return true;
+}
+
+/**
+ * Casts all beams from a position, stopping each at the first unwalkable cell.
+ *
+ * Beams are advanced in lockstep over the step major ray table.  Each step
+ * is split in two passes: a branch free pass over the contiguous offsets
+ * works out the cell of every beam and which beams are still live, then a
+ * scalar pass scans the cells of the live beams and stops the blocked ones.
+ *
+ * @param   int    x-coordinate
+ * @param   int    y-coordinate
+ * @return  bool   updates found
+ */
+bool Simulator::_raycast(int x, int y)
+{
+	bool error = false;
+
+	int rows, cols;
+	rows = _map->rows();
+	cols = _map->cols();
+
+	unsigned int beams = _scanner->beams();
+	unsigned int steps = _scanner->steps();
+
+	unsigned char* real = _real_widget->data;
+	unsigned char unwalkable = (unsigned char) Simulator::UNWALKABLE_CELL;
+
+	// Own cell
+	if (_scan(y, x))
+	{
+		error = true;
+	}
+
+	if (steps == 0)
+		return error;
+
+	Scanner::Offset* rays = &_scanner->rays()[0];
+	unsigned int* lengths = &_scanner->ray_lengths()[0];
+
+	_active.assign(beams, 1);
+	_beam_cells.resize(beams);
+
+	unsigned char* active = &_active[0];
+	int* cells = &_beam_cells[0];
+
+	unsigned int alive = beams;
+
+	for (unsigned int s = 0; s < steps && alive > 0; s++)
+	{
+		Scanner::Offset* step = rays + s * beams;
+
+		// Cells and live beams, no branches (beam ended or left the map)
+		for (unsigned int b = 0; b < beams; b++)
+		{
+			int i = y + step[b].second;
+			int j = x + step[b].first;
+
+			active[b] &= (s < lengths[b]) & (i >= 0) & (i < rows) & (j >= 0) & (j < cols);
+			cells[b] = i * cols + j;
+		}
 
-					_robot_widget->data[k] = _real_widget->data[k];
-					double v = (double) _robot_widget->data[k];
+		// Scan the cells of the live beams
+		alive = 0;
 
-					if (v == Simulator::UNWALKABLE_CELL)
-					{
-						v = Map::Cell::COST_UNWALKABLE;
-					}
-					else
-					{
-						v = Simulator::COST_DIFFERENCE - v + 1.0;
-					}
+		for (unsigned int b = 0; b < beams; b++)
+		{
+			if ( ! active[b])
+				continue;
+
+			int k = cells[b];
+
+			if (_scan(k / cols, k % cols))
+			{
+				error = true;
 
-					_planner->update((*_map)(i, j), v);
+				if (_index != NULL)
+				{
+					_index->remove(k);
 				}
 			}
+
+			// Beam is blocked
+			if (real[k] == unwalkable)
+			{
+				active[b] = 0;
+				continue;
+			}
+
+			alive++;
 		}
 	}
 
 	return error;
-}
\ No newline at end of file
+}
+
+/**
+ * Replans and sets the planned path (without the current position).
+ *
+ * @return  bool   solution found
+ */
+bool Simulator::_replan()
+{
+	if (_lattice != NULL)
+	{
+		if ( ! _lattice->replan())
+			return false;
+
+		_lattice_path = _lattice->path();
+		_lattice_path.pop_front();
+
+		_robot_widget->path_planned.clear();
+
+		for (list<Lattice::State>::iterator it = _lattice_path.begin(); it != _lattice_path.end(); it++)
+		{
+			_robot_widget->path_planned.push_back((*_map)(it->y, it->x));
+		}
+
+		return true;
+	}
+
+	if ( ! _planner->replan())
+		return false;
+
+	// Copy into the nodes already there, without the current position
+	const list<Map::Cell*>& path = _planner->path();
+	_robot_widget->path_planned.assign(++path.begin(), path.end());
+
+	return true;
+}
+
+/**
+ * Checks a single cell against the real map and updates the sensor layer.
+ *
+ * @param   unsigned int   row
+ * @param   unsigned int   col
+ * @return  bool           update required
+ */
+bool Simulator::_scan(unsigned int row, unsigned int col)
+{
+	unsigned int k = (row * _map->cols()) + col;
+
+	// Check if an update is required
+	if (_robot_widget->data[k] == _real_widget->data[k])
+		return false;
+
+	_robot_widget->data[k] = _real_widget->data[k];
+	double v = _cost(row, col);
+
+	// The costmap passes the change to the planner once the whole scan is done
+	if (_decay != NULL && v == Map::Cell::COST_UNWALKABLE)
+	{
+		_decay->mark((*_map)(row, col), v, _tick + _config.decay);
+	}
+	else
+	{
+		if (_decay != NULL)
+		{
+			_decay->clear((*_map)(row, col));
+		}
+
+		_sensor->set((*_map)(row, col), v);
+	}
+
+	return true;
+}
+
+/**
+ * Moves the robot to the next cell (or lattice state) of the planned path.
+ *
+ * @return  void
+ */
+void Simulator::_step()
+{
+	Map::Cell* next = _robot_widget->path_planned.front();
+	_robot_widget->path_planned.pop_front();
+
+	if (_lattice != NULL)
+	{
+		_lattice->start(_lattice_path.front());
+		_lattice_path.pop_front();
+	}
+	else
+	{
+		_planner->start(next);
+	}
+
+	_real_widget->path_traversed.push_back(next);
+	_real_widget->current = _robot_widget->current = next;
+}
@@ -15,8 +15,17 @@
 #include <FL/Fl_Double_Window.H>
 #include <FL/fl_ask.H>
 
+#include "costmap.h"
+#include "discrepancy_index.h"
+#include "lattice_planner.h"
+#include "layers/layer_decay.h"
+#include "layers/layer_inflation.h"
+#include "layers/layer_keep_out.h"
+#include "layers/layer_sensor.h"
+#include "layers/layer_static.h"
 #include "planner.h"
 #include "map.h"
+#include "scanner.h"
 #include "widgets/widget_real.h"
 #include "widgets/widget_robot.h"
 
@@ -59,6 +68,41 @@ namespace DStarLite
 					 * @var  unsigned int  scanner radius
 					 */
 					unsigned int scan_radius;
+
+					/**
+					 * @var  bool  use the precomputed discrepancy index when scanning
+					 */
+					bool index;
+
+					/**
+					 * @var  unsigned int  number of scanner beams (0 for the see through circular scanner)
+					 */
+					unsigned int beams;
+
+					/**
+					 * @var  bool  skip ahead along the planned path until a discrepancy comes into range (implies index)
+					 */
+					bool fast_forward;
+
+					/**
+					 * @var  bool  inflate obstacles by the robot radius before planning
+					 */
+					bool inflate;
+
+					/**
+					 * @var  vector<unsigned int>  keep out zones, four values per zone (corner x, y, opposite corner x, y)
+					 */
+					vector<unsigned int> keep_out;
+
+					/**
+					 * @var  unsigned int  ticks an observed obstacle is kept without being observed again (0 to keep forever)
+					 */
+					unsigned int decay;
+
+					/**
+					 * @var  bool  plan over (x, y, heading) states with smooth motion primitives
+					 */
+					bool lattice;
 			};
 
 			/**
@@ -81,6 +125,11 @@ namespace DStarLite
 			 */
 			static const double COST_DIFFERENCE;
 
+			/**
+			 * @var  double  extra cost of a cell touching an obstacle (inflation)
+			 */
+			static const double INFLATION_COST;
+
 			/**
 			 * @var  double  unwalkable value of bitmap
 			 */
@@ -150,11 +199,51 @@ namespace DStarLite
 			 */
 			Config _config;
 
+			/**
+			 * @var  DecayLayer*  observed obstacles that expire (owned by the costmap, NULL if disabled)
+			 */
+			DecayLayer* _decay;
+
+			/**
+			 * @var  vector<Map::Cell*>  obstacles expired during the current tick
+			 */
+			vector<Map::Cell*> _expired;
+
+			/**
+			 * @var  DiscrepancyIndex*  cells where the robot map differs from the real map (NULL if disabled)
+			 */
+			DiscrepancyIndex* _index;
+
+			/**
+			 * @var  vector<Map::Cell*>  cells whose composite cost changed during the current scan
+			 */
+			vector<Map::Cell*> _changed;
+
+			/**
+			 * @var  vector<double>  new composite costs of the changed cells
+			 */
+			vector<double> _changed_costs;
+
+			/**
+			 * @var  Costmap*  prior map, sensor data and optional inflation and keep out layers
+			 */
+			Costmap* _costmap;
+
 			/**
 			 * @var  bool  simulator initialized
 			 */
 			bool _init;
 
+			/**
+			 * @var  LatticePlanner*  lattice planner (NULL unless in lattice mode)
+			 */
+			LatticePlanner* _lattice;
+
+			/**
+			 * @var  list<Lattice::State>  planned lattice states (without the current one)
+			 */
+			list<Lattice::State> _lattice_path;
+
 			/**
 			 * @var  Map*  real map, with all obstacles
 			 */
@@ -166,10 +255,30 @@ namespace DStarLite
 			char* _name;
 
 			/**
-			 * @var  Planner*  planner
+			 * @var  Planner*  planner (NULL in lattice mode)
 			 */
 			Planner* _planner;
 
+			/**
+			 * @var  vector<unsigned char>  robot map before any scan (only kept with decay)
+			 */
+			vector<unsigned char> _prior;
+
+			/**
+			 * @var  SensorLayer*  costs observed by the robot (owned by the costmap)
+			 */
+			SensorLayer* _sensor;
+
+			/**
+			 * @var  Scanner*  precomputed scan offsets
+			 */
+			Scanner* _scanner;
+
+			/**
+			 * @var  Map::Cell*  position of the last scan (NULL if never scanned)
+			 */
+			Map::Cell* _scanned;
+
 			/**
 			 * @var  RealWidget*  real widget
 			 */
@@ -185,10 +294,75 @@ namespace DStarLite
 			 */
 			Fl_Button* _start_button;
 
+			/**
+			 * @var  unsigned int  scans done (decay clock)
+			 */
+			unsigned int _tick;
+
 			/**
 			 * @var  Fl_Window*  window
 			 */
 			Fl_Window* _window;
+
+			/**
+			 * @var  vector<unsigned char>  beam still travelling (raycast scanner)
+			 */
+			vector<unsigned char> _active;
+
+			/**
+			 * @var  vector<int>  cell of each beam at the current step (raycast scanner)
+			 */
+			vector<int> _beam_cells;
+
+			/**
+			 * Gets the cost of a cell as known by the robot.
+			 *
+			 * @param   unsigned int   row
+			 * @param   unsigned int   col
+			 * @return  double
+			 */
+			double _cost(unsigned int row, unsigned int col);
+
+			/**
+			 * Forgets the expired obstacles, those still in view are observed again.
+			 *
+			 * @param   int    x-coordinate
+			 * @param   int    y-coordinate
+			 * @return  bool   updates found
+			 */
+			bool _expire(int x, int y);
+
+			/**
+			 * Casts all beams from a position, stopping each at the first unwalkable cell.
+			 *
+			 * @param   int    x-coordinate
+			 * @param   int    y-coordinate
+			 * @return  bool   updates found
+			 */
+			bool _raycast(int x, int y);
+
+			/**
+			 * Replans and sets the planned path (without the current position).
+			 *
+			 * @return  bool   solution found
+			 */
+			bool _replan();
+
+			/**
+			 * Checks a single cell against the real map and updates the sensor layer.
+			 *
+			 * @param   unsigned int   row
+			 * @param   unsigned int   col
+			 * @return  bool           update required
+			 */
+			bool _scan(unsigned int row, unsigned int col);
+
+			/**
+			 * Moves the robot to the next cell (or lattice state) of the planned path.
+			 *
+			 * @return  void
+			 */
+			void _step();
 	};
 };
 
@@ -0,0 +1,237 @@
+/**
+ * Space-Time Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "space_time_planner.h"
+
+/**
+ * @var  static const unsigned int  max states expanded by a plan
+ */
+const unsigned int SpaceTimePlanner::MAX_EXPANSIONS = 1000000;
+
+/**
+ * Constructor.
+ *
+ * @param  Map*                map
+ * @param  Planner*            planner (costs and goal)
+ * @param  ReservationTable*   reserved cells
+ */
+SpaceTimePlanner::SpaceTimePlanner(Map* map, Planner* planner, ReservationTable* table)
+{
+	_map = map;
+	_planner = planner;
+	_table = table;
+
+	_distance = new TrueDistance(map, planner);
+	_expanded = 0;
+}
+
+/**
+ * Deconstructor.
+ */
+SpaceTimePlanner::~SpaceTimePlanner()
+{
+	delete _distance;
+}
+
+/**
+ * Gets the true distance heuristic.
+ *
+ * @return  TrueDistance*
+ */
+TrueDistance* SpaceTimePlanner::distance()
+{
+	return _distance;
+}
+
+/**
+ * Gets the number of states expanded by the last plan.
+ *
+ * @return  unsigned int
+ */
+unsigned int SpaceTimePlanner::expanded()
+{
+	return _expanded;
+}
+
+/**
+ * Drops the heuristic, call after the planner's costs changed.
+ *
+ * @return  void
+ */
+void SpaceTimePlanner::invalidate()
+{
+	_distance->reset();
+}
+
+/**
+ * Gets the last path, one cell per time step (a wait repeats the cell).
+ *
+ * @return  list<Map::Cell*>&
+ */
+list<Map::Cell*>& SpaceTimePlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Plans from a cell at a time step to the planner's goal.
+ *
+ * With a window, reservations past it are ignored and the search stops there
+ * (windowed cooperative search), the caller replans before the window runs out.
+ *
+ * @param   Map::Cell*                start cell
+ * @param   unsigned int              start time step
+ * @param   unsigned int [optional]   time steps to respect reservations for (0 for all)
+ * @return  bool                      path found
+ */
+bool SpaceTimePlanner::plan(Map::Cell* start, unsigned int t, unsigned int window)
+{
+	_path.clear();
+	_expanded = 0;
+
+	double h = _distance->get(start);
+
+	if (h == Math::INF)
+		return false;
+
+	unsigned int cols = _map->cols();
+	unsigned int horizon = _table->horizon();
+
+	if (window > 0 && t + window < horizon)
+	{
+		horizon = t + window;
+	}
+
+	Map::Cell* goal = _planner->goal();
+
+	Key first(start->y() * cols + start->x(), t);
+
+	NH nodes;
+	Q open;
+
+	Node node;
+	node.g = 0.0;
+	node.parent = first;
+	node.closed = false;
+
+	nodes[first] = node;
+	open.push(Q_PAIR(h, first));
+
+	bool found = false;
+	Key last = first;
+
+	while ( ! open.empty())
+	{
+		Key k = open.top().second;
+		open.pop();
+
+		Node& n = nodes[k];
+
+		if (n.closed)
+			continue;
+
+		n.closed = true;
+
+		Map::Cell* u = (*_map)(k.first / cols, k.first % cols);
+
+		// Nothing is reserved past the horizon, or the goal is reached for good
+		if (k.second >= horizon || (u == goal && _free(u, k.second, horizon)))
+		{
+			found = true;
+			last = k;
+			break;
+		}
+
+		if (++_expanded > MAX_EXPANSIONS)
+			break;
+
+		double g = n.g;
+
+		// Neighbors, and the cell itself (wait)
+		Map::Cell** nbrs = u->nbrs();
+
+		for (unsigned int i = 0; i <= Map::Cell::NUM_NBRS; i++)
+		{
+			Map::Cell* v = (i < Map::Cell::NUM_NBRS) ? nbrs[i] : u;
+
+			if (v == NULL || _table->blocked(u, v, k.second))
+				continue;
+
+			double cost = (v == u) ? _planner->cost(u) : _distance->cost(u, i);
+			double dist = _distance->get(v);
+
+			if (cost == Math::INF || cost == Map::Cell::COST_UNWALKABLE || dist == Math::INF)
+				continue;
+
+			Key next(v->y() * cols + v->x(), k.second + 1);
+
+			NH::iterator it = nodes.find(next);
+
+			if (it != nodes.end() && (it->second.closed || it->second.g <= g + cost))
+				continue;
+
+			Node m;
+			m.g = g + cost;
+			m.parent = k;
+			m.closed = false;
+
+			nodes[next] = m;
+			open.push(Q_PAIR(m.g + dist, next));
+		}
+	}
+
+	if ( ! found)
+		return false;
+
+	// Walk back to the start
+	for (Key k = last; ; k = nodes[k].parent)
+	{
+		_path.push_front((*_map)(k.first / cols, k.first % cols));
+
+		if (k == first)
+			break;
+	}
+
+	// Follow the static shortest path past the horizon
+	for (Map::Cell* u = _distance->next(_path.back()); u != NULL; u = _distance->next(u))
+	{
+		_path.push_back(u);
+	}
+
+	return true;
+}
+
+/**
+ * Checks if a cell stays free from a time step on.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   time step
+ * @param   unsigned int   horizon
+ * @return  bool
+ */
+bool SpaceTimePlanner::_free(Map::Cell* u, unsigned int t, unsigned int horizon)
+{
+	for ( ; t < horizon; t++)
+	{
+		if (_table->reserved(u, t))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Hashes a (cell index, time) key.
+ *
+ * @param   Key      key
+ * @return  size_t
+ */
+size_t SpaceTimePlanner::Hash::operator()(const Key& k) const
+{
+	return ((size_t) k.first * 73856093) ^ ((size_t) k.second * 19349663);
+}
@@ -0,0 +1,179 @@
+/**
+ * Space-Time Planner.
+ *
+ * Plans around moving obstacles whose trajectories are known in advance
+ * (predicted, or the plans of other robots) instead of writing them into
+ * the map as cost changes each tick.  Searches (cell, time) states with A*,
+ * a state moves to a free neighbor or waits in place for one time step,
+ * and the reservation table tells which (cell, time) states are taken.
+ *
+ * The heuristic is the exact static cost to the goal (TrueDistance).  Past
+ * the horizon of the reservation table nothing is taken anymore, the search
+ * stops there and the rest of the path follows the static shortest path.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_SPACE_TIME_PLANNER_H
+#define DSTARLITE_SPACE_TIME_PLANNER_H
+
+#include <functional>
+#include <list>
+#include <queue>
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "map.h"
+#include "planner.h"
+#include "reservation_table.h"
+#include "true_distance.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class SpaceTimePlanner
+	{
+		public:
+
+			/**
+			 * @var  static const unsigned int  max states expanded by a plan
+			 */
+			static const unsigned int MAX_EXPANSIONS;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*                map
+			 * @param  Planner*            planner (costs and goal)
+			 * @param  ReservationTable*   reserved cells
+			 */
+			SpaceTimePlanner(Map* map, Planner* planner, ReservationTable* table);
+
+			/**
+			 * Deconstructor.
+			 */
+			~SpaceTimePlanner();
+
+			/**
+			 * Gets the true distance heuristic.
+			 *
+			 * @return  TrueDistance*
+			 */
+			TrueDistance* distance();
+
+			/**
+			 * Gets the number of states expanded by the last plan.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Drops the heuristic, call after the planner's costs changed.
+			 *
+			 * @return  void
+			 */
+			void invalidate();
+
+			/**
+			 * Gets the last path, one cell per time step (a wait repeats the cell).
+			 *
+			 * @return  list<Map::Cell*>&
+			 */
+			list<Map::Cell*>& path();
+
+			/**
+			 * Plans from a cell at a time step to the planner's goal.
+			 *
+			 * @param   Map::Cell*                start cell
+			 * @param   unsigned int              start time step
+			 * @param   unsigned int [optional]   time steps to respect reservations for (0 for all)
+			 * @return  bool                      path found
+			 */
+			bool plan(Map::Cell* start, unsigned int t, unsigned int window = 0);
+
+		protected:
+
+			/**
+			 * (cell index, time) key and hash.
+			 */
+			typedef pair<unsigned int, unsigned int> Key;
+
+			struct Hash
+			{
+				size_t operator()(const Key& k) const;
+			};
+
+			/**
+			 * Search node.
+			 */
+			struct Node
+			{
+				double g;
+				Key parent;
+				bool closed;
+			};
+
+			/**
+			 * @var  min-heap of (f, (cell index, time))
+			 */
+			typedef pair<double, Key> Q_PAIR;
+			typedef priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > Q;
+
+#ifdef WIN32
+			typedef unordered_map<Key, Node, Hash> NH;
+#else
+			typedef tr1::unordered_map<Key, Node, Hash> NH;
+#endif
+
+			/**
+			 * @var  TrueDistance*  static cost to the goal
+			 */
+			TrueDistance* _distance;
+
+			/**
+			 * @var  unsigned int  states expanded by the last plan
+			 */
+			unsigned int _expanded;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  list<Map::Cell*>  last path
+			 */
+			list<Map::Cell*> _path;
+
+			/**
+			 * @var  Planner*  planner
+			 */
+			Planner* _planner;
+
+			/**
+			 * @var  ReservationTable*  reserved cells
+			 */
+			ReservationTable* _table;
+
+			/**
+			 * Checks if a cell stays free from a time step on.
+			 *
+			 * @param   Map::Cell*     cell
+			 * @param   unsigned int   time step
+			 * @param   unsigned int   horizon
+			 * @return  bool
+			 */
+			bool _free(Map::Cell* u, unsigned int t, unsigned int horizon);
+	};
+};
+
+#endif // DSTARLITE_SPACE_TIME_PLANNER_H
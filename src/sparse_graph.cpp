@@ -0,0 +1,92 @@
+/**
+ * Sparse Graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "sparse_graph.h"
+
+/**
+ * Constructor.
+ *
+ * @param  SparseMap*   map
+ */
+SparseGraph::SparseGraph(SparseMap* map)
+{
+	_map = map;
+}
+
+/**
+ * Gets the cost of moving from a cell to one of its neighbors.
+ *
+ * @param   Vertex         cell
+ * @param   unsigned int   neighbor index
+ * @return  double         cost (Math::INF if the move is blocked)
+ */
+double SparseGraph::cost(const Vertex& u, unsigned int k)
+{
+	double u_cost = _map->cost(u);
+	double v_cost = _map->cost(SparseMap::coord(u.x + Neighborhood::DX[k], u.y + Neighborhood::DY[k]));
+
+	if (u_cost == Map::Cell::COST_UNWALKABLE || v_cost == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	// Moves that skip a cell may not cut through walls
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			int via = Neighborhood::VIA[k][s];
+
+			if (_map->cost(SparseMap::coord(u.x + Connectivity<8>::DX[via], u.y + Connectivity<8>::DY[via])) == Map::Cell::COST_UNWALKABLE)
+				return Math::INF;
+		}
+	}
+
+	return Neighborhood::COST[k] * ((u_cost + v_cost) / 2);
+}
+
+/**
+ * Estimates the cost between two cells.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double SparseGraph::h(const Vertex& a, const Vertex& b)
+{
+	return Neighborhood::h(abs(a.x - b.x), abs(a.y - b.y));
+}
+
+/**
+ * Gets the predecessors of a cell.
+ *
+ * Moves are symmetric, same as the successors.
+ *
+ * @param   Vertex   cell
+ * @param   Edges&   predecessors and move costs (appended)
+ * @return  void
+ */
+void SparseGraph::pred(const Vertex& u, Edges& edges)
+{
+	succ(u, edges);
+}
+
+/**
+ * Gets the successors of a cell.
+ *
+ * @param   Vertex   cell
+ * @param   Edges&   successors and move costs (appended)
+ * @return  void
+ */
+void SparseGraph::succ(const Vertex& u, Edges& edges)
+{
+	for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+	{
+		Vertex v = SparseMap::coord(u.x + Neighborhood::DX[k], u.y + Neighborhood::DY[k]);
+
+		edges.push_back(pair<Vertex, double>(v, cost(u, k)));
+	}
+}
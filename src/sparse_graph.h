@@ -0,0 +1,86 @@
+/**
+ * Sparse Graph.
+ *
+ * Sparse map as a graph for the D* Lite engine, connected like the grid
+ * maps (see Neighborhood).  There are no bounds, every cell has all of its
+ * neighbors.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_SPARSE_GRAPH_H
+#define DSTARLITE_SPARSE_GRAPH_H
+
+#include <vector>
+
+#include "connectivity.h"
+#include "sparse_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class SparseGraph
+	{
+		public:
+
+			typedef SparseMap::Coord Vertex;
+			typedef SparseMap::Hash Hash;
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  SparseMap*   map
+			 */
+			SparseGraph(SparseMap* map);
+
+			/**
+			 * Gets the cost of moving from a cell to one of its neighbors.
+			 *
+			 * @param   Vertex         cell
+			 * @param   unsigned int   neighbor index
+			 * @return  double         cost (Math::INF if the move is blocked)
+			 */
+			double cost(const Vertex& u, unsigned int k);
+
+			/**
+			 * Estimates the cost between two cells.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Gets the predecessors of a cell.
+			 *
+			 * @param   Vertex   cell
+			 * @param   Edges&   predecessors and move costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Gets the successors of a cell.
+			 *
+			 * @param   Vertex   cell
+			 * @param   Edges&   successors and move costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+		protected:
+
+			/**
+			 * @var  SparseMap*  map
+			 */
+			SparseMap* _map;
+	};
+};
+
+#endif // DSTARLITE_SPARSE_GRAPH_H
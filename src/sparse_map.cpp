@@ -0,0 +1,155 @@
+/**
+ * Sparse Map.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "sparse_map.h"
+
+/**
+ * @var  static const unsigned int  chunk edge length is 2^CHUNK_BITS cells
+ */
+const unsigned int SparseMap::CHUNK_BITS = 5;
+
+/**
+ * Constructor, everything unknown.
+ *
+ * @param  double [optional]   cost of unknown cells
+ */
+SparseMap::SparseMap(double cost)
+{
+	_default = cost;
+	_last = NULL;
+}
+
+/**
+ * Deconstructor.
+ */
+SparseMap::~SparseMap()
+{
+	for (CH::iterator it = _chunks.begin(); it != _chunks.end(); it++)
+	{
+		delete it->second;
+	}
+}
+
+/**
+ * Gets the number of chunks created.
+ *
+ * @return  unsigned int
+ */
+unsigned int SparseMap::chunks()
+{
+	return _chunks.size();
+}
+
+/**
+ * Makes coordinates.
+ *
+ * @param   int     x-coordinate
+ * @param   int     y-coordinate
+ * @return  Coord
+ */
+SparseMap::Coord SparseMap::coord(int x, int y)
+{
+	Coord c;
+	c.x = x;
+	c.y = y;
+
+	return c;
+}
+
+/**
+ * Gets the cost of a cell.
+ *
+ * @param   Coord    cell
+ * @return  double
+ */
+double SparseMap::cost(const Coord& c)
+{
+	unsigned int offset;
+	vector<double>* chunk = _chunk(c, offset, false);
+
+	return (chunk == NULL) ? _default : (*chunk)[offset];
+}
+
+/**
+ * Sets the cost of a cell.
+ *
+ * @param   Coord    cell
+ * @param   double   cost
+ * @return  void
+ */
+void SparseMap::set(const Coord& c, double cost)
+{
+	unsigned int offset;
+	vector<double>* chunk = _chunk(c, offset, cost != _default);
+
+	if (chunk != NULL)
+	{
+		(*chunk)[offset] = cost;
+	}
+}
+
+/**
+ * Finds the chunk of a cell.
+ *
+ * @param   Coord             cell
+ * @param   unsigned int&     offset within the chunk
+ * @param   bool              create the chunk if missing
+ * @return  vector<double>*   chunk (NULL if missing)
+ */
+vector<double>* SparseMap::_chunk(const Coord& c, unsigned int& offset, bool create)
+{
+	int size = 1 << CHUNK_BITS;
+
+	// Floor division, also for negative coordinates
+	Coord key;
+	key.x = (c.x >= 0) ? c.x / size : -((-c.x - 1) / size) - 1;
+	key.y = (c.y >= 0) ? c.y / size : -((-c.y - 1) / size) - 1;
+
+	offset = (c.y - key.y * size) * size + (c.x - key.x * size);
+
+	// Neighbor lookups mostly stay in the same chunk
+	if (_last != NULL && _last_key == key)
+		return _last;
+
+	CH::iterator it = _chunks.find(key);
+
+	if (it == _chunks.end())
+	{
+		if ( ! create)
+			return NULL;
+
+		it = _chunks.insert(CH::value_type(key, new vector<double>(size * size, _default))).first;
+	}
+
+	_last = it->second;
+	_last_key = key;
+
+	return _last;
+}
+
+/**
+ * Compares two coordinates.
+ *
+ * @param   Coord   coordinates
+ * @return  bool
+ */
+bool SparseMap::Coord::operator==(const Coord& c) const
+{
+	return x == c.x && y == c.y;
+}
+
+/**
+ * Hashes coordinates.
+ *
+ * @param   Coord    coordinates
+ * @return  size_t
+ */
+size_t SparseMap::Hash::operator()(const Coord& c) const
+{
+	return ((size_t) c.y * 73856093) ^ ((size_t) c.x * 19349663);
+}
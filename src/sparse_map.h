@@ -0,0 +1,144 @@
+/**
+ * Sparse Map.
+ *
+ * Unbounded 2D cost map for exploration, keyed by signed coordinates.  Cells
+ * live in square chunks that are created the first time one of their cells
+ * is written; reads of untouched space return the default cost.  Memory
+ * grows with the explored area only and nothing is ever reallocated.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_SPARSE_MAP_H
+#define DSTARLITE_SPARSE_MAP_H
+
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class SparseMap
+	{
+		public:
+
+			/**
+			 * Cell coordinates.
+			 */
+			struct Coord
+			{
+				int x;
+				int y;
+
+				bool operator==(const Coord& c) const;
+			};
+
+			/**
+			 * Coordinates hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const Coord& c) const;
+			};
+
+			/**
+			 * @var  static const unsigned int  chunk edge length is 2^CHUNK_BITS cells
+			 */
+			static const unsigned int CHUNK_BITS;
+
+			/**
+			 * Constructor, everything unknown.
+			 *
+			 * @param  double [optional]   cost of unknown cells
+			 */
+			SparseMap(double cost = 1.0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~SparseMap();
+
+			/**
+			 * Gets the number of chunks created.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int chunks();
+
+			/**
+			 * Makes coordinates.
+			 *
+			 * @param   int     x-coordinate
+			 * @param   int     y-coordinate
+			 * @return  Coord
+			 */
+			static Coord coord(int x, int y);
+
+			/**
+			 * Gets the cost of a cell.
+			 *
+			 * @param   Coord    cell
+			 * @return  double
+			 */
+			double cost(const Coord& c);
+
+			/**
+			 * Sets the cost of a cell.
+			 *
+			 * @param   Coord    cell
+			 * @param   double   cost
+			 * @return  void
+			 */
+			void set(const Coord& c, double cost);
+
+		protected:
+
+#ifdef WIN32
+			typedef unordered_map<Coord, vector<double>*, Hash> CH;
+#else
+			typedef tr1::unordered_map<Coord, vector<double>*, Hash> CH;
+#endif
+
+			/**
+			 * @var  CH  chunks by chunk coordinates
+			 */
+			CH _chunks;
+
+			/**
+			 * @var  double  cost of unknown cells
+			 */
+			double _default;
+
+			/**
+			 * @var  vector<double>*  last chunk looked up (NULL if none)
+			 */
+			vector<double>* _last;
+
+			/**
+			 * @var  Coord  coordinates of the last chunk looked up
+			 */
+			Coord _last_key;
+
+			/**
+			 * Finds the chunk of a cell.
+			 *
+			 * @param   Coord             cell
+			 * @param   unsigned int&     offset within the chunk
+			 * @param   bool              create the chunk if missing
+			 * @return  vector<double>*   chunk (NULL if missing)
+			 */
+			vector<double>* _chunk(const Coord& c, unsigned int& offset, bool create);
+	};
+};
+
+#endif // DSTARLITE_SPARSE_MAP_H
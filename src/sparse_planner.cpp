@@ -0,0 +1,173 @@
+/**
+ * Sparse Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "sparse_planner.h"
+
+/**
+ * Constructor.
+ *
+ * @param  SparseMap::Coord    start cell
+ * @param  SparseMap::Coord    goal cell
+ * @param  double [optional]   cost of unknown cells
+ */
+SparsePlanner::SparsePlanner(const SparseMap::Coord& start, const SparseMap::Coord& goal, double cost)
+{
+	_map = new SparseMap(cost);
+	_graph = new SparseGraph(_map);
+	_engine = new Engine<SparseGraph>(_graph, start, goal);
+}
+
+/**
+ * Deconstructor.
+ */
+SparsePlanner::~SparsePlanner()
+{
+	delete _engine;
+	delete _graph;
+	delete _map;
+}
+
+/**
+ * Gets the cost of a cell as known by the planner.
+ *
+ * @param   SparseMap::Coord   cell
+ * @return  double
+ */
+double SparsePlanner::cost(const SparseMap::Coord& c)
+{
+	return _map->cost(c);
+}
+
+/**
+ * Gets the number of cells expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int SparsePlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the map.
+ *
+ * @return  SparseMap*
+ */
+SparseMap* SparsePlanner::map()
+{
+	return _map;
+}
+
+/**
+ * Gets the path from the last replan.
+ *
+ * @return  list<SparseMap::Coord>
+ */
+list<SparseMap::Coord> SparsePlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool SparsePlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  SparseMap::Coord
+ */
+SparseMap::Coord SparsePlanner::start()
+{
+	return _engine->start();
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   SparseMap::Coord   new start
+ * @return  void
+ */
+void SparsePlanner::start(const SparseMap::Coord& c)
+{
+	_engine->start(c);
+}
+
+/**
+ * Update map.
+ *
+ * @param   SparseMap::Coord   cell to update
+ * @param   double             new cost of the cell
+ * @return  void
+ */
+void SparsePlanner::update(const SparseMap::Coord& c, double cost)
+{
+	double old = _map->cost(c);
+
+	if (old == cost)
+		return;
+
+	_map->set(c, cost);
+
+	// The cell's moves and its neighbors' moves into it changed
+	_engine->update(c);
+
+	for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+	{
+		_engine->update(SparseMap::coord(c.x + Neighborhood::DX[k], c.y + Neighborhood::DY[k]));
+	}
+
+	// So did the moves passing over it, when it became or stopped being a wall
+	if (Neighborhood::VIAS && (old == Map::Cell::COST_UNWALKABLE) != (cost == Map::Cell::COST_UNWALKABLE))
+	{
+		for (unsigned int k = 0; k < Neighborhood::SIZE; k++)
+		{
+			if (Neighborhood::VIA[k][0] < 0)
+				continue;
+
+			for (unsigned int s = 0; s < 2; s++)
+			{
+				int via = Neighborhood::VIA[k][s];
+
+				SparseMap::Coord a = SparseMap::coord(c.x - Connectivity<8>::DX[via], c.y - Connectivity<8>::DY[via]);
+
+				_engine->update(a);
+				_engine->update(SparseMap::coord(a.x + Neighborhood::DX[k], a.y + Neighborhood::DY[k]));
+			}
+		}
+	}
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * @param   vector<SparseMap::Coord>&   cells to update
+ * @param   vector<double>&             new costs of the cells
+ * @return  void
+ */
+void SparsePlanner::update(vector<SparseMap::Coord>& cells, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < cells.size(); i++)
+	{
+		update(cells[i], costs[i]);
+	}
+}
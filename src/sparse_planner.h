@@ -0,0 +1,139 @@
+/**
+ * Sparse Planner.
+ *
+ * D* Lite over an unbounded sparse map, for exploration.  The planner owns
+ * its map, unknown space costs the default and the search extends into it
+ * as needed; observed costs are written into the map as they come in.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_SPARSE_PLANNER_H
+#define DSTARLITE_SPARSE_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "engine.h"
+#include "sparse_graph.h"
+#include "sparse_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class SparsePlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  SparseMap::Coord    start cell
+			 * @param  SparseMap::Coord    goal cell
+			 * @param  double [optional]   cost of unknown cells
+			 */
+			SparsePlanner(const SparseMap::Coord& start, const SparseMap::Coord& goal, double cost = 1.0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~SparsePlanner();
+
+			/**
+			 * Gets the cost of a cell as known by the planner.
+			 *
+			 * @param   SparseMap::Coord   cell
+			 * @return  double
+			 */
+			double cost(const SparseMap::Coord& c);
+
+			/**
+			 * Gets the number of cells expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the map.
+			 *
+			 * @return  SparseMap*
+			 */
+			SparseMap* map();
+
+			/**
+			 * Gets the path from the last replan.
+			 *
+			 * @return  list<SparseMap::Coord>
+			 */
+			list<SparseMap::Coord> path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  SparseMap::Coord
+			 */
+			SparseMap::Coord start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   SparseMap::Coord   new start
+			 * @return  void
+			 */
+			void start(const SparseMap::Coord& c);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   SparseMap::Coord   cell to update
+			 * @param   double             new cost of the cell
+			 * @return  void
+			 */
+			void update(const SparseMap::Coord& c, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<SparseMap::Coord>&   cells to update
+			 * @param   vector<double>&             new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<SparseMap::Coord>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  Engine<SparseGraph>*  D* Lite engine
+			 */
+			Engine<SparseGraph>* _engine;
+
+			/**
+			 * @var  SparseGraph*  graph
+			 */
+			SparseGraph* _graph;
+
+			/**
+			 * @var  SparseMap*  map
+			 */
+			SparseMap* _map;
+
+			/**
+			 * @var  list<SparseMap::Coord>  path
+			 */
+			list<SparseMap::Coord> _path;
+	};
+};
+
+#endif // DSTARLITE_SPARSE_PLANNER_H
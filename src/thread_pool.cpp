@@ -0,0 +1,244 @@
+/**
+ * Thread Pool.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifdef WIN32
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+#include "thread_pool.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * Platform specific state.
+ */
+struct ThreadPool::State
+{
+#ifdef WIN32
+	vector<HANDLE> threads;
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE work;
+	CONDITION_VARIABLE done;
+#else
+	vector<pthread_t> threads;
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t done;
+#endif
+
+	/**
+	 * @var  vector<Job*>*  current batch (NULL if idle)
+	 */
+	vector<Job*>* jobs;
+
+	/**
+	 * @var  unsigned int  next job to hand out, jobs finished
+	 */
+	unsigned int next;
+	unsigned int finished;
+
+	/**
+	 * @var  bool  workers should exit
+	 */
+	bool stop;
+};
+
+#ifdef WIN32
+	#define DSTARLITE_LOCK(s)		EnterCriticalSection(&(s)->lock)
+	#define DSTARLITE_UNLOCK(s)		LeaveCriticalSection(&(s)->lock)
+	#define DSTARLITE_WAIT(s, c)	SleepConditionVariableCS(&(s)->c, &(s)->lock, INFINITE)
+	#define DSTARLITE_SIGNAL(s, c)	WakeAllConditionVariable(&(s)->c)
+#else
+	#define DSTARLITE_LOCK(s)		pthread_mutex_lock(&(s)->lock)
+	#define DSTARLITE_UNLOCK(s)		pthread_mutex_unlock(&(s)->lock)
+	#define DSTARLITE_WAIT(s, c)	pthread_cond_wait(&(s)->c, &(s)->lock)
+	#define DSTARLITE_SIGNAL(s, c)	pthread_cond_broadcast(&(s)->c)
+#endif
+
+/**
+ * Deconstructor.
+ */
+ThreadPool::Job::~Job()
+{
+}
+
+/**
+ * Constructor.
+ *
+ * @param  unsigned int   number of worker threads (0 runs jobs on the calling thread)
+ */
+ThreadPool::ThreadPool(unsigned int threads)
+{
+	_size = threads;
+
+	_state = new State();
+	_state->jobs = NULL;
+	_state->next = 0;
+	_state->finished = 0;
+	_state->stop = false;
+
+#ifdef WIN32
+	InitializeCriticalSection(&_state->lock);
+	InitializeConditionVariable(&_state->work);
+	InitializeConditionVariable(&_state->done);
+
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		_state->threads.push_back(CreateThread(NULL, 0, ThreadPool::_worker, (void*) this, 0, NULL));
+	}
+#else
+	pthread_mutex_init(&_state->lock, NULL);
+	pthread_cond_init(&_state->work, NULL);
+	pthread_cond_init(&_state->done, NULL);
+
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		pthread_t thread;
+		pthread_create(&thread, NULL, ThreadPool::_worker, (void*) this);
+		_state->threads.push_back(thread);
+	}
+#endif
+}
+
+/**
+ * Deconstructor, joins all workers.
+ */
+ThreadPool::~ThreadPool()
+{
+	DSTARLITE_LOCK(_state);
+	_state->stop = true;
+	DSTARLITE_SIGNAL(_state, work);
+	DSTARLITE_UNLOCK(_state);
+
+#ifdef WIN32
+	for (unsigned int i = 0; i < _state->threads.size(); i++)
+	{
+		WaitForSingleObject(_state->threads[i], INFINITE);
+		CloseHandle(_state->threads[i]);
+	}
+
+	DeleteCriticalSection(&_state->lock);
+#else
+	for (unsigned int i = 0; i < _state->threads.size(); i++)
+	{
+		pthread_join(_state->threads[i], NULL);
+	}
+
+	pthread_cond_destroy(&_state->done);
+	pthread_cond_destroy(&_state->work);
+	pthread_mutex_destroy(&_state->lock);
+#endif
+
+	delete _state;
+}
+
+/**
+ * Runs a batch of jobs and waits for all of them to finish.
+ *
+ * @param   vector<Job*>&   jobs
+ * @return  void
+ */
+void ThreadPool::run(vector<Job*>& jobs)
+{
+	if (jobs.empty())
+		return;
+
+	// No workers, run in place
+	if (_size == 0)
+	{
+		for (unsigned int i = 0; i < jobs.size(); i++)
+		{
+			jobs[i]->run();
+		}
+
+		return;
+	}
+
+	DSTARLITE_LOCK(_state);
+
+	_state->jobs = &jobs;
+	_state->next = 0;
+	_state->finished = 0;
+	DSTARLITE_SIGNAL(_state, work);
+
+	while (_state->finished < jobs.size())
+	{
+		DSTARLITE_WAIT(_state, done);
+	}
+
+	_state->jobs = NULL;
+
+	DSTARLITE_UNLOCK(_state);
+}
+
+/**
+ * Gets the number of worker threads.
+ *
+ * @return  unsigned int
+ */
+unsigned int ThreadPool::size()
+{
+	return _size;
+}
+
+/**
+ * Worker loop.
+ *
+ * @return  void
+ */
+void ThreadPool::_work()
+{
+	DSTARLITE_LOCK(_state);
+
+	while (true)
+	{
+		while ( ! _state->stop && (_state->jobs == NULL || _state->next >= _state->jobs->size()))
+		{
+			DSTARLITE_WAIT(_state, work);
+		}
+
+		if (_state->stop)
+			break;
+
+		Job* job = (*_state->jobs)[_state->next++];
+
+		DSTARLITE_UNLOCK(_state);
+		job->run();
+		DSTARLITE_LOCK(_state);
+
+		if (++_state->finished == _state->jobs->size())
+		{
+			DSTARLITE_SIGNAL(_state, done);
+		}
+	}
+
+	DSTARLITE_UNLOCK(_state);
+}
+
+/**
+ * Thread entry point.
+ *
+ * @param   void*   thread pool
+ */
+#ifdef WIN32
+unsigned long __stdcall ThreadPool::_worker(void* p)
+{
+	((ThreadPool*) p)->_work();
+	return 0;
+}
+#else
+void* ThreadPool::_worker(void* p)
+{
+	((ThreadPool*) p)->_work();
+	return NULL;
+}
+#endif
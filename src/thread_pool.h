@@ -0,0 +1,109 @@
+/**
+ * Thread Pool.
+ *
+ * Fixed set of worker threads that run a batch of jobs and return once every
+ * job of the batch is done.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_THREAD_POOL_H
+#define DSTARLITE_THREAD_POOL_H
+
+#include <vector>
+
+using namespace std;
+
+namespace DStarLite
+{
+	class ThreadPool
+	{
+		public:
+
+			/**
+			 * Job.
+			 */
+			class Job
+			{
+				public:
+
+					/**
+					 * Deconstructor.
+					 */
+					virtual ~Job();
+
+					/**
+					 * Runs the job (on a worker thread).
+					 *
+					 * @return  void
+					 */
+					virtual void run() = 0;
+			};
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  unsigned int   number of worker threads (0 runs jobs on the calling thread)
+			 */
+			ThreadPool(unsigned int threads);
+
+			/**
+			 * Deconstructor, joins all workers.
+			 */
+			~ThreadPool();
+
+			/**
+			 * Runs a batch of jobs and waits for all of them to finish.
+			 *
+			 * @param   vector<Job*>&   jobs
+			 * @return  void
+			 */
+			void run(vector<Job*>& jobs);
+
+			/**
+			 * Gets the number of worker threads.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+		protected:
+
+			/**
+			 * Platform specific state.
+			 */
+			struct State;
+
+			/**
+			 * @var  State*  platform specific state (threads, lock, conditions)
+			 */
+			State* _state;
+
+			/**
+			 * @var  unsigned int  number of worker threads
+			 */
+			unsigned int _size;
+
+			/**
+			 * Worker loop.
+			 *
+			 * @return  void
+			 */
+			void _work();
+
+			/**
+			 * Thread entry point.
+			 *
+			 * @param   void*   thread pool
+			 */
+#ifdef WIN32
+			static unsigned long __stdcall _worker(void* p);
+#else
+			static void* _worker(void* p);
+#endif
+	};
+};
+
+#endif // DSTARLITE_THREAD_POOL_H
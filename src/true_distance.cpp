@@ -0,0 +1,162 @@
+/**
+ * True Distance.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "true_distance.h"
+
+/**
+ * Constructor.
+ *
+ * @param  Map*       map
+ * @param  Planner*   planner (costs and goal)
+ */
+TrueDistance::TrueDistance(Map* map, Planner* planner)
+{
+	_map = map;
+	_planner = planner;
+
+	reset();
+}
+
+/**
+ * Gets the cost of moving from a cell to one of its neighbors.
+ *
+ * Same as the planner's edge cost, it is symmetric so the backward search
+ * can use it as is.
+ *
+ * @param   Map::Cell*     from
+ * @param   unsigned int   neighbor index
+ * @return  double         cost (Math::INF if the move is blocked)
+ */
+double TrueDistance::cost(Map::Cell* a, unsigned int k)
+{
+	Map::Cell** nbrs = a->nbrs();
+
+	double a_cost = _planner->cost(a);
+	double b_cost = _planner->cost(nbrs[k]);
+
+	if (a_cost == Map::Cell::COST_UNWALKABLE || b_cost == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		if (_planner->cost(nbrs[Neighborhood::VIA[k][0]]) == Map::Cell::COST_UNWALKABLE || _planner->cost(nbrs[Neighborhood::VIA[k][1]]) == Map::Cell::COST_UNWALKABLE)
+			return Math::INF;
+	}
+
+	return Neighborhood::COST[k] * ((a_cost + b_cost) / 2);
+}
+
+/**
+ * Gets the exact cost from a cell to the goal.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double       cost (Math::INF if the goal is unreachable)
+ */
+double TrueDistance::get(Map::Cell* u)
+{
+	unsigned int cols = _map->cols();
+	unsigned int k = u->y() * cols + u->x();
+
+	// Resume the search until the cell is closed
+	while ( ! _closed[k] && ! _open.empty())
+	{
+		Q_PAIR top = _open.top();
+		_open.pop();
+
+		unsigned int c = top.second;
+
+		if (_closed[c])
+			continue;
+
+		_closed[c] = 1;
+
+		Map::Cell* v = (*_map)(c / cols, c % cols);
+		Map::Cell** nbrs = v->nbrs();
+
+		for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+		{
+			if (nbrs[i] == NULL)
+				continue;
+
+			unsigned int n = nbrs[i]->y() * cols + nbrs[i]->x();
+
+			if (_closed[n])
+				continue;
+
+			double step = cost(v, i);
+
+			if (step == Math::INF)
+				continue;
+
+			if (top.first + step < _dist[n])
+			{
+				_dist[n] = top.first + step;
+				_open.push(Q_PAIR(_dist[n], n));
+			}
+		}
+	}
+
+	return _closed[k] ? _dist[k] : Math::INF;
+}
+
+/**
+ * Gets the neighbor on a shortest path to the goal.
+ *
+ * @param   Map::Cell*   cell
+ * @return  Map::Cell*   next cell (NULL if at the goal or unreachable)
+ */
+Map::Cell* TrueDistance::next(Map::Cell* u)
+{
+	if (u == _planner->goal())
+		return NULL;
+
+	Map::Cell** nbrs = u->nbrs();
+
+	Map::Cell* best = NULL;
+	double best_cost = Math::INF;
+
+	for (unsigned int i = 0; i < Map::Cell::NUM_NBRS; i++)
+	{
+		if (nbrs[i] == NULL)
+			continue;
+
+		double step = cost(u, i);
+		double dist = get(nbrs[i]);
+
+		if (step == Math::INF || dist == Math::INF)
+			continue;
+
+		if (step + dist < best_cost)
+		{
+			best = nbrs[i];
+			best_cost = step + dist;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Drops all distances, call after costs changed.
+ *
+ * @return  void
+ */
+void TrueDistance::reset()
+{
+	unsigned int size = _map->rows() * _map->cols();
+
+	_dist.assign(size, Math::INF);
+	_closed.assign(size, 0);
+	_open = Q();
+
+	Map::Cell* goal = _planner->goal();
+	unsigned int k = goal->y() * _map->cols() + goal->x();
+
+	_dist[k] = 0.0;
+	_open.push(Q_PAIR(0.0, k));
+}
@@ -0,0 +1,104 @@
+/**
+ * True Distance.
+ *
+ * Exact cost to the goal of any cell, from a backward Dijkstra search over
+ * the planner's costs that is resumed only as far as needed (reverse
+ * resumable search).  Used as the heuristic of the space-time searches,
+ * where the octile distance ignores walls and badly underestimates.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_TRUE_DISTANCE_H
+#define DSTARLITE_TRUE_DISTANCE_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "map.h"
+#include "planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class TrueDistance
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  Map*       map
+			 * @param  Planner*   planner (costs and goal)
+			 */
+			TrueDistance(Map* map, Planner* planner);
+
+			/**
+			 * Gets the cost of moving from a cell to one of its neighbors.
+			 *
+			 * @param   Map::Cell*     from
+			 * @param   unsigned int   neighbor index
+			 * @return  double         cost (Math::INF if the move is blocked)
+			 */
+			double cost(Map::Cell* a, unsigned int k);
+
+			/**
+			 * Gets the exact cost from a cell to the goal.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double       cost (Math::INF if the goal is unreachable)
+			 */
+			double get(Map::Cell* u);
+
+			/**
+			 * Gets the neighbor on a shortest path to the goal.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  Map::Cell*   next cell (NULL if at the goal or unreachable)
+			 */
+			Map::Cell* next(Map::Cell* u);
+
+			/**
+			 * Drops all distances, call after costs changed.
+			 *
+			 * @return  void
+			 */
+			void reset();
+
+		protected:
+
+			/**
+			 * @var  min-heap of (distance, cell index)
+			 */
+			typedef pair<double, unsigned int> Q_PAIR;
+			typedef priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > Q;
+			Q _open;
+
+			/**
+			 * @var  vector<unsigned char>  distance is final
+			 */
+			vector<unsigned char> _closed;
+
+			/**
+			 * @var  vector<double>  distances found so far
+			 */
+			vector<double> _dist;
+
+			/**
+			 * @var  Map*  map
+			 */
+			Map* _map;
+
+			/**
+			 * @var  Planner*  planner
+			 */
+			Planner* _planner;
+	};
+};
+
+#endif // DSTARLITE_TRUE_DISTANCE_H
@@ -0,0 +1,490 @@
+/**
+ * Visibility Graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "visibility_graph.h"
+
+/**
+ * @var  static const unsigned int  size of a tile (in cells)
+ */
+const unsigned int VisibilityGraph::TILE = 16;
+
+/**
+ * Constructor, finds the corners and links every pair.
+ *
+ * Costs are copied, the map is never written.
+ *
+ * @param  Map*         map
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+VisibilityGraph::VisibilityGraph(Map* map, Map::Cell* start, Map::Cell* goal)
+	: _sight(map)
+{
+	_start = vertex(start);
+	_goal = vertex(goal);
+
+	unsigned int rows = map->rows();
+	unsigned int cols = map->cols();
+
+	_buckets.resize(((rows + TILE - 1) / TILE) * ((cols + TILE - 1) / TILE));
+
+	vector<Vertex> changed;
+
+	_add(_goal, changed);
+
+	for (unsigned int y = 0; y <= rows; y++)
+	{
+		for (unsigned int x = 0; x <= cols; x++)
+		{
+			if (_corner(x, y))
+			{
+				Vertex v;
+				v.x = 2 * x;
+				v.y = 2 * y;
+
+				_add(v, changed);
+			}
+		}
+	}
+}
+
+/**
+ * Gets the cost of a cell as known by the graph.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double VisibilityGraph::cost(Map::Cell* u)
+{
+	return _sight.cell(u->x(), u->y());
+}
+
+/**
+ * Estimates the cost between two vertices (straight line distance).
+ *
+ * No cell costs less than one, so the estimate is admissible.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double VisibilityGraph::h(const Vertex& a, const Vertex& b)
+{
+	double dx = (a.x - b.x) / 2.0;
+	double dy = (a.y - b.y) / 2.0;
+
+	return sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * Gets the number of clear links.
+ *
+ * @return  unsigned int
+ */
+unsigned int VisibilityGraph::links()
+{
+	unsigned int count = 0;
+
+	for (VH::iterator it = _vertices.begin(); it != _vertices.end(); it++)
+	{
+		for (vector<unsigned int>::iterator l = it->second.begin(); l != it->second.end(); l++)
+		{
+			if (_links[*l].cost != Math::INF)
+			{
+				count++;
+			}
+		}
+	}
+
+	return count / 2;
+}
+
+/**
+ * Gets the position of a vertex (in cells).
+ *
+ * @param   Vertex                vertex
+ * @return  pair<double,double>   x and y
+ */
+pair<double,double> VisibilityGraph::point(const Vertex& v)
+{
+	return pair<double,double>(v.x / 2.0, v.y / 2.0);
+}
+
+/**
+ * Gets the predecessors of a vertex.
+ *
+ * Links are symmetric, and the start leads to every vertex it sees.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   predecessors and costs (appended)
+ * @return  void
+ */
+void VisibilityGraph::pred(const Vertex& u, Edges& edges)
+{
+	VH::iterator it = _vertices.find(u);
+
+	if (it == _vertices.end())
+		return;
+
+	for (vector<unsigned int>::iterator l = it->second.begin(); l != it->second.end(); l++)
+	{
+		Link& link = _links[*l];
+
+		if (link.cost != Math::INF)
+		{
+			edges.push_back(pair<Vertex, double>((link.a == u) ? link.b : link.a, link.cost));
+		}
+	}
+
+	if (_vertices.find(_start) == _vertices.end())
+	{
+		double cost = _line(_start, u);
+
+		if (cost != Math::INF)
+		{
+			edges.push_back(pair<Vertex, double>(_start, cost));
+		}
+	}
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   Map::Cell*   start cell
+ * @return  Vertex       start vertex
+ */
+VisibilityGraph::Vertex VisibilityGraph::start(Map::Cell* u)
+{
+	_start = vertex(u);
+
+	return _start;
+}
+
+/**
+ * Gets the successors of a vertex.
+ *
+ * @param   Vertex   vertex
+ * @param   Edges&   successors and costs (appended)
+ * @return  void
+ */
+void VisibilityGraph::succ(const Vertex& u, Edges& edges)
+{
+	VH::iterator it = _vertices.find(u);
+
+	if (it != _vertices.end())
+	{
+		for (vector<unsigned int>::iterator l = it->second.begin(); l != it->second.end(); l++)
+		{
+			Link& link = _links[*l];
+
+			if (link.cost != Math::INF)
+			{
+				edges.push_back(pair<Vertex, double>((link.a == u) ? link.b : link.a, link.cost));
+			}
+		}
+
+		return;
+	}
+
+	// The start (or an old one), lines checked on the spot
+	for (it = _vertices.begin(); it != _vertices.end(); it++)
+	{
+		double cost = _line(u, it->first);
+
+		if (cost != Math::INF)
+		{
+			edges.push_back(pair<Vertex, double>(it->first, cost));
+		}
+	}
+}
+
+/**
+ * Changes the cost of a cell.
+ *
+ * @param   Map::Cell*        cell
+ * @param   double            new cost
+ * @param   vector<Vertex>&   corners that vanished (appended)
+ * @param   vector<Vertex>&   vertices whose edges changed, may repeat (appended)
+ * @return  void
+ */
+void VisibilityGraph::update(Map::Cell* u, double cost, vector<Vertex>& removed, vector<Vertex>& changed)
+{
+	vector<Map::Cell*> cells(1, u);
+	vector<double> costs(1, cost);
+
+	update(cells, costs, removed, changed);
+}
+
+/**
+ * Changes the cost of a batch of cells.
+ *
+ * Corners are settled once at the end, so an obstacle that appears cell by
+ * cell only links the corners it ends up with.
+ *
+ * @param   vector<Map::Cell*>&   cells
+ * @param   vector<double>&       new costs
+ * @param   vector<Vertex>&       corners that vanished (appended)
+ * @param   vector<Vertex>&       vertices whose edges changed, may repeat (appended)
+ * @return  void
+ */
+void VisibilityGraph::update(vector<Map::Cell*>& cells, vector<double>& costs, vector<Vertex>& removed, vector<Vertex>& changed)
+{
+	unsigned int tiles = (_sight.cols() + TILE - 1) / TILE;
+
+	vector<Vertex> points;
+
+	for (unsigned int c = 0; c < cells.size(); c++)
+	{
+		int x = cells[c]->x();
+		int y = cells[c]->y();
+
+		if (_sight.cell(x, y) == costs[c])
+			continue;
+
+		_sight.cell(x, y, costs[c]);
+
+		// Links whose line crosses the tile
+		vector<pair<unsigned int, unsigned int> >& bucket = _buckets[(y / TILE) * tiles + x / TILE];
+
+		for (unsigned int i = 0; i < bucket.size(); )
+		{
+			Link& link = _links[bucket[i].first];
+
+			// Slot dropped since, forget the entry
+			if (link.stamp != bucket[i].second)
+			{
+				bucket[i] = bucket.back();
+				bucket.pop_back();
+				continue;
+			}
+
+			// Only lines that touch the cell can change
+			if ( ! LineOfSight::touches(link.a.x, link.a.y, link.b.x, link.b.y, x, y))
+			{
+				i++;
+				continue;
+			}
+
+			double line = _line(link.a, link.b);
+
+			if (line != link.cost)
+			{
+				link.cost = line;
+
+				changed.push_back(link.a);
+				changed.push_back(link.b);
+			}
+
+			i++;
+		}
+
+		for (int j = 0; j < 4; j++)
+		{
+			Vertex v;
+			v.x = 2 * (x + j % 2);
+			v.y = 2 * (y + j / 2);
+
+			points.push_back(v);
+		}
+	}
+
+	// Corners of the cells
+	for (vector<Vertex>::iterator it = points.begin(); it != points.end(); it++)
+	{
+		bool is = _corner(it->x / 2, it->y / 2);
+		bool was = _vertices.find(*it) != _vertices.end();
+
+		if (was && ! is)
+		{
+			_remove(*it, changed);
+			removed.push_back(*it);
+		}
+		else if (is && ! was)
+		{
+			_add(*it, changed);
+			changed.push_back(*it);
+		}
+	}
+}
+
+/**
+ * Gets the vertex of a cell center.
+ *
+ * @param   Map::Cell*   cell
+ * @return  Vertex
+ */
+VisibilityGraph::Vertex VisibilityGraph::vertex(Map::Cell* u)
+{
+	Vertex v;
+	v.x = 2 * u->x() + 1;
+	v.y = 2 * u->y() + 1;
+
+	return v;
+}
+
+/**
+ * Gets the number of vertices (the start not counted).
+ *
+ * @return  unsigned int
+ */
+unsigned int VisibilityGraph::vertices()
+{
+	return _vertices.size();
+}
+
+/**
+ * Adds a vertex and links it to all the others.
+ *
+ * @param   Vertex            vertex
+ * @param   vector<Vertex>&   vertices linked to it (appended)
+ * @return  void
+ */
+void VisibilityGraph::_add(const Vertex& v, vector<Vertex>& changed)
+{
+	unsigned int tiles = (_sight.cols() + TILE - 1) / TILE;
+
+	vector<unsigned int>& links = _vertices[v];
+
+	for (VH::iterator it = _vertices.begin(); it != _vertices.end(); it++)
+	{
+		if (it->first == v)
+			continue;
+
+		unsigned int l;
+
+		if (_free.empty())
+		{
+			l = _links.size();
+			_links.push_back(Link());
+			_links[l].stamp = 0;
+		}
+		else
+		{
+			l = _free.back();
+			_free.pop_back();
+		}
+
+		Link& link = _links[l];
+		link.a = v;
+		link.b = it->first;
+
+		_cells.clear();
+		link.cost = _sight.line(v.x, v.y, it->first.x, it->first.y, &_cells);
+
+		// File under each tile crossed, once
+		for (unsigned int i = 0; i < _cells.size(); i++)
+		{
+			_cells[i] = (_cells[i] / _sight.cols() / TILE) * tiles + (_cells[i] % _sight.cols()) / TILE;
+		}
+
+		sort(_cells.begin(), _cells.end());
+		_cells.erase(unique(_cells.begin(), _cells.end()), _cells.end());
+
+		for (unsigned int i = 0; i < _cells.size(); i++)
+		{
+			_buckets[_cells[i]].push_back(pair<unsigned int, unsigned int>(l, link.stamp));
+		}
+
+		links.push_back(l);
+		it->second.push_back(l);
+
+		if (link.cost != Math::INF)
+		{
+			changed.push_back(it->first);
+		}
+	}
+}
+
+/**
+ * Checks if a grid point is a convex obstacle corner.
+ *
+ * @param   int    x-coordinate (in cells)
+ * @param   int    y-coordinate (in cells)
+ * @return  bool
+ */
+bool VisibilityGraph::_corner(int x, int y)
+{
+	unsigned int blocked = 0;
+
+	for (int j = 0; j < 4; j++)
+	{
+		if (_sight.cell(x - 1 + j % 2, y - 1 + j / 2) == Map::Cell::COST_UNWALKABLE)
+		{
+			blocked++;
+		}
+	}
+
+	return blocked == 1;
+}
+
+/**
+ * Gets the cost of the line between two vertices.
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double   (Math::INF if blocked)
+ */
+double VisibilityGraph::_line(const Vertex& a, const Vertex& b)
+{
+	return _sight.line(a.x, a.y, b.x, b.y);
+}
+
+/**
+ * Drops a vertex and its links.
+ *
+ * @param   Vertex            vertex
+ * @param   vector<Vertex>&   vertices it was linked to (appended)
+ * @return  void
+ */
+void VisibilityGraph::_remove(const Vertex& v, vector<Vertex>& changed)
+{
+	VH::iterator it = _vertices.find(v);
+
+	for (vector<unsigned int>::iterator l = it->second.begin(); l != it->second.end(); l++)
+	{
+		Link& link = _links[*l];
+		Vertex other = (link.a == v) ? link.b : link.a;
+
+		vector<unsigned int>& links = _vertices[other];
+		links.erase(find(links.begin(), links.end(), *l));
+
+		if (link.cost != Math::INF)
+		{
+			changed.push_back(other);
+		}
+
+		link.stamp++;
+		_free.push_back(*l);
+	}
+
+	_vertices.erase(it);
+}
+
+/**
+ * Compares two vertices.
+ *
+ * @param   Vertex   vertex
+ * @return  bool
+ */
+bool VisibilityGraph::Vertex::operator==(const Vertex& v) const
+{
+	return x == v.x && y == v.y;
+}
+
+/**
+ * Hashes a vertex.
+ *
+ * @param   Vertex   vertex
+ * @return  size_t
+ */
+size_t VisibilityGraph::Hash::operator()(const Vertex& v) const
+{
+	return ((size_t) v.y * 73856093) ^ ((size_t) v.x * 19349663);
+}
@@ -0,0 +1,284 @@
+/**
+ * Visibility Graph.
+ *
+ * Map as a visibility graph for the D* Lite engine, for open yards with a
+ * few large obstacles.  The vertices are the convex corners of the
+ * obstacles (grid points with exactly one unwalkable cell around them) plus
+ * the start and goal cells, and two vertices are joined if the straight
+ * line between them is clear, at its line of sight cost.  A yard of
+ * millions of cells becomes a few hundred vertices.
+ *
+ * Every pair of vertices keeps a link, clear or blocked, filed under the
+ * tiles (TILE cells square) its line crosses.  A cost change rechecks only
+ * the links filed under the cell's tile, and adds or drops the corners of
+ * the cell itself.  The start only leads out, its lines are checked on the
+ * spot so moving it costs nothing.
+ *
+ * Paths are shortest when the walkable cells all cost the same; otherwise
+ * they are shortest among the paths that bend at corners only.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_VISIBILITY_GRAPH_H
+#define DSTARLITE_VISIBILITY_GRAPH_H
+
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "line_of_sight.h"
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class VisibilityGraph
+	{
+		public:
+
+			/**
+			 * Vertex, a grid point (even) or cell center (odd), doubled coordinates.
+			 */
+			struct Vertex
+			{
+				int x;
+				int y;
+
+				bool operator==(const Vertex& v) const;
+			};
+
+			/**
+			 * Vertex hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const Vertex& v) const;
+			};
+
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * @var  static const unsigned int  size of a tile (in cells)
+			 */
+			static const unsigned int TILE;
+
+			/**
+			 * Constructor, finds the corners and links every pair.
+			 *
+			 * Costs are copied, the map is never written.
+			 *
+			 * @param  Map*         map
+			 * @param  Map::Cell*   start cell
+			 * @param  Map::Cell*   goal cell
+			 */
+			VisibilityGraph(Map* map, Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Gets the cost of a cell as known by the graph.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Estimates the cost between two vertices (straight line distance).
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Gets the number of clear links.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int links();
+
+			/**
+			 * Gets the position of a vertex (in cells).
+			 *
+			 * @param   Vertex                vertex
+			 * @return  pair<double,double>   x and y
+			 */
+			static pair<double,double> point(const Vertex& v);
+
+			/**
+			 * Gets the predecessors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   predecessors and costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Map::Cell*   start cell
+			 * @return  Vertex       start vertex
+			 */
+			Vertex start(Map::Cell* u);
+
+			/**
+			 * Gets the successors of a vertex.
+			 *
+			 * @param   Vertex   vertex
+			 * @param   Edges&   successors and costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+			/**
+			 * Changes the cost of a cell.
+			 *
+			 * @param   Map::Cell*        cell
+			 * @param   double            new cost
+			 * @param   vector<Vertex>&   corners that vanished (appended)
+			 * @param   vector<Vertex>&   vertices whose edges changed, may repeat (appended)
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost, vector<Vertex>& removed, vector<Vertex>& changed);
+
+			/**
+			 * Changes the cost of a batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells
+			 * @param   vector<double>&       new costs
+			 * @param   vector<Vertex>&       corners that vanished (appended)
+			 * @param   vector<Vertex>&       vertices whose edges changed, may repeat (appended)
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs, vector<Vertex>& removed, vector<Vertex>& changed);
+
+			/**
+			 * Gets the vertex of a cell center.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  Vertex
+			 */
+			static Vertex vertex(Map::Cell* u);
+
+			/**
+			 * Gets the number of vertices (the start not counted).
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int vertices();
+
+		protected:
+
+			/**
+			 * Line between two vertices.
+			 */
+			struct Link
+			{
+				Vertex a;
+				Vertex b;
+
+				/**
+				 * @var  double  line of sight cost (Math::INF if blocked)
+				 */
+				double cost;
+
+				/**
+				 * @var  unsigned int  bumped when the slot is dropped, stale tile entries don't match
+				 */
+				unsigned int stamp;
+			};
+
+#ifdef WIN32
+			typedef unordered_map<Vertex, vector<unsigned int>, Hash> VH;
+#else
+			typedef tr1::unordered_map<Vertex, vector<unsigned int>, Hash> VH;
+#endif
+
+			/**
+			 * @var  vector<vector<pair<unsigned int, unsigned int>>>  links (and stamps) whose line crosses each tile
+			 */
+			vector<vector<pair<unsigned int, unsigned int> > > _buckets;
+
+			/**
+			 * @var  vector<unsigned int>  scratch list of cells crossed
+			 */
+			vector<unsigned int> _cells;
+
+			/**
+			 * @var  vector<unsigned int>  unused link slots
+			 */
+			vector<unsigned int> _free;
+
+			/**
+			 * @var  Vertex  goal vertex
+			 */
+			Vertex _goal;
+
+			/**
+			 * @var  vector<Link>  links (slots in _free are unused)
+			 */
+			vector<Link> _links;
+
+			/**
+			 * @var  LineOfSight  costs and lines
+			 */
+			LineOfSight _sight;
+
+			/**
+			 * @var  Vertex  start vertex
+			 */
+			Vertex _start;
+
+			/**
+			 * @var  VH  links of each vertex
+			 */
+			VH _vertices;
+
+			/**
+			 * Adds a vertex and links it to all the others.
+			 *
+			 * @param   Vertex            vertex
+			 * @param   vector<Vertex>&   vertices linked to it (appended)
+			 * @return  void
+			 */
+			void _add(const Vertex& v, vector<Vertex>& changed);
+
+			/**
+			 * Checks if a grid point is a convex obstacle corner.
+			 *
+			 * @param   int    x-coordinate (in cells)
+			 * @param   int    y-coordinate (in cells)
+			 * @return  bool
+			 */
+			bool _corner(int x, int y);
+
+			/**
+			 * Gets the cost of the line between two vertices.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double   (Math::INF if blocked)
+			 */
+			double _line(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Drops a vertex and its links.
+			 *
+			 * @param   Vertex            vertex
+			 * @param   vector<Vertex>&   vertices it was linked to (appended)
+			 * @return  void
+			 */
+			void _remove(const Vertex& v, vector<Vertex>& changed);
+	};
+};
+
+#endif // DSTARLITE_VISIBILITY_GRAPH_H
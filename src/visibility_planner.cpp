@@ -0,0 +1,166 @@
+/**
+ * Visibility Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "visibility_planner.h"
+
+/**
+ * Constructor.
+ *
+ * The map is never written, the graph keeps its own costs.
+ *
+ * @param  Map*         map
+ * @param  Map::Cell*   start cell
+ * @param  Map::Cell*   goal cell
+ */
+VisibilityPlanner::VisibilityPlanner(Map* map, Map::Cell* start, Map::Cell* goal)
+{
+	_graph = new VisibilityGraph(map, start, goal);
+	_engine = new Engine<VisibilityGraph>(_graph, VisibilityGraph::vertex(start), VisibilityGraph::vertex(goal));
+	_start = start;
+}
+
+/**
+ * Deconstructor.
+ */
+VisibilityPlanner::~VisibilityPlanner()
+{
+	delete _engine;
+	delete _graph;
+}
+
+/**
+ * Gets the cost of a cell as known by the planner.
+ *
+ * @param   Map::Cell*   cell
+ * @return  double
+ */
+double VisibilityPlanner::cost(Map::Cell* u)
+{
+	return _graph->cost(u);
+}
+
+/**
+ * Gets the number of vertices expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int VisibilityPlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the graph.
+ *
+ * @return  VisibilityGraph*
+ */
+VisibilityGraph* VisibilityPlanner::graph()
+{
+	return _graph;
+}
+
+/**
+ * Gets the path from the last replan (start cell, corners, goal cell).
+ *
+ * @return  list<VisibilityGraph::Vertex>&
+ */
+const list<VisibilityGraph::Vertex>& VisibilityPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool VisibilityPlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  Map::Cell*
+ */
+Map::Cell* VisibilityPlanner::start()
+{
+	return _start;
+}
+
+/**
+ * Moves the start.
+ *
+ * The start is a vertex of its own, its edges are worked out on the spot.
+ *
+ * @param   Map::Cell*   new start
+ * @return  void
+ */
+void VisibilityPlanner::start(Map::Cell* u)
+{
+	_start = u;
+
+	VisibilityGraph::Vertex v = _graph->start(u);
+
+	_engine->start(v);
+	_engine->update(v);
+}
+
+/**
+ * Update map.
+ *
+ * @param   Map::Cell*   cell to update
+ * @param   double       new cost of the cell
+ * @return  void
+ */
+void VisibilityPlanner::update(Map::Cell* u, double cost)
+{
+	vector<Map::Cell*> cells(1, u);
+	vector<double> costs(1, cost);
+
+	update(cells, costs);
+}
+
+/**
+ * Update map, batch of cells.
+ *
+ * The graph settles the corners of the whole batch at once.
+ *
+ * @param   vector<Map::Cell*>&   cells to update
+ * @param   vector<double>&       new costs of the cells
+ * @return  void
+ */
+void VisibilityPlanner::update(vector<Map::Cell*>& cells, vector<double>& costs)
+{
+	_removed.clear();
+	_changed.clear();
+
+	_graph->update(cells, costs, _removed, _changed);
+
+	for (vector<VisibilityGraph::Vertex>::iterator it = _removed.begin(); it != _removed.end(); it++)
+	{
+		_engine->forget(*it);
+	}
+
+	for (vector<VisibilityGraph::Vertex>::iterator it = _changed.begin(); it != _changed.end(); it++)
+	{
+		_engine->update(*it);
+	}
+
+	// The start's lines may have changed too
+	_engine->update(VisibilityGraph::vertex(_start));
+}
@@ -0,0 +1,148 @@
+/**
+ * Visibility Planner.
+ *
+ * D* Lite over a visibility graph, with the same incremental update API as
+ * the grid planner.  A cost change rechecks the lines through its tile,
+ * corners that vanished are forgotten and the corners whose lines changed
+ * are repaired.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_VISIBILITY_PLANNER_H
+#define DSTARLITE_VISIBILITY_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "engine.h"
+#include "map.h"
+#include "visibility_graph.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class VisibilityPlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * The map is never written, the graph keeps its own costs.
+			 *
+			 * @param  Map*         map
+			 * @param  Map::Cell*   start cell
+			 * @param  Map::Cell*   goal cell
+			 */
+			VisibilityPlanner(Map* map, Map::Cell* start, Map::Cell* goal);
+
+			/**
+			 * Deconstructor.
+			 */
+			~VisibilityPlanner();
+
+			/**
+			 * Gets the cost of a cell as known by the planner.
+			 *
+			 * @param   Map::Cell*   cell
+			 * @return  double
+			 */
+			double cost(Map::Cell* u);
+
+			/**
+			 * Gets the number of vertices expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the graph.
+			 *
+			 * @return  VisibilityGraph*
+			 */
+			VisibilityGraph* graph();
+
+			/**
+			 * Gets the path from the last replan (start cell, corners, goal cell).
+			 *
+			 * @return  list<VisibilityGraph::Vertex>&
+			 */
+			const list<VisibilityGraph::Vertex>& path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  Map::Cell*
+			 */
+			Map::Cell* start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   Map::Cell*   new start
+			 * @return  void
+			 */
+			void start(Map::Cell* u);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   Map::Cell*   cell to update
+			 * @param   double       new cost of the cell
+			 * @return  void
+			 */
+			void update(Map::Cell* u, double cost);
+
+			/**
+			 * Update map, batch of cells.
+			 *
+			 * @param   vector<Map::Cell*>&   cells to update
+			 * @param   vector<double>&       new costs of the cells
+			 * @return  void
+			 */
+			void update(vector<Map::Cell*>& cells, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  vector<VisibilityGraph::Vertex>  scratch lists of vanished and changed vertices
+			 */
+			vector<VisibilityGraph::Vertex> _changed;
+			vector<VisibilityGraph::Vertex> _removed;
+
+			/**
+			 * @var  Engine<VisibilityGraph>*  D* Lite engine
+			 */
+			Engine<VisibilityGraph>* _engine;
+
+			/**
+			 * @var  VisibilityGraph*  graph
+			 */
+			VisibilityGraph* _graph;
+
+			/**
+			 * @var  list<VisibilityGraph::Vertex>  path
+			 */
+			list<VisibilityGraph::Vertex> _path;
+
+			/**
+			 * @var  Map::Cell*  start cell
+			 */
+			Map::Cell* _start;
+	};
+};
+
+#endif // DSTARLITE_VISIBILITY_PLANNER_H
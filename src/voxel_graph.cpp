@@ -0,0 +1,156 @@
+/**
+ * Voxel Graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <algorithm>
+
+#include "voxel_graph.h"
+
+/**
+ * @var  static const int  x, y and z offsets of the 26 neighbors (faces, edges, corners)
+ */
+const int VoxelGraph::DX[26] = {
+	1, -1, 0, 0, 0, 0,
+	1, 1, -1, -1, 1, 1, -1, -1, 0, 0, 0, 0,
+	1, 1, 1, 1, -1, -1, -1, -1
+};
+const int VoxelGraph::DY[26] = {
+	0, 0, 1, -1, 0, 0,
+	1, -1, 1, -1, 0, 0, 0, 0, 1, 1, -1, -1,
+	1, 1, -1, -1, 1, 1, -1, -1
+};
+const int VoxelGraph::DZ[26] = {
+	0, 0, 0, 0, 1, -1,
+	0, 0, 0, 0, 1, -1, 1, -1, 1, -1, 1, -1,
+	1, -1, 1, -1, 1, -1, 1, -1
+};
+
+/**
+ * @var  static const double  cost multiplier of each move
+ */
+const double VoxelGraph::COST[26] = {
+	1.0, 1.0, 1.0, 1.0, 1.0, 1.0,
+	1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880,
+	1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880,
+	1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880, 1.41421356237309504880,
+	1.73205080756887729353, 1.73205080756887729353, 1.73205080756887729353, 1.73205080756887729353,
+	1.73205080756887729353, 1.73205080756887729353, 1.73205080756887729353, 1.73205080756887729353
+};
+
+/**
+ * Constructor.
+ *
+ * @param  VoxelMap*                 map
+ * @param  unsigned int [optional]   connectivity (6, 18 or 26)
+ */
+VoxelGraph::VoxelGraph(VoxelMap* map, unsigned int connectivity)
+{
+	_map = map;
+	_size = (connectivity == 6 || connectivity == 18) ? connectivity : 26;
+}
+
+/**
+ * Gets the cost of a voxel as known by the graph.
+ *
+ * @param   Vertex   voxel
+ * @return  double
+ */
+double VoxelGraph::cost(const Vertex& v)
+{
+	VH::iterator it = _overlay.find(v);
+
+	return (it == _overlay.end()) ? _map->cost(v) : it->second;
+}
+
+/**
+ * Estimates the cost between two voxels.
+ *
+ * Manhattan distance when 6-connected, otherwise the 3D octile distance
+ * (a lower bound for 18-connected too, it only lacks the corner moves).
+ *
+ * @param   Vertex   a
+ * @param   Vertex   b
+ * @return  double
+ */
+double VoxelGraph::h(const Vertex& a, const Vertex& b)
+{
+	int d[3] = {abs(a.x - b.x), abs(a.y - b.y), abs(a.z - b.z)};
+
+	if (_size == 6)
+		return d[0] + d[1] + d[2];
+
+	sort(d, d + 3);
+
+	return (COST[18] - COST[6]) * d[0] + (COST[6] - 1.0) * d[1] + d[2];
+}
+
+/**
+ * Gets the predecessors of a voxel.
+ *
+ * Moves are symmetric, same as the successors.
+ *
+ * @param   Vertex   voxel
+ * @param   Edges&   predecessors and move costs (appended)
+ * @return  void
+ */
+void VoxelGraph::pred(const Vertex& u, Edges& edges)
+{
+	succ(u, edges);
+}
+
+/**
+ * Sets the cost of a voxel.
+ *
+ * @param   Vertex   voxel
+ * @param   double   cost
+ * @return  void
+ */
+void VoxelGraph::set(const Vertex& v, double cost)
+{
+	_overlay[v] = cost;
+}
+
+/**
+ * Gets the number of neighbors of a voxel.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelGraph::size()
+{
+	return _size;
+}
+
+/**
+ * Gets the successors of a voxel.
+ *
+ * @param   Vertex   voxel
+ * @param   Edges&   successors and move costs (appended)
+ * @return  void
+ */
+void VoxelGraph::succ(const Vertex& u, Edges& edges)
+{
+	double u_cost = cost(u);
+
+	for (unsigned int k = 0; k < _size; k++)
+	{
+		Vertex v = VoxelMap::voxel(u.x + DX[k], u.y + DY[k], u.z + DZ[k]);
+
+		if ( ! _map->has(v))
+			continue;
+
+		double v_cost = cost(v);
+
+		if (u_cost == Map::Cell::COST_UNWALKABLE || v_cost == Map::Cell::COST_UNWALKABLE)
+		{
+			edges.push_back(pair<Vertex, double>(v, Math::INF));
+		}
+		else
+		{
+			edges.push_back(pair<Vertex, double>(v, COST[k] * ((u_cost + v_cost) / 2)));
+		}
+	}
+}
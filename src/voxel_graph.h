@@ -0,0 +1,134 @@
+/**
+ * Voxel Graph.
+ *
+ * Voxel map as a graph for the D* Lite engine, 6-, 18- or 26-connected
+ * (faces, then edges, then corners of the surrounding cube).  Cost changes
+ * go into a sparse overlay, the map itself is never written.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_VOXEL_GRAPH_H
+#define DSTARLITE_VOXEL_GRAPH_H
+
+#include <vector>
+#ifdef WIN32
+	#include <unordered_map>
+#else
+	#include <tr1/unordered_map>
+#endif
+
+#include "voxel_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class VoxelGraph
+	{
+		public:
+
+			typedef VoxelMap::Voxel Vertex;
+			typedef VoxelMap::Hash Hash;
+			typedef vector<pair<Vertex, double> > Edges;
+
+			/**
+			 * @var  static const int  x, y and z offsets of the 26 neighbors (faces, edges, corners)
+			 */
+			static const int DX[26];
+			static const int DY[26];
+			static const int DZ[26];
+
+			/**
+			 * @var  static const double  cost multiplier of each move
+			 */
+			static const double COST[26];
+
+			/**
+			 * Constructor.
+			 *
+			 * @param  VoxelMap*                 map
+			 * @param  unsigned int [optional]   connectivity (6, 18 or 26)
+			 */
+			VoxelGraph(VoxelMap* map, unsigned int connectivity = 26);
+
+			/**
+			 * Gets the cost of a voxel as known by the graph.
+			 *
+			 * @param   Vertex   voxel
+			 * @return  double
+			 */
+			double cost(const Vertex& v);
+
+			/**
+			 * Estimates the cost between two voxels.
+			 *
+			 * @param   Vertex   a
+			 * @param   Vertex   b
+			 * @return  double
+			 */
+			double h(const Vertex& a, const Vertex& b);
+
+			/**
+			 * Gets the predecessors of a voxel.
+			 *
+			 * @param   Vertex   voxel
+			 * @param   Edges&   predecessors and move costs (appended)
+			 * @return  void
+			 */
+			void pred(const Vertex& u, Edges& edges);
+
+			/**
+			 * Sets the cost of a voxel.
+			 *
+			 * @param   Vertex   voxel
+			 * @param   double   cost
+			 * @return  void
+			 */
+			void set(const Vertex& v, double cost);
+
+			/**
+			 * Gets the number of neighbors of a voxel.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int size();
+
+			/**
+			 * Gets the successors of a voxel.
+			 *
+			 * @param   Vertex   voxel
+			 * @param   Edges&   successors and move costs (appended)
+			 * @return  void
+			 */
+			void succ(const Vertex& u, Edges& edges);
+
+		protected:
+
+#ifdef WIN32
+			typedef unordered_map<Vertex, double, Hash> VH;
+#else
+			typedef tr1::unordered_map<Vertex, double, Hash> VH;
+#endif
+
+			/**
+			 * @var  VoxelMap*  map
+			 */
+			VoxelMap* _map;
+
+			/**
+			 * @var  VH  changed costs
+			 */
+			VH _overlay;
+
+			/**
+			 * @var  unsigned int  number of neighbors
+			 */
+			unsigned int _size;
+	};
+};
+
+#endif // DSTARLITE_VOXEL_GRAPH_H
@@ -0,0 +1,219 @@
+/**
+ * Voxel Map.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "voxel_map.h"
+
+/**
+ * @var  static const unsigned int  chunk edge length is 2^CHUNK_BITS voxels
+ */
+const unsigned int VoxelMap::CHUNK_BITS = 4;
+
+/**
+ * Constructor, all voxels at the default cost.
+ *
+ * @param  unsigned int        width (x)
+ * @param  unsigned int        height (y)
+ * @param  unsigned int        depth (z)
+ * @param  double [optional]   default cost
+ */
+VoxelMap::VoxelMap(unsigned int width, unsigned int height, unsigned int depth, double cost)
+{
+	unsigned int edge = 1 << CHUNK_BITS;
+
+	_width = width;
+	_height = height;
+	_depth = depth;
+	_default = cost;
+	_size = 0;
+
+	_cx = (width + edge - 1) >> CHUNK_BITS;
+	_cy = (height + edge - 1) >> CHUNK_BITS;
+
+	_chunks.assign(_cx * _cy * ((depth + edge - 1) >> CHUNK_BITS), NULL);
+}
+
+/**
+ * Deconstructor.
+ */
+VoxelMap::~VoxelMap()
+{
+	for (unsigned int i = 0; i < _chunks.size(); i++)
+	{
+		delete _chunks[i];
+	}
+}
+
+/**
+ * Gets the number of allocated chunks.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelMap::chunks()
+{
+	return _size;
+}
+
+/**
+ * Gets the cost of a voxel.
+ *
+ * @param   Voxel    voxel
+ * @return  double
+ */
+double VoxelMap::cost(const Voxel& v)
+{
+	unsigned int offset;
+	Chunk* chunk = _chunks[_locate(v, offset)];
+
+	return (chunk == NULL) ? _default : chunk->costs[offset];
+}
+
+/**
+ * Gets the depth.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelMap::depth()
+{
+	return _depth;
+}
+
+/**
+ * Checks if a voxel is within the bounds.
+ *
+ * @param   Voxel   voxel
+ * @return  bool
+ */
+bool VoxelMap::has(const Voxel& v)
+{
+	return v.x >= 0 && v.x < (int) _width && v.y >= 0 && v.y < (int) _height && v.z >= 0 && v.z < (int) _depth;
+}
+
+/**
+ * Gets the height.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelMap::height()
+{
+	return _height;
+}
+
+/**
+ * Sets the cost of a voxel.
+ *
+ * @param   Voxel    voxel
+ * @param   double   cost
+ * @return  void
+ */
+void VoxelMap::set(const Voxel& v, double cost)
+{
+	unsigned int offset;
+	unsigned int k = _locate(v, offset);
+
+	Chunk* chunk = _chunks[k];
+
+	if (chunk == NULL)
+	{
+		if (cost == _default)
+			return;
+
+		chunk = new Chunk();
+		chunk->costs.assign(1 << (3 * CHUNK_BITS), _default);
+		chunk->used = 0;
+
+		_chunks[k] = chunk;
+		_size++;
+	}
+
+	double old = chunk->costs[offset];
+
+	if (old == _default && cost != _default)
+	{
+		chunk->used++;
+	}
+	else if (old != _default && cost == _default)
+	{
+		chunk->used--;
+	}
+
+	chunk->costs[offset] = cost;
+
+	// All back to the default, the chunk is not needed anymore
+	if (chunk->used == 0)
+	{
+		delete chunk;
+		_chunks[k] = NULL;
+		_size--;
+	}
+}
+
+/**
+ * Makes a voxel.
+ *
+ * @param   int     x-coordinate
+ * @param   int     y-coordinate
+ * @param   int     z-coordinate
+ * @return  Voxel
+ */
+VoxelMap::Voxel VoxelMap::voxel(int x, int y, int z)
+{
+	Voxel v;
+	v.x = x;
+	v.y = y;
+	v.z = z;
+
+	return v;
+}
+
+/**
+ * Gets the width.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelMap::width()
+{
+	return _width;
+}
+
+/**
+ * Gets the chunk and the offset within it of a voxel.
+ *
+ * @param   Voxel           voxel
+ * @param   unsigned int&   offset within the chunk
+ * @return  unsigned int    chunk index
+ */
+unsigned int VoxelMap::_locate(const Voxel& v, unsigned int& offset)
+{
+	unsigned int mask = (1 << CHUNK_BITS) - 1;
+
+	offset = (((v.z & mask) << CHUNK_BITS | (v.y & mask)) << CHUNK_BITS) | (v.x & mask);
+
+	return ((v.z >> CHUNK_BITS) * _cy + (v.y >> CHUNK_BITS)) * _cx + (v.x >> CHUNK_BITS);
+}
+
+/**
+ * Compares two voxels.
+ *
+ * @param   Voxel   voxel
+ * @return  bool
+ */
+bool VoxelMap::Voxel::operator==(const Voxel& v) const
+{
+	return x == v.x && y == v.y && z == v.z;
+}
+
+/**
+ * Hashes a voxel.
+ *
+ * @param   Voxel   voxel
+ * @return  size_t
+ */
+size_t VoxelMap::Hash::operator()(const Voxel& v) const
+{
+	return ((size_t) v.x * 73856093) ^ ((size_t) v.y * 19349663) ^ ((size_t) v.z * 83492791);
+}
@@ -0,0 +1,191 @@
+/**
+ * Voxel Map.
+ *
+ * 3D cost grid for aerial robots.  Most of the air volume is free, so the
+ * voxels are stored in cubic chunks that are only allocated once one of
+ * their voxels gets a cost other than the default; a chunk is freed again
+ * when all of its voxels are back to the default.  Memory grows with the
+ * occupied volume, not with the bounds.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_VOXEL_MAP_H
+#define DSTARLITE_VOXEL_MAP_H
+
+#include <vector>
+
+#include "map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class VoxelMap
+	{
+		public:
+
+			/**
+			 * Voxel coordinates.
+			 */
+			struct Voxel
+			{
+				int x;
+				int y;
+				int z;
+
+				bool operator==(const Voxel& v) const;
+			};
+
+			/**
+			 * Voxel hash.
+			 */
+			struct Hash
+			{
+				size_t operator()(const Voxel& v) const;
+			};
+
+			/**
+			 * @var  static const unsigned int  chunk edge length is 2^CHUNK_BITS voxels
+			 */
+			static const unsigned int CHUNK_BITS;
+
+			/**
+			 * Constructor, all voxels at the default cost.
+			 *
+			 * @param  unsigned int        width (x)
+			 * @param  unsigned int        height (y)
+			 * @param  unsigned int        depth (z)
+			 * @param  double [optional]   default cost
+			 */
+			VoxelMap(unsigned int width, unsigned int height, unsigned int depth, double cost = 1.0);
+
+			/**
+			 * Deconstructor.
+			 */
+			~VoxelMap();
+
+			/**
+			 * Gets the number of allocated chunks.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int chunks();
+
+			/**
+			 * Gets the cost of a voxel.
+			 *
+			 * @param   Voxel    voxel
+			 * @return  double
+			 */
+			double cost(const Voxel& v);
+
+			/**
+			 * Gets the depth.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int depth();
+
+			/**
+			 * Checks if a voxel is within the bounds.
+			 *
+			 * @param   Voxel   voxel
+			 * @return  bool
+			 */
+			bool has(const Voxel& v);
+
+			/**
+			 * Gets the height.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int height();
+
+			/**
+			 * Sets the cost of a voxel.
+			 *
+			 * @param   Voxel    voxel
+			 * @param   double   cost
+			 * @return  void
+			 */
+			void set(const Voxel& v, double cost);
+
+			/**
+			 * Makes a voxel.
+			 *
+			 * @param   int     x-coordinate
+			 * @param   int     y-coordinate
+			 * @param   int     z-coordinate
+			 * @return  Voxel
+			 */
+			static Voxel voxel(int x, int y, int z);
+
+			/**
+			 * Gets the width.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int width();
+
+		protected:
+
+			/**
+			 * Chunk of voxels.
+			 */
+			struct Chunk
+			{
+				/**
+				 * @var  vector<double>  voxel costs
+				 */
+				vector<double> costs;
+
+				/**
+				 * @var  unsigned int  voxels not at the default cost
+				 */
+				unsigned int used;
+			};
+
+			/**
+			 * @var  vector<Chunk*>  chunk directory (NULL if not allocated)
+			 */
+			vector<Chunk*> _chunks;
+
+			/**
+			 * @var  unsigned int  chunks along x, y
+			 */
+			unsigned int _cx;
+			unsigned int _cy;
+
+			/**
+			 * @var  double  cost of voxels in unallocated chunks
+			 */
+			double _default;
+
+			/**
+			 * @var  unsigned int  dimensions
+			 */
+			unsigned int _depth;
+			unsigned int _height;
+			unsigned int _width;
+
+			/**
+			 * @var  unsigned int  allocated chunks
+			 */
+			unsigned int _size;
+
+			/**
+			 * Gets the chunk and the offset within it of a voxel.
+			 *
+			 * @param   Voxel           voxel
+			 * @param   unsigned int&   offset within the chunk
+			 * @return  unsigned int    chunk index
+			 */
+			unsigned int _locate(const Voxel& v, unsigned int& offset);
+	};
+};
+
+#endif // DSTARLITE_VOXEL_MAP_H
@@ -0,0 +1,164 @@
+/**
+ * Voxel Planner.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include "voxel_planner.h"
+
+/**
+ * Constructor.
+ *
+ * The map is never written, cost updates go into the graph's overlay.
+ *
+ * @param  VoxelMap*                 map
+ * @param  VoxelMap::Voxel           start voxel
+ * @param  VoxelMap::Voxel           goal voxel
+ * @param  unsigned int [optional]   connectivity (6, 18 or 26)
+ */
+VoxelPlanner::VoxelPlanner(VoxelMap* map, const VoxelMap::Voxel& start, const VoxelMap::Voxel& goal, unsigned int connectivity)
+{
+	_graph = new VoxelGraph(map, connectivity);
+
+	// Volumes are large, allow every voxel to be expanded twice
+	unsigned int limit = 2 * map->width() * map->height() * map->depth();
+
+	if (limit < Engine<VoxelGraph>::MAX_STEPS)
+	{
+		limit = Engine<VoxelGraph>::MAX_STEPS;
+	}
+
+	_engine = new Engine<VoxelGraph>(_graph, start, goal, limit);
+}
+
+/**
+ * Deconstructor.
+ */
+VoxelPlanner::~VoxelPlanner()
+{
+	delete _engine;
+	delete _graph;
+}
+
+/**
+ * Gets the cost of a voxel as known by the planner.
+ *
+ * @param   VoxelMap::Voxel   voxel
+ * @return  double
+ */
+double VoxelPlanner::cost(const VoxelMap::Voxel& v)
+{
+	return _graph->cost(v);
+}
+
+/**
+ * Gets the number of voxels expanded so far.
+ *
+ * @return  unsigned int
+ */
+unsigned int VoxelPlanner::expanded()
+{
+	return _engine->expanded();
+}
+
+/**
+ * Gets the graph.
+ *
+ * @return  VoxelGraph*
+ */
+VoxelGraph* VoxelPlanner::graph()
+{
+	return _graph;
+}
+
+/**
+ * Gets the path from the last replan.
+ *
+ * @return  list<VoxelMap::Voxel>
+ */
+list<VoxelMap::Voxel> VoxelPlanner::path()
+{
+	return _path;
+}
+
+/**
+ * Replans the path.
+ *
+ * @return  bool   solution found
+ */
+bool VoxelPlanner::replan()
+{
+	_path.clear();
+
+	if ( ! _engine->compute() || ! _engine->path(_path))
+	{
+		_path.clear();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Gets the start.
+ *
+ * @return  VoxelMap::Voxel
+ */
+VoxelMap::Voxel VoxelPlanner::start()
+{
+	return _engine->start();
+}
+
+/**
+ * Moves the start.
+ *
+ * @param   VoxelMap::Voxel   new start
+ * @return  void
+ */
+void VoxelPlanner::start(const VoxelMap::Voxel& v)
+{
+	_engine->start(v);
+}
+
+/**
+ * Update map.
+ *
+ * @param   VoxelMap::Voxel   voxel to update
+ * @param   double            new cost of the voxel
+ * @return  void
+ */
+void VoxelPlanner::update(const VoxelMap::Voxel& v, double cost)
+{
+	if (_graph->cost(v) == cost)
+		return;
+
+	_graph->set(v, cost);
+
+	// The voxel's moves and its neighbors' moves into it changed
+	_edges.clear();
+	_graph->succ(v, _edges);
+
+	_engine->update(v);
+
+	for (VoxelGraph::Edges::iterator it = _edges.begin(); it != _edges.end(); it++)
+	{
+		_engine->update(it->first);
+	}
+}
+
+/**
+ * Update map, batch of voxels.
+ *
+ * @param   vector<VoxelMap::Voxel>&   voxels to update
+ * @param   vector<double>&            new costs of the voxels
+ * @return  void
+ */
+void VoxelPlanner::update(vector<VoxelMap::Voxel>& voxels, vector<double>& costs)
+{
+	for (unsigned int i = 0; i < voxels.size(); i++)
+	{
+		update(voxels[i], costs[i]);
+	}
+}
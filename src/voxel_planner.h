@@ -0,0 +1,141 @@
+/**
+ * Voxel Planner.
+ *
+ * D* Lite over a voxel map, with the same incremental update API as the
+ * grid planner.  A cost change repairs the voxel and its neighbors only.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_VOXEL_PLANNER_H
+#define DSTARLITE_VOXEL_PLANNER_H
+
+#include <list>
+#include <vector>
+
+#include "engine.h"
+#include "voxel_graph.h"
+#include "voxel_map.h"
+
+using namespace std;
+using namespace DStarLite;
+
+namespace DStarLite
+{
+	class VoxelPlanner
+	{
+		public:
+
+			/**
+			 * Constructor.
+			 *
+			 * The map is never written, cost updates go into the graph's overlay.
+			 *
+			 * @param  VoxelMap*                 map
+			 * @param  VoxelMap::Voxel           start voxel
+			 * @param  VoxelMap::Voxel           goal voxel
+			 * @param  unsigned int [optional]   connectivity (6, 18 or 26)
+			 */
+			VoxelPlanner(VoxelMap* map, const VoxelMap::Voxel& start, const VoxelMap::Voxel& goal, unsigned int connectivity = 26);
+
+			/**
+			 * Deconstructor.
+			 */
+			~VoxelPlanner();
+
+			/**
+			 * Gets the cost of a voxel as known by the planner.
+			 *
+			 * @param   VoxelMap::Voxel   voxel
+			 * @return  double
+			 */
+			double cost(const VoxelMap::Voxel& v);
+
+			/**
+			 * Gets the number of voxels expanded so far.
+			 *
+			 * @return  unsigned int
+			 */
+			unsigned int expanded();
+
+			/**
+			 * Gets the graph.
+			 *
+			 * @return  VoxelGraph*
+			 */
+			VoxelGraph* graph();
+
+			/**
+			 * Gets the path from the last replan.
+			 *
+			 * @return  list<VoxelMap::Voxel>
+			 */
+			list<VoxelMap::Voxel> path();
+
+			/**
+			 * Replans the path.
+			 *
+			 * @return  bool   solution found
+			 */
+			bool replan();
+
+			/**
+			 * Gets the start.
+			 *
+			 * @return  VoxelMap::Voxel
+			 */
+			VoxelMap::Voxel start();
+
+			/**
+			 * Moves the start.
+			 *
+			 * @param   VoxelMap::Voxel   new start
+			 * @return  void
+			 */
+			void start(const VoxelMap::Voxel& v);
+
+			/**
+			 * Update map.
+			 *
+			 * @param   VoxelMap::Voxel   voxel to update
+			 * @param   double            new cost of the voxel
+			 * @return  void
+			 */
+			void update(const VoxelMap::Voxel& v, double cost);
+
+			/**
+			 * Update map, batch of voxels.
+			 *
+			 * @param   vector<VoxelMap::Voxel>&   voxels to update
+			 * @param   vector<double>&            new costs of the voxels
+			 * @return  void
+			 */
+			void update(vector<VoxelMap::Voxel>& voxels, vector<double>& costs);
+
+		protected:
+
+			/**
+			 * @var  VoxelGraph::Edges  scratch list of neighbors
+			 */
+			VoxelGraph::Edges _edges;
+
+			/**
+			 * @var  Engine<VoxelGraph>*  D* Lite engine
+			 */
+			Engine<VoxelGraph>* _engine;
+
+			/**
+			 * @var  VoxelGraph*  graph
+			 */
+			VoxelGraph* _graph;
+
+			/**
+			 * @var  list<VoxelMap::Voxel>  path
+			 */
+			list<VoxelMap::Voxel> _path;
+	};
+};
+
+#endif // DSTARLITE_VOXEL_PLANNER_H
@@ -0,0 +1,94 @@
+/**
+ * Allocations.
+ *
+ * Replaces the global operator new and delete to count heap allocations
+ * while counting is on.  Include it in exactly one file of a test driver.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#ifndef DSTARLITE_TESTS_ALLOCATIONS_H
+#define DSTARLITE_TESTS_ALLOCATIONS_H
+
+#include <cstdlib>
+#include <new>
+
+namespace Allocations
+{
+	/**
+	 * @var  unsigned long  allocations counted so far
+	 */
+	unsigned long count = 0;
+
+	/**
+	 * @var  bool  counting is on
+	 */
+	bool counting = false;
+
+	/**
+	 * Starts counting from zero.
+	 *
+	 * @return  void
+	 */
+	void start()
+	{
+		count = 0;
+		counting = true;
+	}
+
+	/**
+	 * Stops counting.
+	 *
+	 * @return  unsigned long   allocations counted since start()
+	 */
+	unsigned long stop()
+	{
+		counting = false;
+		return count;
+	}
+
+	/**
+	 * Allocates, counting if on.
+	 *
+	 * @param   size_t   size
+	 * @return  void*
+	 */
+	void* allocate(size_t size)
+	{
+		if (counting)
+		{
+			count++;
+		}
+
+		void* p = malloc(size ? size : 1);
+
+		if (p == NULL)
+			throw std::bad_alloc();
+
+		return p;
+	}
+}
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+	return Allocations::allocate(size);
+}
+
+void* operator new[](size_t size) throw(std::bad_alloc)
+{
+	return Allocations::allocate(size);
+}
+
+void operator delete(void* p) throw()
+{
+	free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+	free(p);
+}
+
+#endif
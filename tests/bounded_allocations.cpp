@@ -0,0 +1,405 @@
+/**
+ * Bounded Allocations Test.
+ *
+ * Drives a BoundedPlanner along its path on an 80x90 map while obstacles
+ * appear around the robot.  Fails if replan(), start() or update()
+ * allocates, if the planner holds more cells than its capacity, if it
+ * writes the map, or if a path is not a walkable chain of moves.  With the
+ * whole map as capacity the paths must also be optimal (checked against
+ * Dijkstra); smaller capacities fall back to the corridor and only need
+ * valid paths.  A wall across the corridor must not stop the robot when a
+ * detour fits in the slots.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <vector>
+
+#include "allocations.h"
+#include "bounded_planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const unsigned int  map rows
+ */
+static const unsigned int ROWS = 80;
+
+/**
+ * @var  static const unsigned int  map columns
+ */
+static const unsigned int COLS = 90;
+
+/**
+ * Gets the cost of a move, same rules as the planners.
+ *
+ * @param   Map::Cell*     cell
+ * @param   unsigned int   neighbor index
+ * @return  double         cost (Math::INF if blocked)
+ */
+double move(Map::Cell* a, unsigned int k)
+{
+	Map::Cell** nbrs = a->nbrs();
+	Map::Cell* b = nbrs[k];
+
+	if (b == NULL || a->cost == Map::Cell::COST_UNWALKABLE || b->cost == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			if (nbrs[Neighborhood::VIA[k][s]]->cost == Map::Cell::COST_UNWALKABLE)
+				return Math::INF;
+		}
+	}
+
+	return Neighborhood::COST[k] * ((a->cost + b->cost) / 2);
+}
+
+/**
+ * Gets the cost of a path, Math::INF if two cells are not joined by a move.
+ *
+ * @param   Map*                  map with the costs (the path may be on another map of the same size)
+ * @param   vector<Map::Cell*>&   path
+ * @return  double
+ */
+double cost(Map* map, const vector<Map::Cell*>& path)
+{
+	double sum = 0.0;
+
+	for (unsigned int i = 1; i < path.size(); i++)
+	{
+		double step = Math::INF;
+		Map::Cell* a = (*map)(path[i - 1]->y(), path[i - 1]->x());
+		Map::Cell** nbrs = a->nbrs();
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (nbrs[k] != NULL && nbrs[k]->x() == path[i]->x() && nbrs[k]->y() == path[i]->y())
+			{
+				step = move(a, k);
+			}
+		}
+
+		if (step == Math::INF)
+			return Math::INF;
+
+		sum += step;
+	}
+
+	return sum;
+}
+
+/**
+ * Gets the cost of the shortest path between two cells.
+ *
+ * @param   Map*         map
+ * @param   Map::Cell*   start
+ * @param   Map::Cell*   goal
+ * @return  double       cost (Math::INF if unreachable)
+ */
+double dijkstra(Map* map, Map::Cell* start, Map::Cell* goal)
+{
+	typedef pair<double, Map::Cell*> Entry;
+
+	vector<double> dist(ROWS * COLS, Math::INF);
+	priority_queue<Entry, vector<Entry>, greater<Entry> > queue;
+
+	dist[start->y() * COLS + start->x()] = 0.0;
+	queue.push(Entry(0.0, start));
+
+	while ( ! queue.empty())
+	{
+		Entry e = queue.top();
+		queue.pop();
+
+		Map::Cell* u = e.second;
+
+		if (u == goal)
+			return e.first;
+
+		if (e.first > dist[u->y() * COLS + u->x()])
+			continue;
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			double c = move(u, k);
+
+			if (c == Math::INF)
+				continue;
+
+			Map::Cell* v = u->nbrs()[k];
+			double d = e.first + c;
+
+			if (Math::less(d, dist[v->y() * COLS + v->x()]))
+			{
+				dist[v->y() * COLS + v->x()] = d;
+				queue.push(Entry(d, v));
+			}
+		}
+	}
+
+	return Math::INF;
+}
+
+/**
+ * Runs one trial.
+ *
+ * @param   unsigned int   capacity
+ * @param   unsigned int   seed
+ * @return  unsigned int   number of failures
+ */
+unsigned int trial(unsigned int capacity, unsigned int seed)
+{
+	srand(seed);
+
+	// The planner's map is shared and must stay as it is, the changes go into the real map
+	Map map(ROWS, COLS);
+	Map real(ROWS, COLS);
+
+	for (unsigned int i = 0; i < ROWS; i++)
+	{
+		for (unsigned int j = 0; j < COLS; j++)
+		{
+			bool corner = (i < 2 && j < 2) || (i > ROWS - 3 && j > COLS - 3);
+			map(i, j)->cost = ( ! corner && rand() % 8 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + (corner ? 0 : rand() % 3);
+			real(i, j)->cost = map(i, j)->cost;
+		}
+	}
+
+	vector<double> prior;
+
+	for (unsigned int k = 0; k < ROWS * COLS; k++)
+	{
+		prior.push_back(map(k / COLS, k % COLS)->cost);
+	}
+
+	Map::Cell* goal = map(ROWS - 1, COLS - 1);
+	Map::Cell* current = map(0, 0);
+
+	BoundedPlanner planner(&map, current, goal, capacity);
+
+	bool optimal = capacity >= ROWS * COLS;
+	unsigned int failures = 0;
+
+	for (unsigned int step = 0; step < 60; step++)
+	{
+		Allocations::start();
+		bool ok = planner.replan();
+
+		if (Allocations::stop() > 0)
+		{
+			printf("  capacity %u seed %u step %u: replan allocated\n", capacity, seed, step);
+			failures++;
+		}
+
+		if (planner.size() > planner.capacity())
+		{
+			printf("  capacity %u seed %u step %u: over capacity\n", capacity, seed, step);
+			failures++;
+		}
+
+		double reference = dijkstra(&real, real(current->y(), current->x()), real(goal->y(), goal->x()));
+
+		if ( ! ok)
+		{
+			// Only a corridor may miss a path that exists
+			if (optimal && reference != Math::INF)
+			{
+				printf("  capacity %u seed %u step %u: no path found\n", capacity, seed, step);
+				failures++;
+			}
+
+			break;
+		}
+
+		const vector<Map::Cell*>& path = planner.path();
+		double c = cost(&real, path);
+
+		if (path.front() != current || path.back() != goal || c == Math::INF)
+		{
+			printf("  capacity %u seed %u step %u: invalid path\n", capacity, seed, step);
+			failures++;
+			break;
+		}
+
+		if (optimal && ! Math::equals(c, reference, 0.000001))
+		{
+			printf("  capacity %u seed %u step %u: cost %f, optimum %f\n", capacity, seed, step, c, reference);
+			failures++;
+			break;
+		}
+
+		if (path.size() < 2)
+			break;
+
+		current = path[1];
+
+		// Move on, obstacles appear and vanish around the robot
+		Allocations::start();
+		planner.start(current);
+
+		for (unsigned int k = 0; k < 8; k++)
+		{
+			int x = (int) current->x() + rand() % 11 - 5;
+			int y = (int) current->y() + rand() % 11 - 5;
+
+			if ( ! map.has(y, x) || map(y, x) == goal || map(y, x) == current)
+				continue;
+
+			double c = (rand() % 3 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3;
+			real(y, x)->cost = c;
+
+			if ( ! planner.update(map(y, x), c))
+			{
+				printf("  capacity %u seed %u step %u: change refused\n", capacity, seed, step);
+				failures++;
+			}
+		}
+
+		if (Allocations::stop() > 0)
+		{
+			printf("  capacity %u seed %u step %u: start or update allocated\n", capacity, seed, step);
+			failures++;
+		}
+	}
+
+	for (unsigned int k = 0; k < ROWS * COLS; k++)
+	{
+		if (map(k / COLS, k % COLS)->cost != prior[k])
+		{
+			printf("  capacity %u seed %u: map written\n", capacity, seed);
+			failures++;
+			break;
+		}
+	}
+
+	return failures;
+}
+
+/**
+ * Changes beyond the table are refused, undoing one makes room.
+ *
+ * @return  bool   passed
+ */
+bool changes()
+{
+	Map map(4, 4);
+	BoundedPlanner planner(&map, map(0, 0), map(3, 3), 16, 2);
+
+	bool ok = planner.update(map(1, 1), 5.0) && planner.update(map(1, 2), 5.0)
+		&& ! planner.update(map(2, 1), 5.0) && planner.cost(map(2, 1)) == 1.0;
+
+	// Back to the map's cost, the entry is freed
+	ok = ok && planner.update(map(1, 1), 1.0) && planner.update(map(2, 1), 5.0);
+
+	return ok && planner.cost(map(1, 2)) == 5.0 && planner.cost(map(2, 1)) == 5.0 && map(1, 2)->cost == 1.0;
+}
+
+/**
+ * Drives across a free map with a wall across the middle of the corridor.
+ *
+ * @param   unsigned int   capacity
+ * @param   int            wall half length (cells along the anti-diagonal)
+ * @return  unsigned int   number of failures
+ */
+unsigned int blocked(unsigned int capacity, int half)
+{
+	Map map(ROWS, COLS);
+	Map::Cell* goal = map(ROWS - 1, COLS - 1);
+	Map::Cell* current = map(0, 0);
+
+	BoundedPlanner planner(&map, current, goal, capacity);
+
+	// Two cells thick, so diagonal moves cannot slip through
+	for (int t = -half; t <= half; t++)
+	{
+		int x = COLS / 2 + t;
+		int y = ROWS / 2 - t;
+
+		planner.update(map(y, x), Map::Cell::COST_UNWALKABLE);
+		planner.update(map(y, x + 1), Map::Cell::COST_UNWALKABLE);
+	}
+
+	unsigned int failures = 0;
+
+	for (unsigned int step = 0; current != goal && step < ROWS + COLS; step++)
+	{
+		Allocations::start();
+		bool ok = planner.replan();
+
+		if (Allocations::stop() > 0)
+		{
+			printf("  blocked capacity %u step %u: replan allocated\n", capacity, step);
+			failures++;
+		}
+
+		if ( ! ok || planner.size() > planner.capacity())
+		{
+			printf("  blocked capacity %u step %u: no path (corridor %d, %u cells)\n", capacity, step, planner.corridor(), planner.size());
+			return failures + 1;
+		}
+
+		const vector<Map::Cell*>& path = planner.path();
+
+		for (unsigned int i = 0; i < path.size(); i++)
+		{
+			if (planner.cost(path[i]) == Map::Cell::COST_UNWALKABLE)
+			{
+				printf("  blocked capacity %u step %u: path through the wall\n", capacity, step);
+				return failures + 1;
+			}
+		}
+
+		current = path[1];
+		planner.start(current);
+	}
+
+	if (current != goal)
+	{
+		printf("  blocked capacity %u: goal not reached\n", capacity);
+		failures++;
+	}
+
+	return failures;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int capacities[3] = {ROWS * COLS, 3000, 800};
+	unsigned int failures = 0;
+
+	if ( ! changes())
+	{
+		printf("  change table full: changes not refused or not freed\n");
+		failures++;
+	}
+
+	// The corridor is narrower than the wall, the detour fits in the slots
+	failures += blocked(800, 6);
+	failures += blocked(1500, 10);
+
+	for (unsigned int c = 0; c < 3; c++)
+	{
+		for (unsigned int seed = 1; seed <= 20; seed++)
+		{
+			failures += trial(capacities[c], seed);
+		}
+	}
+
+	if (failures > 0)
+	{
+		printf("bounded allocations: FAILED (%u)\n", failures);
+		return 1;
+	}
+
+	printf("bounded allocations: passed\n");
+	return 0;
+}
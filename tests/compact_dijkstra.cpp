@@ -0,0 +1,255 @@
+/**
+ * Compact Dijkstra Test.
+ *
+ * Drives a Planner across a 200x200 map while costs change around the
+ * robot, compacting its state down to a budget before every replan, and
+ * fails if a replan does not find a path or finds one that is not as cheap
+ * as Dijkstra's.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const unsigned int  map edge length
+ */
+static const unsigned int SIZE = 200;
+
+/**
+ * Gets the cost of a move, same rules as the planner.
+ *
+ * @param   vector<double>&   costs
+ * @param   Map::Cell*        cell
+ * @param   unsigned int      neighbor index
+ * @return  double            cost (Math::INF if blocked)
+ */
+double move(const vector<double>& costs, Map::Cell* a, unsigned int k)
+{
+	Map::Cell** nbrs = a->nbrs();
+	Map::Cell* b = nbrs[k];
+
+	if (b == NULL)
+		return Math::INF;
+
+	double a_cost = costs[a->y() * SIZE + a->x()];
+	double b_cost = costs[b->y() * SIZE + b->x()];
+
+	if (a_cost == Map::Cell::COST_UNWALKABLE || b_cost == Map::Cell::COST_UNWALKABLE)
+		return Math::INF;
+
+	if (Neighborhood::VIAS && Neighborhood::VIA[k][0] >= 0)
+	{
+		for (unsigned int s = 0; s < 2; s++)
+		{
+			Map::Cell* via = nbrs[Neighborhood::VIA[k][s]];
+
+			if (costs[via->y() * SIZE + via->x()] == Map::Cell::COST_UNWALKABLE)
+				return Math::INF;
+		}
+	}
+
+	return Neighborhood::COST[k] * ((a_cost + b_cost) / 2);
+}
+
+/**
+ * Gets the cost of a path, Math::INF if two cells are not joined by a move.
+ *
+ * @param   vector<double>&       costs
+ * @param   list<Map::Cell*>&     path
+ * @return  double
+ */
+double cost(const vector<double>& costs, const list<Map::Cell*>& path)
+{
+	double sum = 0.0;
+	list<Map::Cell*>::const_iterator it = path.begin();
+
+	for (Map::Cell* u = *it++; it != path.end(); u = *it++)
+	{
+		double step = Math::INF;
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			if (u->nbrs()[k] == *it)
+			{
+				step = move(costs, u, k);
+			}
+		}
+
+		if (step == Math::INF)
+			return Math::INF;
+
+		sum += step;
+	}
+
+	return sum;
+}
+
+/**
+ * Gets the cost of the shortest path between two cells.
+ *
+ * @param   vector<double>&   costs
+ * @param   Map::Cell*        start
+ * @param   Map::Cell*        goal
+ * @return  double            cost (Math::INF if unreachable)
+ */
+double dijkstra(const vector<double>& costs, Map::Cell* start, Map::Cell* goal)
+{
+	typedef pair<double, Map::Cell*> Q_PAIR;
+
+	vector<double> dist(SIZE * SIZE, Math::INF);
+	priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > open;
+
+	dist[start->y() * SIZE + start->x()] = 0.0;
+	open.push(Q_PAIR(0.0, start));
+
+	while ( ! open.empty())
+	{
+		Q_PAIR top = open.top();
+		open.pop();
+
+		Map::Cell* u = top.second;
+
+		if (u == goal)
+			return top.first;
+
+		if (top.first > dist[u->y() * SIZE + u->x()])
+			continue;
+
+		for (unsigned int k = 0; k < Map::Cell::NUM_NBRS; k++)
+		{
+			double c = move(costs, u, k);
+
+			if (c == Math::INF)
+				continue;
+
+			Map::Cell* v = u->nbrs()[k];
+			double d = top.first + c;
+
+			if (Math::less(d, dist[v->y() * SIZE + v->x()]))
+			{
+				dist[v->y() * SIZE + v->x()] = d;
+				open.push(Q_PAIR(d, v));
+			}
+		}
+	}
+
+	return Math::INF;
+}
+
+/**
+ * Drives a planner from one corner to the other under a budget.
+ *
+ * @param   unsigned int   budget (cells with state)
+ * @param   unsigned int   seed
+ * @return  unsigned int   number of failed replans
+ */
+unsigned int drive(unsigned int budget, unsigned int seed)
+{
+	srand(seed);
+
+	Map map(SIZE, SIZE);
+	vector<double> costs(SIZE * SIZE);
+
+	for (unsigned int k = 0; k < SIZE * SIZE; k++)
+	{
+		bool corner = k < 2 * SIZE || k >= (SIZE - 2) * SIZE;
+		costs[k] = ( ! corner && rand() % 8 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3;
+		map(k / SIZE, k % SIZE)->cost = costs[k];
+	}
+
+	Map::Cell* goal = map(SIZE - 1, SIZE - 1);
+	Planner planner(&map, map(0, 0), goal);
+
+	unsigned int failed = 0;
+	unsigned int compacted = 0;
+
+	for (unsigned int step = 0; step < 30 && planner.start() != goal; step++)
+	{
+		// Far cells are dropped, the search must revisit them if they matter
+		compacted += planner.compact(budget);
+
+		double reference = dijkstra(costs, planner.start(), goal);
+
+		if ( ! planner.replan())
+		{
+			if (reference != Math::INF)
+			{
+				printf("  budget %u seed %u step %u: no path, Dijkstra found %f\n", budget, seed, step, reference);
+				failed++;
+			}
+
+			break;
+		}
+
+		double c = cost(costs, planner.path());
+
+		if ( ! Math::equals(c, reference, 0.00001))
+		{
+			printf("  budget %u seed %u step %u: path costs %f, Dijkstra %f\n", budget, seed, step, c, reference);
+			failed++;
+			break;
+		}
+
+		Map::Cell* current = *(++planner.path().begin());
+		planner.start(current);
+
+		// Cells around the robot change, never its own cell or the goal
+		for (unsigned int i = 0; i < 20; i++)
+		{
+			int x = (int) current->x() + rand() % 21 - 10;
+			int y = (int) current->y() + rand() % 21 - 10;
+
+			if ( ! map.has(y, x) || map(y, x) == current || map(y, x) == goal)
+				continue;
+
+			double value = (rand() % 3 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3;
+
+			costs[y * SIZE + x] = value;
+			planner.update(map(y, x), value);
+		}
+	}
+
+	// Budgets below the search size must have made the planner drop something
+	if (compacted == 0)
+	{
+		printf("  budget %u seed %u: nothing compacted\n", budget, seed);
+		failed++;
+	}
+
+	return failed;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int budgets[] = { 6000, 10000, 15000, 20000 };
+	unsigned int failed = 0;
+
+	for (unsigned int b = 0; b < 4; b++)
+	{
+		for (unsigned int seed = 1; seed <= 2; seed++)
+		{
+			failed += drive(budgets[b], seed);
+		}
+	}
+
+	if (failed > 0)
+	{
+		printf("compact dijkstra: FAILED (%u)\n", failed);
+		return 1;
+	}
+
+	printf("compact dijkstra: passed\n");
+	return 0;
+}
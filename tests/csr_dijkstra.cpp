@@ -0,0 +1,216 @@
+/**
+ * CSR Dijkstra Test.
+ *
+ * Drives a CsrPlanner along its path on random graphs while edge costs
+ * change, and fails if a replan does not find a path or finds one that is
+ * not a chain of edges as cheap as Dijkstra's.  Vertices sit on a small
+ * grid so some share a position, giving zero cost edges, and some vertices
+ * have self-loops.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "csr_planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * Gets the cheapest edge between two vertices.
+ *
+ * @param   CsrGraph*          graph
+ * @param   CsrGraph::Vertex   from
+ * @param   CsrGraph::Vertex   to
+ * @return  double             cost (Math::INF if there is none)
+ */
+double cheapest(CsrGraph* graph, CsrGraph::Vertex u, CsrGraph::Vertex v)
+{
+	CsrGraph::Edges edges;
+	graph->succ(u, edges);
+
+	double best = Math::INF;
+
+	for (unsigned int i = 0; i < edges.size(); i++)
+	{
+		if (edges[i].first == v && edges[i].second < best)
+		{
+			best = edges[i].second;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Gets the cost of the cheapest path.
+ *
+ * @param   CsrGraph*          graph
+ * @param   CsrGraph::Vertex   start
+ * @param   CsrGraph::Vertex   goal
+ * @return  double             cost (Math::INF if there is no path)
+ */
+double dijkstra(CsrGraph* graph, CsrGraph::Vertex start, CsrGraph::Vertex goal)
+{
+	typedef pair<double, CsrGraph::Vertex> Q_PAIR;
+
+	vector<double> dist(graph->vertices(), Math::INF);
+	priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > open;
+	CsrGraph::Edges edges;
+
+	dist[start] = 0.0;
+	open.push(Q_PAIR(0.0, start));
+
+	while ( ! open.empty())
+	{
+		Q_PAIR top = open.top();
+		open.pop();
+
+		if (top.first > dist[top.second])
+			continue;
+
+		if (top.second == goal)
+			return top.first;
+
+		edges.clear();
+		graph->succ(top.second, edges);
+
+		for (unsigned int i = 0; i < edges.size(); i++)
+		{
+			double d = top.first + edges[i].second;
+
+			if (d < dist[edges[i].first])
+			{
+				dist[edges[i].first] = d;
+				open.push(Q_PAIR(d, edges[i].first));
+			}
+		}
+	}
+
+	return Math::INF;
+}
+
+/**
+ * Drives a planner from vertex 0 to the last vertex of a random graph.
+ *
+ * @param   unsigned int   seed
+ * @return  unsigned int   number of failed replans
+ */
+unsigned int drive(unsigned int seed)
+{
+	srand(seed);
+
+	unsigned int n = 30 + rand() % 30;
+
+	// A small grid, so some vertices share a position
+	vector<pair<double,double> > xy;
+
+	for (unsigned int u = 0; u < n; u++)
+	{
+		xy.push_back(pair<double,double>(rand() % 6, rand() % 6));
+	}
+
+	vector<CsrGraph::Edge> edges;
+
+	for (unsigned int u = 0; u < n; u++)
+	{
+		unsigned int degree = 2 + rand() % 2;
+
+		for (unsigned int i = 0; i < degree; i++)
+		{
+			// Some self-loops
+			CsrGraph::Vertex v = (rand() % 10 == 0) ? u : rand() % n;
+
+			double dx = xy[u].first - xy[v].first;
+			double dy = xy[u].second - xy[v].second;
+
+			edges.push_back(CsrGraph::Edge(u, v, sqrt(dx * dx + dy * dy) * (1 + rand() % 3)));
+		}
+	}
+
+	CsrGraph graph(n, edges);
+	graph.positions(xy, 1.0);
+
+	// Costs may grow or block, never drop below the heuristic
+	vector<double> base;
+
+	for (unsigned int e = 0; e < graph.edges(); e++)
+	{
+		base.push_back(graph.cost(e));
+	}
+
+	CsrPlanner planner(&graph, 0, n - 1);
+
+	unsigned int failed = 0;
+
+	for (unsigned int step = 0; step < 50 && planner.start() != n - 1; step++)
+	{
+		double reference = dijkstra(&graph, planner.start(), n - 1);
+
+		if ( ! planner.replan())
+		{
+			if (reference != Math::INF)
+			{
+				printf("  seed %u step %u: no path, Dijkstra found %f\n", seed, step, reference);
+				failed++;
+			}
+
+			break;
+		}
+
+		const list<CsrGraph::Vertex>& path = planner.path();
+
+		double cost = 0.0;
+		list<CsrGraph::Vertex>::const_iterator it = path.begin();
+
+		for (CsrGraph::Vertex u = *it++; it != path.end(); u = *it++)
+		{
+			cost += cheapest(&graph, u, *it);
+		}
+
+		if ( ! Math::equals(cost, reference, 0.00001))
+		{
+			printf("  seed %u step %u: path costs %f, Dijkstra %f\n", seed, step, cost, reference);
+			failed++;
+			break;
+		}
+
+		planner.start(*(++path.begin()));
+
+		// Some edges change, blocked ones included
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			unsigned int e = rand() % graph.edges();
+
+			planner.update(e, (rand() % 4 == 0) ? Math::INF : base[e] * (1 + rand() % 3));
+		}
+	}
+
+	return failed;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int failed = 0;
+
+	for (unsigned int seed = 1; seed <= 200; seed++)
+	{
+		failed += drive(seed);
+	}
+
+	if (failed > 0)
+	{
+		printf("csr dijkstra: FAILED (%u)\n", failed);
+		return 1;
+	}
+
+	printf("csr dijkstra: passed\n");
+	return 0;
+}
@@ -0,0 +1,323 @@
+/**
+ * Decay Walls Test.
+ *
+ * Drives a robot the way the simulator does (scan the disk, mark or clear
+ * what differs from the robot map, revert expired cells to the prior).  An
+ * obstacle on floor that is free in the prior map must be forgotten once
+ * out of view for the decay time.  A wall missing from the prior map may be
+ * forgotten, but found again it must be kept, or with a short decay the
+ * robot keeps going back to it and never reaches the goal.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <vector>
+
+#include "costmap.h"
+#include "layers/layer_decay.h"
+#include "layers/layer_sensor.h"
+#include "layers/layer_static.h"
+#include "planner.h"
+#include "scanner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const unsigned int  map edge length
+ */
+static const unsigned int SIZE = 40;
+
+/**
+ * @var  static const unsigned int  scanner radius
+ */
+static const unsigned int RADIUS = 4;
+
+/**
+ * A robot with a free prior map in a real map, like the simulator.
+ */
+class Robot
+{
+	public:
+
+		/**
+		 * @var  DecayLayer*  observed obstacles (owned by the costmap)
+		 */
+		DecayLayer* decay;
+
+		/**
+		 * @var  vector<Map::Cell*>  cells expired during the last step
+		 */
+		vector<Map::Cell*> expired;
+
+		/**
+		 * @var  Map  map
+		 */
+		Map map;
+
+		/**
+		 * @var  Planner*  planner
+		 */
+		Planner* planner;
+
+		/**
+		 * @var  unsigned int  scans done
+		 */
+		unsigned int tick;
+
+		/**
+		 * Constructor, the robot starts in the top left corner and heads for the top right one.
+		 *
+		 * @param  vector<double>&   real costs
+		 * @param  unsigned int      decay (scans)
+		 */
+		Robot(const vector<double>& real, unsigned int decay) : map(SIZE, SIZE), _scanner(RADIUS)
+		{
+			_decay = decay;
+			_real = real;
+			_known.assign(SIZE * SIZE, 1.0);
+
+			tick = 0;
+
+			_costmap = new Costmap(&map);
+			_costmap->add(new StaticLayer(&map));
+			_sensor = (SensorLayer*) _costmap->add(new SensorLayer(&map));
+			this->decay = (DecayLayer*) _costmap->add(new DecayLayer(&map));
+			_costmap->compose();
+
+			planner = new Planner(&map, map(0, 0), map(0, SIZE - 1));
+		}
+
+		/**
+		 * Deconstructor.
+		 */
+		~Robot()
+		{
+			delete planner;
+			delete _costmap;
+		}
+
+		/**
+		 * Scans, replans and moves one cell.
+		 *
+		 * @return  bool   moved (false at the goal or without a path)
+		 */
+		bool step()
+		{
+			Map::Cell* current = planner->start();
+
+			if (current == planner->goal())
+				return false;
+
+			tick++;
+
+			// Expired obstacles are forgotten, those still in view are found again right away
+			expired.clear();
+			decay->expire(tick, expired);
+
+			for (unsigned int i = 0; i < expired.size(); i++)
+			{
+				_known[expired[i]->y() * SIZE + expired[i]->x()] = 1.0;
+			}
+
+			vector<Scanner::Offset>& disk = _scanner.disk();
+
+			for (unsigned int i = 0; i < disk.size(); i++)
+			{
+				int x = (int) current->x() + disk[i].first;
+				int y = (int) current->y() + disk[i].second;
+
+				if (x < 0 || x >= (int) SIZE || y < 0 || y >= (int) SIZE)
+					continue;
+
+				unsigned int k = y * SIZE + x;
+
+				// Only differences are passed on, like the simulator
+				if (_known[k] == _real[k])
+					continue;
+
+				_known[k] = _real[k];
+
+				if (_real[k] == Map::Cell::COST_UNWALKABLE)
+				{
+					decay->mark(map(y, x), _real[k], tick + _decay);
+				}
+				else
+				{
+					decay->clear(map(y, x));
+					_sensor->set(map(y, x), _real[k]);
+				}
+			}
+
+			_costmap->update(_cells, _costs);
+
+			if ( ! _cells.empty())
+			{
+				planner->update(_cells, _costs);
+				_cells.clear();
+				_costs.clear();
+			}
+
+			if ( ! planner->replan())
+				return false;
+
+			planner->start(*(++planner->path().begin()));
+
+			return true;
+		}
+
+		/**
+		 * Checks if a cell is within scanner range.
+		 *
+		 * @param   Map::Cell*   cell
+		 * @return  bool
+		 */
+		bool sees(Map::Cell* u)
+		{
+			return _scanner.has((int) u->x() - (int) planner->start()->x(), (int) u->y() - (int) planner->start()->y());
+		}
+
+	protected:
+
+		/**
+		 * @var  vector<Map::Cell*>  cells whose composite cost changed
+		 */
+		vector<Map::Cell*> _cells;
+
+		/**
+		 * @var  Costmap*  prior, sensor and decay layers
+		 */
+		Costmap* _costmap;
+
+		/**
+		 * @var  vector<double>  new composite costs of the changed cells
+		 */
+		vector<double> _costs;
+
+		/**
+		 * @var  unsigned int  decay (scans)
+		 */
+		unsigned int _decay;
+
+		/**
+		 * @var  vector<double>  costs known by the robot
+		 */
+		vector<double> _known;
+
+		/**
+		 * @var  vector<double>  real costs
+		 */
+		vector<double> _real;
+
+		/**
+		 * @var  Scanner  scanner
+		 */
+		Scanner _scanner;
+
+		/**
+		 * @var  SensorLayer*  observed costs (owned by the costmap)
+		 */
+		SensorLayer* _sensor;
+};
+
+/**
+ * Drives around a wall the prior map does not know (down the middle, the only gap at the bottom).
+ *
+ * @param   unsigned int   decay (scans)
+ * @param   unsigned int   maximum number of ticks
+ * @return  bool           goal reached
+ */
+bool walls(unsigned int decay, unsigned int ticks)
+{
+	vector<double> real(SIZE * SIZE, 1.0);
+
+	for (unsigned int i = 0; i + 1 < SIZE; i++)
+	{
+		real[i * SIZE + SIZE / 2] = Map::Cell::COST_UNWALKABLE;
+	}
+
+	Robot robot(real, decay);
+
+	while (robot.tick < ticks && robot.step());
+
+	return robot.planner->start() == robot.planner->goal();
+}
+
+/**
+ * Drives past an obstacle next to the start, on floor that is free in the prior map.
+ *
+ * It must expire within the decay time of the last scan that saw it, once out of view.
+ *
+ * @param   unsigned int   decay (scans)
+ * @return  bool           passed
+ */
+bool transient(unsigned int decay)
+{
+	vector<double> real(SIZE * SIZE, 1.0);
+	real[2 * SIZE + 2] = Map::Cell::COST_UNWALKABLE;
+
+	Robot robot(real, decay);
+	Map::Cell* obstacle = robot.map(2, 2);
+
+	unsigned int seen = 0, forgotten = 0;
+
+	for (bool view = robot.sees(obstacle); robot.step(); view = robot.sees(obstacle))
+	{
+		if (view)
+		{
+			seen = robot.tick;
+			continue;
+		}
+
+		for (unsigned int i = 0; i < robot.expired.size(); i++)
+		{
+			if (robot.expired[i] == obstacle)
+			{
+				forgotten = robot.tick;
+			}
+		}
+	}
+
+	if (robot.planner->start() != robot.planner->goal() || forgotten == 0)
+		return false;
+
+	// Expired out of view within the decay time, and reverted to the prior
+	return forgotten > seen && forgotten <= seen + decay
+		&& robot.decay->size() == 0 && robot.map(2, 2)->cost == 1.0;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int failed = 0;
+	unsigned int decays[] = { 1, 5, 100 };
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		if ( ! walls(decays[i], 2000))
+		{
+			printf("  decay %u: goal not reached around the wall\n", decays[i]);
+			failed++;
+		}
+	}
+
+	for (unsigned int i = 0; i < 2; i++)
+	{
+		if ( ! transient(decays[i]))
+		{
+			printf("  decay %u: obstacle on free floor not forgotten out of view\n", decays[i]);
+			failed++;
+		}
+	}
+
+	if (failed > 0)
+	{
+		printf("decay walls: FAILED (%u)\n", failed);
+		return 1;
+	}
+
+	printf("decay walls: passed\n");
+	return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * Fleet Collisions Test.
+ *
+ * Steps cooperative fleets and fails if two robots ever share a cell or
+ * pass through each other.  Covers a corridor where two robots must swap
+ * (they may wait forever, but must not meet) and random obstacle fields.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+
+#include "fleet.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * Steps a fleet and counts the collisions.
+ *
+ * @param   Fleet*         fleet
+ * @param   unsigned int   maximum number of ticks
+ * @return  unsigned int   number of collisions
+ */
+unsigned int collisions(Fleet* fleet, unsigned int ticks)
+{
+	vector<Fleet::Robot*>& robots = fleet->robots();
+	vector<Map::Cell*> previous;
+
+	for (unsigned int i = 0; i < robots.size(); i++)
+	{
+		previous.push_back(robots[i]->current);
+	}
+
+	unsigned int count = 0;
+
+	for (unsigned int t = 0; t < ticks && fleet->step() > 0; t++)
+	{
+		for (unsigned int i = 0; i < robots.size(); i++)
+		{
+			for (unsigned int j = i + 1; j < robots.size(); j++)
+			{
+				// Same cell, or swapped cells
+				if (robots[i]->current == robots[j]->current
+					|| (robots[i]->current == previous[j] && robots[j]->current == previous[i]))
+				{
+					printf("  robots %u and %u meet at tick %u\n", i, j, t);
+					count++;
+				}
+			}
+		}
+
+		for (unsigned int i = 0; i < robots.size(); i++)
+		{
+			previous[i] = robots[i]->current;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Two robots that must swap in a one cell wide corridor.
+ *
+ * @return  unsigned int   number of collisions
+ */
+unsigned int corridor()
+{
+	Map prior(3, 5), real(3, 5);
+
+	for (unsigned int i = 0; i < 3; i++)
+	{
+		for (unsigned int j = 0; j < 5; j++)
+		{
+			double cost = (i == 1 && j >= 1 && j <= 3) ? 1 : Map::Cell::COST_UNWALKABLE;
+			prior(i, j)->cost = cost;
+			real(i, j)->cost = cost;
+		}
+	}
+
+	Fleet fleet(&prior, &real, 2);
+	fleet.add(prior(1, 1), prior(1, 3));
+	fleet.add(prior(1, 2), prior(1, 1));
+	fleet.cooperate(4);
+
+	return collisions(&fleet, 20);
+}
+
+/**
+ * Twenty robots on a random obstacle field.
+ *
+ * @param   unsigned int   seed
+ * @param   unsigned int   window
+ * @return  unsigned int   number of collisions
+ */
+unsigned int field(unsigned int seed, unsigned int window)
+{
+	const unsigned int SIZE = 30;
+
+	srand(seed);
+
+	Map prior(SIZE, SIZE), real(SIZE, SIZE);
+
+	for (unsigned int i = 0; i < SIZE; i++)
+	{
+		for (unsigned int j = 0; j < SIZE; j++)
+		{
+			prior(i, j)->cost = 1;
+			real(i, j)->cost = (rand() % 6 == 0) ? Map::Cell::COST_UNWALKABLE : 1;
+		}
+	}
+
+	Fleet fleet(&prior, &real, 5);
+	fleet.cooperate(window);
+
+	set<Map::Cell*> used;
+
+	for (unsigned int r = 0; r < 20; r++)
+	{
+		Map::Cell* cells[2];
+
+		for (unsigned int k = 0; k < 2; k++)
+		{
+			do
+			{
+				cells[k] = prior(rand() % SIZE, rand() % SIZE);
+			}
+			while (used.count(cells[k]) || real(cells[k]->y(), cells[k]->x())->cost == Map::Cell::COST_UNWALKABLE);
+
+			used.insert(cells[k]);
+		}
+
+		fleet.add(cells[0], cells[1]);
+	}
+
+	return collisions(&fleet, 2000);
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int count = corridor();
+
+	for (unsigned int seed = 1; seed <= 10; seed++)
+	{
+		count += field(seed, 4);
+		count += field(seed, 8);
+	}
+
+	if (count > 0)
+	{
+		printf("fleet collisions: FAILED (%u)\n", count);
+		return 1;
+	}
+
+	printf("fleet collisions: passed\n");
+	return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Replay Allocations Test.
+ *
+ * Records an episode of obstacles appearing and vanishing on a patrolled
+ * map, warms a planner up on it, then replays it and fails if a single
+ * update() or replan() allocates.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "allocations.h"
+#include "planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * Cost change of the episode.
+ */
+struct Event
+{
+	Map::Cell* cell;
+	double cost;
+};
+
+/**
+ * Plays an episode: every change with a replan, then every change undone.
+ *
+ * @param   Planner*         planner
+ * @param   vector<Event>&   changes
+ * @param   vector<Event>&   undo
+ * @return  void
+ */
+void play(Planner* planner, vector<Event>& changes, vector<Event>& undo)
+{
+	for (unsigned int i = 0; i < changes.size(); i++)
+	{
+		planner->update(changes[i].cell, changes[i].cost);
+		planner->replan();
+	}
+
+	for (unsigned int i = 0; i < undo.size(); i++)
+	{
+		planner->update(undo[i].cell, undo[i].cost);
+		planner->replan();
+	}
+}
+
+/**
+ * Warms a planner up on a recorded episode and replays it.
+ *
+ * @param   unsigned int    seed
+ * @return  unsigned long   allocations during the replay
+ */
+unsigned long replay(unsigned int seed)
+{
+	const unsigned int SIZE = 120;
+
+	srand(seed);
+
+	Map map(SIZE, SIZE);
+
+	for (unsigned int i = 0; i < SIZE; i++)
+	{
+		for (unsigned int j = 0; j < SIZE; j++)
+		{
+			map(i, j)->cost = (rand() % 7 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3;
+		}
+	}
+
+	map(0, 0)->cost = 1;
+	map(SIZE - 1, SIZE - 1)->cost = 1;
+
+	Planner planner(&map, map(0, 0), map(SIZE - 1, SIZE - 1));
+
+	// Record the episode, and how to undo it
+	vector<Event> changes, undo;
+
+	for (unsigned int i = 0; i < 200; i++)
+	{
+		Event e;
+		e.cell = map(20 + rand() % 80, 20 + rand() % 80);
+		e.cost = (rand() % 2) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3;
+
+		changes.push_back(e);
+	}
+
+	for (unsigned int i = 0; i < changes.size(); i++)
+	{
+		Event e;
+		e.cell = changes[i].cell;
+		e.cost = planner.cost(e.cell);
+
+		undo.push_back(e);
+	}
+
+	// Warm up to the high-water mark
+	planner.replan();
+	play(&planner, changes, undo);
+	play(&planner, changes, undo);
+
+	Allocations::start();
+	play(&planner, changes, undo);
+	play(&planner, changes, undo);
+
+	return Allocations::stop();
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned long total = 0;
+
+	for (unsigned int seed = 1; seed <= 5; seed++)
+	{
+		unsigned long count = replay(seed);
+
+		if (count > 0)
+		{
+			printf("  seed %u: %lu allocations during the replay\n", seed, count);
+		}
+
+		total += count;
+	}
+
+	if (total > 0)
+	{
+		printf("replay allocations: FAILED (%lu)\n", total);
+		return 1;
+	}
+
+	printf("replay allocations: passed\n");
+	return 0;
+}
@@ -0,0 +1,29 @@
+#!/bin/sh
+# Builds and runs the test drivers (they don't need FLTK).
+# Stops at the first failure.  Set CXX to use another compiler.
+
+cd "$(dirname "$0")/../src" || exit 1
+
+CXX=${CXX:-g++}
+FLAGS="-std=gnu++98 -O2 -pthread -I."
+OUT=${TMPDIR:-/tmp}
+
+run()
+{
+	name=$1
+	shift
+
+	$CXX $FLAGS ../tests/$name.cpp "$@" -o $OUT/$name || exit 1
+	$OUT/$name || exit 1
+}
+
+PLANNER="planner.cpp key.cpp pool.cpp components.cpp cost_overlay.cpp map.cpp math.cpp"
+
+run fleet_collisions fleet.cpp thread_pool.cpp scanner.cpp space_time_planner.cpp true_distance.cpp reservation_table.cpp $PLANNER
+run replay_allocations $PLANNER
+run bounded_allocations bounded_planner.cpp $PLANNER
+run compact_dijkstra $PLANNER
+run csr_dijkstra csr_graph.cpp csr_planner.cpp key.cpp math.cpp
+run sparse_dijkstra sparse_map.cpp sparse_graph.cpp sparse_planner.cpp key.cpp map.cpp math.cpp
+run decay_walls costmap.cpp layers/layer_base.cpp layers/layer_decay.cpp layers/layer_sensor.cpp layers/layer_static.cpp scanner.cpp $PLANNER
+run nav_mesh_grid nav_mesh.cpp nav_mesh_planner.cpp $PLANNER
@@ -0,0 +1,241 @@
+/**
+ * Sparse Dijkstra Test.
+ *
+ * Drives a SparsePlanner along its path inside a walled box that straddles
+ * the origin, while cells around the robot change, and fails if a replan
+ * does not find a path or finds one that is not a chain of moves as cheap
+ * as Dijkstra's over the same graph.
+ *
+ * @package		DStarLite
+ * @author		Aaron Zampaglione <azampagl@gmail.com>
+ * @copyright	Copyright (C) 2011 Aaron Zampaglione
+ * @license		MIT
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "sparse_graph.h"
+#include "sparse_planner.h"
+
+using namespace std;
+using namespace DStarLite;
+
+/**
+ * @var  static const int  lowest coordinate inside the box
+ */
+static const int LOW = -20;
+
+/**
+ * @var  static const int  highest coordinate inside the box
+ */
+static const int HIGH = 19;
+
+/**
+ * Gets the index of a cell inside the box.
+ *
+ * @param   SparseMap::Coord   cell
+ * @return  unsigned int
+ */
+unsigned int index(const SparseMap::Coord& c)
+{
+	return (c.y - LOW) * (HIGH - LOW + 1) + (c.x - LOW);
+}
+
+/**
+ * Gets the cheapest move between two cells.
+ *
+ * @param   SparseGraph*       graph
+ * @param   SparseMap::Coord   from
+ * @param   SparseMap::Coord   to
+ * @return  double             cost (Math::INF if there is none)
+ */
+double cheapest(SparseGraph* graph, const SparseMap::Coord& u, const SparseMap::Coord& v)
+{
+	SparseGraph::Edges edges;
+	graph->succ(u, edges);
+
+	double best = Math::INF;
+
+	for (unsigned int i = 0; i < edges.size(); i++)
+	{
+		if (edges[i].first == v && edges[i].second < best)
+		{
+			best = edges[i].second;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Gets the cost of the cheapest path (the box walls keep it finite).
+ *
+ * @param   SparseGraph*       graph
+ * @param   SparseMap::Coord   start
+ * @param   SparseMap::Coord   goal
+ * @return  double             cost (Math::INF if there is no path)
+ */
+double dijkstra(SparseGraph* graph, const SparseMap::Coord& start, const SparseMap::Coord& goal)
+{
+	typedef pair<double, unsigned int> Q_PAIR;
+
+	unsigned int side = HIGH - LOW + 1;
+
+	vector<double> dist(side * side, Math::INF);
+	priority_queue<Q_PAIR, vector<Q_PAIR>, greater<Q_PAIR> > open;
+	SparseGraph::Edges edges;
+
+	dist[index(start)] = 0.0;
+	open.push(Q_PAIR(0.0, index(start)));
+
+	while ( ! open.empty())
+	{
+		Q_PAIR top = open.top();
+		open.pop();
+
+		if (top.first > dist[top.second])
+			continue;
+
+		SparseMap::Coord u = SparseMap::coord(LOW + (int) (top.second % side), LOW + (int) (top.second / side));
+
+		if (u == goal)
+			return top.first;
+
+		edges.clear();
+		graph->succ(u, edges);
+
+		for (unsigned int i = 0; i < edges.size(); i++)
+		{
+			SparseMap::Coord v = edges[i].first;
+
+			if (edges[i].second == Math::INF || v.x < LOW || v.x > HIGH || v.y < LOW || v.y > HIGH)
+				continue;
+
+			unsigned int k = index(v);
+			double d = top.first + edges[i].second;
+
+			if (d < dist[k])
+			{
+				dist[k] = d;
+				open.push(Q_PAIR(d, k));
+			}
+		}
+	}
+
+	return Math::INF;
+}
+
+/**
+ * Drives a planner across the box.
+ *
+ * @param   unsigned int   seed
+ * @return  unsigned int   number of failed replans
+ */
+unsigned int drive(unsigned int seed)
+{
+	srand(seed);
+
+	SparseMap::Coord start = SparseMap::coord(LOW, LOW);
+	SparseMap::Coord goal = SparseMap::coord(HIGH, HIGH);
+
+	SparsePlanner planner(start, goal);
+	SparseGraph graph(planner.map());
+
+	// Walls around the box, random costs and obstacles inside
+	for (int i = LOW - 1; i <= HIGH + 1; i++)
+	{
+		planner.update(SparseMap::coord(i, LOW - 1), Map::Cell::COST_UNWALKABLE);
+		planner.update(SparseMap::coord(i, HIGH + 1), Map::Cell::COST_UNWALKABLE);
+		planner.update(SparseMap::coord(LOW - 1, i), Map::Cell::COST_UNWALKABLE);
+		planner.update(SparseMap::coord(HIGH + 1, i), Map::Cell::COST_UNWALKABLE);
+	}
+
+	for (int y = LOW; y <= HIGH; y++)
+	{
+		for (int x = LOW; x <= HIGH; x++)
+		{
+			SparseMap::Coord c = SparseMap::coord(x, y);
+
+			if (c == start || c == goal)
+				continue;
+
+			planner.update(c, (rand() % 6 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3);
+		}
+	}
+
+	unsigned int failed = 0;
+
+	for (unsigned int step = 0; step < 200 && ! (planner.start() == goal); step++)
+	{
+		double reference = dijkstra(&graph, planner.start(), goal);
+
+		if ( ! planner.replan())
+		{
+			if (reference != Math::INF)
+			{
+				printf("  seed %u step %u: no path, Dijkstra found %f\n", seed, step, reference);
+				failed++;
+			}
+
+			break;
+		}
+
+		list<SparseMap::Coord> path = planner.path();
+
+		double cost = 0.0;
+		list<SparseMap::Coord>::iterator it = path.begin();
+
+		for (SparseMap::Coord u = *it++; it != path.end(); u = *it++)
+		{
+			cost += cheapest(&graph, u, *it);
+		}
+
+		if ( ! Math::equals(cost, reference, 0.00001))
+		{
+			printf("  seed %u step %u: path costs %f, Dijkstra %f\n", seed, step, cost, reference);
+			failed++;
+			break;
+		}
+
+		SparseMap::Coord current = *(++path.begin());
+		planner.start(current);
+
+		// Cells around the robot change, never its own cell or the goal
+		for (unsigned int i = 0; i < 4; i++)
+		{
+			int x = current.x - 4 + rand() % 9;
+			int y = current.y - 4 + rand() % 9;
+
+			SparseMap::Coord c = SparseMap::coord(x, y);
+
+			if (x < LOW || x > HIGH || y < LOW || y > HIGH || c == current || c == goal)
+				continue;
+
+			planner.update(c, (rand() % 3 == 0) ? Map::Cell::COST_UNWALKABLE : 1 + rand() % 3);
+		}
+	}
+
+	return failed;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int failed = 0;
+
+	for (unsigned int seed = 1; seed <= 20; seed++)
+	{
+		failed += drive(seed);
+	}
+
+	if (failed > 0)
+	{
+		printf("sparse dijkstra: FAILED (%u)\n", failed);
+		return 1;
+	}
+
+	printf("sparse dijkstra: passed\n");
+	return 0;
+}